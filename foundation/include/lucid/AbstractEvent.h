@@ -24,6 +24,9 @@
 #include "lucid/ActiveResult.h"
 #include "lucid/ActiveMethod.h"
 #include "lucid/Mutex.h"
+#include "lucid/CopyOnWritePtr.h"
+#include <atomic>
+#include <memory>
 
 
 namespace Lucid {
@@ -147,6 +150,12 @@ class AbstractEvent
 	/// Working with PriorityDelegate's as similar to working with BasicEvent.
 	/// Instead of delegate(), the priorityDelegate() function must be used
 	/// to create the PriorityDelegate.
+	///
+	/// The strategy holding the delegates is kept as an immutable snapshot
+	/// (see CopyOnWritePtr). Adding or removing a delegate copies the
+	/// strategy under the event's mutex and publishes the copy, whereas
+	/// notify() neither locks the event's mutex nor allocates memory.
+	/// Strategies must therefore not modify themselves in notify().
 {
 public:
 	typedef TDelegate* DelegateHandle;
@@ -175,7 +184,9 @@ public:
 		/// Exact behavior is determined by the TStrategy.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.add(aDelegate);
+		std::unique_ptr<TStrategy> pStrategy(new TStrategy(*_strategy.get()));
+		pStrategy->add(aDelegate);
+		_strategy.assign(pStrategy.release());
 	}
 
 	void operator -= (const TDelegate& aDelegate)
@@ -184,7 +195,9 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(aDelegate);
+		std::unique_ptr<TStrategy> pStrategy(new TStrategy(*_strategy.get()));
+		pStrategy->remove(aDelegate);
+		_strategy.assign(pStrategy.release());
 	}
 
 	DelegateHandle add(const TDelegate& aDelegate)
@@ -196,7 +209,10 @@ public:
 		/// remove() to remove the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.add(aDelegate);
+		std::unique_ptr<TStrategy> pStrategy(new TStrategy(*_strategy.get()));
+		DelegateHandle delegateHandle = pStrategy->add(aDelegate);
+		_strategy.assign(pStrategy.release());
+		return delegateHandle;
 	}
 
 	void remove(DelegateHandle delegateHandle)
@@ -206,7 +222,9 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(delegateHandle);
+		std::unique_ptr<TStrategy> pStrategy(new TStrategy(*_strategy.get()));
+		pStrategy->remove(delegateHandle);
+		_strategy.assign(pStrategy.release());
 	}
 
 	void operator () (const void* pSender, TArgs& args)
@@ -232,16 +250,13 @@ public:
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
 	{
-		Lucid::ScopedLockWithUnlock<TMutex> lock(_mutex);
-
 		if (!_enabled) return;
 
 		// thread-safeness:
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender, args);
+		// notify on the current snapshot of the strategy, which
+		// is never modified; add() and remove() publish a new one.
+		typename CopyOnWritePtr<TStrategy>::ReadGuard strategy(_strategy);
+		const_cast<TStrategy&>(*strategy).notify(pSender, args);
 	}
 
 	bool hasDelegates() const
@@ -264,15 +279,12 @@ public:
 	{
 		NotifyAsyncParams params(pSender, args);
 		{
-			typename TMutex::ScopedLock lock(_mutex);
-
 			// thread-safeness:
-			// copy should be faster and safer than blocking until
-			// execution ends
 			// make a copy of the strategy here to guarantee that
 			// between notifyAsync and the execution of the method no changes can occur
+			typename CopyOnWritePtr<TStrategy>::ReadGuard strategy(_strategy);
 
-			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(_strategy));
+			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(*strategy));
 			params.enabled  = _enabled;
 		}
 		ActiveResult<TArgs> result = _executeAsync(params);
@@ -282,7 +294,6 @@ public:
 	void enable()
 		/// Enables the event.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = true;
 	}
 
@@ -290,14 +301,12 @@ public:
 		/// Disables the event. notify and notifyAsnyc will be ignored,
 		/// but adding/removing delegates is still allowed.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = false;
 	}
 
 	bool isEnabled() const
 		/// Returns true if event is enabled.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		return _enabled;
 	}
 
@@ -305,14 +314,16 @@ public:
 		/// Removes all delegates.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.clear();
+		std::unique_ptr<TStrategy> pStrategy(new TStrategy(*_strategy.get()));
+		pStrategy->clear();
+		_strategy.assign(pStrategy.release());
 	}
 
 	bool empty() const
 		/// Checks if any delegates are registered at the delegate.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.empty();
+		typename CopyOnWritePtr<TStrategy>::ReadGuard strategy(_strategy);
+		return strategy->empty();
 	}
 
 protected:
@@ -344,10 +355,10 @@ protected:
 		return retArgs;
 	}
 
-	TStrategy _strategy; /// The strategy used to notify observers.
-	bool      _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
-	                     /// but it is possible to change the observers.
-	mutable TMutex _mutex;
+	CopyOnWritePtr<TStrategy> _strategy; /// The strategy used to notify observers.
+	std::atomic<bool> _enabled;          /// Stores if an event is enabled. Notifies on disabled events have no effect
+	                                     /// but it is possible to change the observers.
+	mutable TMutex    _mutex;            /// Serializes modifications of the strategy.
 
 private:
 	AbstractEvent(const AbstractEvent& other);
@@ -384,7 +395,9 @@ public:
 		/// Exact behavior is determined by the TStrategy.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.add(aDelegate);
+		std::unique_ptr<TStrategy> pStrategy(new TStrategy(*_strategy.get()));
+		pStrategy->add(aDelegate);
+		_strategy.assign(pStrategy.release());
 	}
 
 	void operator -= (const TDelegate& aDelegate)
@@ -393,7 +406,9 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(aDelegate);
+		std::unique_ptr<TStrategy> pStrategy(new TStrategy(*_strategy.get()));
+		pStrategy->remove(aDelegate);
+		_strategy.assign(pStrategy.release());
 	}
 
 	DelegateHandle add(const TDelegate& aDelegate)
@@ -405,7 +420,10 @@ public:
 		/// remove() to remove the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.add(aDelegate);
+		std::unique_ptr<TStrategy> pStrategy(new TStrategy(*_strategy.get()));
+		DelegateHandle delegateHandle = pStrategy->add(aDelegate);
+		_strategy.assign(pStrategy.release());
+		return delegateHandle;
 	}
 
 	void remove(DelegateHandle delegateHandle)
@@ -415,7 +433,9 @@ public:
 		/// If the delegate is not found, this function does nothing.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.remove(delegateHandle);
+		std::unique_ptr<TStrategy> pStrategy(new TStrategy(*_strategy.get()));
+		pStrategy->remove(delegateHandle);
+		_strategy.assign(pStrategy.release());
 	}
 
 	void operator () (const void* pSender)
@@ -441,16 +461,13 @@ public:
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
 	{
-		Lucid::ScopedLockWithUnlock<TMutex> lock(_mutex);
-
 		if (!_enabled) return;
 
 		// thread-safeness:
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender);
+		// notify on the current snapshot of the strategy, which
+		// is never modified; add() and remove() publish a new one.
+		typename CopyOnWritePtr<TStrategy>::ReadGuard strategy(_strategy);
+		const_cast<TStrategy&>(*strategy).notify(pSender);
 	}
 
 	ActiveResult<void> notifyAsync(const void* pSender)
@@ -467,15 +484,12 @@ public:
 	{
 		NotifyAsyncParams params(pSender);
 		{
-			typename TMutex::ScopedLock lock(_mutex);
-
 			// thread-safeness:
-			// copy should be faster and safer than blocking until
-			// execution ends
 			// make a copy of the strategy here to guarantee that
 			// between notifyAsync and the execution of the method no changes can occur
+			typename CopyOnWritePtr<TStrategy>::ReadGuard strategy(_strategy);
 
-			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(_strategy));
+			params.ptrStrat = SharedPtr<TStrategy>(new TStrategy(*strategy));
 			params.enabled  = _enabled;
 		}
 		ActiveResult<void> result = _executeAsync(params);
@@ -485,7 +499,6 @@ public:
 	void enable()
 		/// Enables the event.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = true;
 	}
 
@@ -493,13 +506,11 @@ public:
 		/// Disables the event. notify and notifyAsnyc will be ignored,
 		/// but adding/removing delegates is still allowed.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = false;
 	}
 
 	bool isEnabled() const
 	{
-		typename TMutex::ScopedLock lock(_mutex);
 		return _enabled;
 	}
 
@@ -507,14 +518,16 @@ public:
 		/// Removes all delegates.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		_strategy.clear();
+		std::unique_ptr<TStrategy> pStrategy(new TStrategy(*_strategy.get()));
+		pStrategy->clear();
+		_strategy.assign(pStrategy.release());
 	}
 
 	bool empty() const
 		/// Checks if any delegates are registered at the delegate.
 	{
-		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.empty();
+		typename CopyOnWritePtr<TStrategy>::ReadGuard strategy(_strategy);
+		return strategy->empty();
 	}
 
 protected:
@@ -544,10 +557,10 @@ protected:
 		return;
 	}
 
-	TStrategy _strategy; /// The strategy used to notify observers.
-	bool      _enabled;  /// Stores if an event is enabled. Notifies on disabled events have no effect
-	                     /// but it is possible to change the observers.
-	mutable TMutex _mutex;
+	CopyOnWritePtr<TStrategy> _strategy; /// The strategy used to notify observers.
+	std::atomic<bool> _enabled;          /// Stores if an event is enabled. Notifies on disabled events have no effect
+	                                     /// but it is possible to change the observers.
+	mutable TMutex    _mutex;            /// Serializes modifications of the strategy.
 
 private:
 	AbstractEvent(const AbstractEvent& other);
@@ -47,11 +47,32 @@ public:
 		/// and creates and returns a new log file.
 		/// The given LogFile object is deleted.
 
+	virtual void archiveFile(const std::string& path, const std::string& rotatedPath);
+		/// Archives a log file that has already been closed and
+		/// renamed from path to rotatedPath, as done by FileChannel
+		/// when archiving in the background. The archived file is
+		/// named as if it had been archived by archive(), and is
+		/// compressed on the calling thread.
+		///
+		/// The default implementation throws a NotImplementedException.
+
+	virtual bool canArchiveFile() const;
+		/// Returns true if the strategy implements archiveFile().
+		/// FileChannel falls back to archiving synchronously with
+		/// archive() for strategies that don't.
+		///
+		/// The default implementation returns false.
+
 	void compress(bool flag = true);
 		/// Enables or disables compression of archived files.	
 
 protected:
-	void moveFile(const std::string& oldName, const std::string& newName);
+	void moveFile(const std::string& oldName, const std::string& newName, bool compressNow = false);
+		/// Renames oldName to newName, and compresses the renamed
+		/// file if compression is enabled. The file is compressed by
+		/// a background thread, or on the calling thread if compressNow
+		/// is true.
+
 	bool exists(const std::string& name);
 	
 private:
@@ -72,6 +93,11 @@ public:
 	ArchiveByNumberStrategy();
 	~ArchiveByNumberStrategy();
 	LogFile* archive(LogFile* pFile);
+	void archiveFile(const std::string& path, const std::string& rotatedPath);
+	bool canArchiveFile() const;
+
+private:
+	void archiveByNumber(const std::string& basePath, const std::string& rotatedPath, bool compressNow);
 };
 
 
@@ -100,14 +126,32 @@ public:
 		archPath.append(".");
 		DateTimeFormatter::append(archPath, DT().timestamp(), "%Y%m%d%H%M%S%i");
 		
-		if (exists(archPath)) archiveByNumber(archPath);
+		if (exists(archPath)) archiveByNumber(archPath, false);
 		else moveFile(path, archPath);
 
 		return new LogFile(path);
 	}
 
+	void archiveFile(const std::string& path, const std::string& rotatedPath)
+		/// Archives the file by appending the current timestamp to the
+		/// file name. If the new file name exists, the existing file is
+		/// archived by number first.
+	{
+		std::string archPath = path;
+		archPath.append(".");
+		DateTimeFormatter::append(archPath, DT().timestamp(), "%Y%m%d%H%M%S%i");
+
+		if (exists(archPath)) archiveByNumber(archPath, true);
+		moveFile(rotatedPath, archPath, true);
+	}
+
+	bool canArchiveFile() const
+	{
+		return true;
+	}
+
 private:
-	void archiveByNumber(const std::string& basePath)
+	void archiveByNumber(const std::string& basePath, bool compressNow)
 		/// A monotonic increasing number is appended to the
 		/// log file name. The most recent archived file
 		/// always has the number zero.
@@ -133,7 +177,7 @@ private:
 			std::string newPath = basePath;
 			newPath.append(".");
 			NumberFormatter::append(newPath, n);
-			moveFile(oldPath, newPath);
+			moveFile(oldPath, newPath, compressNow);
 			--n;
 		}
 	}
@@ -0,0 +1,119 @@
+//
+// Base32.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base32
+//
+// Definition of class Base32.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Base32_INCLUDED
+#define Foundation_Base32_INCLUDED
+
+
+#include "lucid/Foundation.h"
+#include <string>
+#include <cstddef>
+
+
+namespace Lucid {
+
+
+enum Base32EncodingOptions
+{
+	BASE32_NO_PADDING = 0x01,
+		/// Do not append padding characters ('=') at end.
+
+	BASE32_LENIENT    = 0x02
+		/// Only used by Base32::decode(). Skip whitespace, accept
+		/// input with or without padding, and ignore the unused
+		/// bits of the last character.
+};
+
+
+class Foundation_API Base32
+	/// This class provides buffer-to-buffer Base32 encoding
+	/// and decoding, as specified in RFC 4648.
+	///
+	/// Unlike Base32Encoder and Base32Decoder, which are streams,
+	/// the functions of this class process a whole buffer at once,
+	/// five bytes at a time.
+	///
+	/// By default, decode() is strict: it rejects whitespace, wrong
+	/// or missing padding (unless BASE32_NO_PADDING is specified, in
+	/// which case padding is rejected) and non-zero unused bits.
+	/// Specify BASE32_LENIENT to accept such input.
+{
+public:
+	static std::size_t encodedLength(std::size_t size, int options = 0);
+		/// Returns the number of characters required to encode
+		/// size bytes with the given options.
+
+	static std::size_t encode(const void* data, std::size_t size, char* buffer, int options = 0);
+		/// Encodes size bytes starting at data and writes the
+		/// result to buffer, which must have room for at least
+		/// encodedLength(size, options) characters.
+		///
+		/// Returns the number of characters written.
+
+	static std::string encode(const void* data, std::size_t size, int options = 0);
+		/// Encodes size bytes starting at data and returns the result.
+
+	static std::string encode(const std::string& data, int options = 0);
+		/// Encodes the given data and returns the result.
+
+	static std::size_t decodedLength(std::size_t size);
+		/// Returns the maximum number of bytes that size
+		/// characters of Base32 data decode to.
+
+	static std::size_t decode(const char* data, std::size_t size, void* buffer, int options = 0);
+		/// Decodes size characters starting at data and writes
+		/// the result to buffer, which must have room for at least
+		/// decodedLength(size) bytes.
+		///
+		/// Returns the number of bytes written. Throws a
+		/// DataFormatException if the data is not valid Base32.
+
+	static std::string decode(const std::string& data, int options = 0);
+		/// Decodes the given data and returns the result.
+		/// Throws a DataFormatException if the data is not
+		/// valid Base32.
+};
+
+
+//
+// inlines
+//
+inline std::size_t Base32::encodedLength(std::size_t size, int options)
+{
+	static const std::size_t TAIL[5] = {0, 2, 4, 5, 7};
+
+	if (options & BASE32_NO_PADDING)
+		return (size/5)*8 + TAIL[size % 5];
+	else
+		return ((size + 4)/5)*8;
+}
+
+
+inline std::size_t Base32::decodedLength(std::size_t size)
+{
+	return ((size + 7)/8)*5;
+}
+
+
+inline std::string Base32::encode(const std::string& data, int options)
+{
+	return encode(data.data(), data.size(), options);
+}
+
+
+} // namespace Lucid
+
+
+#endif // Foundation_Base32_INCLUDED
@@ -21,6 +21,7 @@
 #include "lucid/Foundation.h"
 #include "lucid/UnbufferedStreamBuf.h"
 #include <istream>
+#include <string>
 
 
 namespace Lucid {
@@ -43,11 +44,20 @@ public:
 private:
 	int readFromDevice();
 	int readOne();
+	std::streamsize xsgetn(char* p, std::streamsize count);
+	std::size_t readChars(std::size_t count);
+
+	enum
+	{
+		BLOCK_GROUPS = 512
+	};
 
 	unsigned char   _group[8];
 	int             _groupLength;
 	int             _groupIndex;
 	std::streambuf& _buf;
+	std::string     _chars;
+	std::size_t     _charsIndex;
 	
 	static unsigned char IN_ENCODING[256];
 	static bool          IN_ENCODING_INIT;
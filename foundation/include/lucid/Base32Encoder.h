@@ -45,6 +45,12 @@ public:
 
 private:
 	int writeToDevice(char c);
+	std::streamsize xsputn(const char* s, std::streamsize count);
+
+	enum
+	{
+		BLOCK_GROUPS = 512
+	};
 
 	unsigned char   _group[5];
 	int             _groupLength;
@@ -0,0 +1,126 @@
+//
+// Base64.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base64
+//
+// Definition of class Base64.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Base64_INCLUDED
+#define Foundation_Base64_INCLUDED
+
+
+#include "lucid/Foundation.h"
+#include <string>
+#include <cstddef>
+
+
+namespace Lucid {
+
+
+enum Base64EncodingOptions
+{
+	BASE64_URL_ENCODING = 0x01,
+		/// Use the URL and filename-safe alphabet,
+		/// replacing '+' with '-' and '/' with '_'.
+		///
+		/// Will also set line length to unlimited.
+
+	BASE64_NO_PADDING   = 0x02,
+		/// Do not append padding characters ('=') at end.
+
+	BASE64_LENIENT      = 0x04
+		/// Only used by Base64::decode(). Skip whitespace, accept
+		/// input with or without padding, and ignore the unused
+		/// bits of the last character.
+};
+
+
+class Foundation_API Base64
+	/// This class provides buffer-to-buffer Base64 encoding
+	/// and decoding, as specified in RFC 4648.
+	///
+	/// Unlike Base64Encoder and Base64Decoder, which are streams,
+	/// the functions of this class process a whole buffer at once.
+	/// On x86 CPUs with SSSE3 or AVX2, vectorized implementations
+	/// are selected at runtime; otherwise a table-driven
+	/// implementation is used.
+	///
+	/// Encoded data never contains line breaks. By default, decode()
+	/// is strict: it rejects whitespace, wrong or missing padding
+	/// (unless BASE64_NO_PADDING is specified, in which case padding
+	/// is rejected) and non-zero unused bits. Specify BASE64_LENIENT
+	/// to accept such input.
+{
+public:
+	static std::size_t encodedLength(std::size_t size, int options = 0);
+		/// Returns the number of characters required to encode
+		/// size bytes with the given options.
+
+	static std::size_t encode(const void* data, std::size_t size, char* buffer, int options = 0);
+		/// Encodes size bytes starting at data and writes the
+		/// result to buffer, which must have room for at least
+		/// encodedLength(size, options) characters.
+		///
+		/// Returns the number of characters written.
+
+	static std::string encode(const void* data, std::size_t size, int options = 0);
+		/// Encodes size bytes starting at data and returns the result.
+
+	static std::string encode(const std::string& data, int options = 0);
+		/// Encodes the given data and returns the result.
+
+	static std::size_t decodedLength(std::size_t size);
+		/// Returns the maximum number of bytes that size
+		/// characters of Base64 data decode to.
+
+	static std::size_t decode(const char* data, std::size_t size, void* buffer, int options = 0);
+		/// Decodes size characters starting at data and writes
+		/// the result to buffer, which must have room for at least
+		/// decodedLength(size) bytes.
+		///
+		/// Returns the number of bytes written. Throws a
+		/// DataFormatException if the data is not valid Base64.
+
+	static std::string decode(const std::string& data, int options = 0);
+		/// Decodes the given data and returns the result.
+		/// Throws a DataFormatException if the data is not
+		/// valid Base64.
+};
+
+
+//
+// inlines
+//
+inline std::size_t Base64::encodedLength(std::size_t size, int options)
+{
+	if (options & BASE64_NO_PADDING)
+		return (size/3)*4 + (size % 3 ? size % 3 + 1 : 0);
+	else
+		return ((size + 2)/3)*4;
+}
+
+
+inline std::size_t Base64::decodedLength(std::size_t size)
+{
+	return ((size + 3)/4)*3;
+}
+
+
+inline std::string Base64::encode(const std::string& data, int options)
+{
+	return encode(data.data(), data.size(), options);
+}
+
+
+} // namespace Lucid
+
+
+#endif // Foundation_Base64_INCLUDED
@@ -21,6 +21,7 @@
 #include "lucid/Foundation.h"
 #include "lucid/UnbufferedStreamBuf.h"
 #include <istream>
+#include <string>
 
 
 namespace Lucid {
@@ -43,12 +44,21 @@ public:
 private:
 	int readFromDevice();
 	int readOne();
+	std::streamsize xsgetn(char* p, std::streamsize count);
+	std::size_t readChars(std::size_t count);
+
+	enum
+	{
+		BLOCK_GROUPS = 1024
+	};
 
 	int             _options;
 	unsigned char   _group[3];
 	int             _groupLength;
 	int             _groupIndex;
 	std::streambuf& _buf;
+	std::string     _chars;
+	std::size_t     _charsIndex;
 	const unsigned char* _pInEncoding;
 
 	static unsigned char IN_ENCODING[256];
@@ -19,6 +19,7 @@
 
 
 #include "lucid/Foundation.h"
+#include "lucid/Base64.h"
 #include "lucid/UnbufferedStreamBuf.h"
 #include <ostream>
 
@@ -26,19 +27,6 @@
 namespace Lucid {
 
 
-enum Base64EncodingOptions
-{
-	BASE64_URL_ENCODING = 0x01,
-		/// Use the URL and filename-safe alphabet,
-		/// replacing '+' with '-' and '/' with '_'.
-		///
-		/// Will also set line length to unlimited.
-
-	BASE64_NO_PADDING   = 0x02
-		/// Do not append padding characters ('=') at end.
-};
-
-
 class Foundation_API Base64EncoderBuf: public UnbufferedStreamBuf
 	/// This streambuf base64-encodes all data written
 	/// to it and forwards it to a connected
@@ -69,6 +57,12 @@ public:
 
 private:
 	int writeToDevice(char c);
+	std::streamsize xsputn(const char* s, std::streamsize count);
+
+	enum
+	{
+		BLOCK_GROUPS = 1024
+	};
 
 	int             _options;
 	unsigned char   _group[3];
@@ -0,0 +1,64 @@
+//
+// CPUFeatures.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  CPUFeatures
+//
+// Definition of the CPUFeatures class.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_CPUFeatures_INCLUDED
+#define Foundation_CPUFeatures_INCLUDED
+
+
+#include "lucid/Foundation.h"
+
+
+namespace Lucid {
+
+
+class Foundation_API CPUFeatures
+	/// Detects the instruction set extensions supported by the
+	/// CPU the program is running on. This is used internally
+	/// to select vectorized implementations at runtime.
+	///
+	/// The CPU is only queried on the first call. On platforms
+	/// other than x86 and x86-64 with GCC or Clang, all
+	/// functions return false.
+{
+public:
+	static bool hasSSSE3();
+		/// Returns true if the CPU supports SSSE3.
+
+	static bool hasSSE41();
+		/// Returns true if the CPU supports SSE4.1.
+
+	static bool hasSSE42();
+		/// Returns true if the CPU supports SSE4.2.
+
+	static bool hasPCLMUL();
+		/// Returns true if the CPU supports carry-less
+		/// multiplication (PCLMULQDQ).
+
+	static bool hasAVX2();
+		/// Returns true if the CPU supports AVX2.
+
+	static bool hasSHA();
+		/// Returns true if the CPU supports the SHA extensions
+		/// (SHA-NI) together with SSE4.1.
+
+private:
+	CPUFeatures();
+};
+
+
+} // namespace Lucid
+
+
+#endif // Foundation_CPUFeatures_INCLUDED
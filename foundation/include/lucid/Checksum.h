@@ -25,7 +25,7 @@ namespace Lucid {
 
 
 class Foundation_API Checksum
-	/// This class calculates CRC-32 or Adler-32 checksums
+	/// This class calculates CRC-32, CRC-32C or Adler-32 checksums
 	/// for arbitrary data.
 	///
 	/// A cyclic redundancy check (CRC) is a type of hash function, which is used to produce a 
@@ -36,13 +36,26 @@ class Foundation_API Checksum
 	/// It is almost as reliable as a 32-bit cyclic redundancy check for protecting against 
 	/// accidental modification of data, such as distortions occurring during a transmission, 
 	/// but is significantly faster to calculate in software.
-	
+	///
+	/// CRC-32C uses the Castagnoli polynomial, which has better error
+	/// detection properties than CRC-32 and is used by iSCSI, SCTP,
+	/// ext4 and many storage formats.
+	///
+	/// On x86 CPUs, CRC-32 is calculated with PCLMULQDQ, CRC-32C with
+	/// the SSE 4.2 crc32 instruction and Adler-32 with SSSE3, if the CPU
+	/// supports them. On ARM, the CRC32 extension is used if enabled at
+	/// compile time. Otherwise, table-driven implementations
+	/// (slicing-by-8) are used.
+	///
+	/// Checksums of adjacent blocks of data, for example computed in
+	/// parallel, can be merged with combine().
 {
 public:
 	enum Type
 	{
 		TYPE_ADLER32 = 0,
-		TYPE_CRC32
+		TYPE_CRC32,
+		TYPE_CRC32C
 	};
 
 	Checksum();
@@ -69,6 +82,13 @@ public:
 	Type type() const;
 		/// Which type of checksum are we calulcating
 
+	static Lucid::UInt32 combine(Type t, Lucid::UInt32 checksum1, Lucid::UInt32 checksum2, Lucid::UInt64 length2);
+		/// Combines the checksums of two adjacent blocks of data.
+		/// Given the checksum1 of a first block and the checksum2
+		/// of a second block of length2 bytes, returns the checksum
+		/// of both blocks concatenated, as if it had been calculated
+		/// in a single pass.
+
 private:
 	Type         _type;
 	Lucid::UInt32 _value;
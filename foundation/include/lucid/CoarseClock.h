@@ -0,0 +1,75 @@
+//
+// CoarseClock.h
+//
+// Library: Foundation
+// Package: DateTime
+// Module:  CoarseClock
+//
+// Definition of the CoarseClock class.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_CoarseClock_INCLUDED
+#define Foundation_CoarseClock_INCLUDED
+
+
+#include "lucid/Foundation.h"
+#include "lucid/Timestamp.h"
+#include "lucid/Clock.h"
+#include <string>
+
+
+namespace Lucid {
+
+
+class Foundation_API CoarseClock
+	/// CoarseClock provides the current time for code that needs
+	/// it very often, but not with full precision, like servers
+	/// stamping every request or response.
+	///
+	/// On Linux, now() and clock() read CLOCK_REALTIME_COARSE and
+	/// CLOCK_MONOTONIC_COARSE. The kernel updates these once per
+	/// timer tick (typically every 1 to 4 milliseconds), and they can
+	/// be read without a system call or a hardware timer access.
+	/// On other platforms, the full-precision Timestamp and
+	/// Clock are used.
+	///
+	/// httpDate() returns the current time formatted for the
+	/// HTTP Date header. The formatted string is cached per thread
+	/// and only rebuilt when the second changes.
+{
+public:
+	static Timestamp now();
+		/// Returns the current time, which may lag the
+		/// system time by up to resolution().
+
+	static Clock clock();
+		/// Returns the current monotonic clock value, which may
+		/// lag Clock() by up to resolution().
+
+	static Timestamp::TimeDiff resolution();
+		/// Returns the resolution of now() and clock()
+		/// in microseconds.
+
+	static const std::string& httpDate();
+		/// Returns the time given by now(), formatted as
+		/// DateTimeFormat::HTTP_FORMAT.
+		///
+		/// The returned reference remains valid until
+		/// the next call to httpDate() from the same thread.
+
+private:
+	CoarseClock();
+	CoarseClock(const CoarseClock&);
+	CoarseClock& operator = (const CoarseClock&);
+};
+
+
+} // namespace Lucid
+
+
+#endif // Foundation_CoarseClock_INCLUDED
@@ -0,0 +1,195 @@
+//
+// CopyOnWritePtr.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  CopyOnWritePtr
+//
+// Definition of the CopyOnWritePtr template class.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_CopyOnWritePtr_INCLUDED
+#define Foundation_CopyOnWritePtr_INCLUDED
+
+
+#include "lucid/Foundation.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+
+namespace Lucid {
+
+
+namespace Impl {
+
+
+class Foundation_API HazardSlots
+	/// Hands out per-thread hazard slots to CopyOnWritePtr readers.
+	///
+	/// Every thread owns a small set of cache line aligned slots,
+	/// so publishing a hazard only writes to memory owned by the
+	/// reading thread. Slots are recycled when a thread terminates.
+{
+public:
+	typedef std::atomic<const void*> Slot;
+
+	static Slot* acquire();
+		/// Returns a free slot owned by the calling thread.
+		/// The slot must be released by storing a null pointer
+		/// into it, from the same thread.
+
+	static void collect(std::vector<const void*>& hazards);
+		/// Appends all pointers currently published by any thread
+		/// to hazards, which is sorted afterwards.
+};
+
+
+} // namespace Impl
+
+
+template <class C>
+class CopyOnWritePtr
+	/// CopyOnWritePtr holds an immutable snapshot of an object that
+	/// can be read concurrently by many threads without locking and
+	/// without allocating memory, in the spirit of read-copy-update (RCU).
+	///
+	/// Readers pin the current snapshot with a ReadGuard, which publishes
+	/// the snapshot in a hazard slot owned by the reading thread.
+	/// Readers therefore never write to memory shared with other readers.
+	/// Writers create a modified copy of the current snapshot and publish
+	/// it with assign(). Readers that pinned the previous snapshot keep
+	/// using it.
+	///
+	/// Writers must be serialized by the caller, typically by holding
+	/// a mutex around the copy-modify-assign sequence. get() must only
+	/// be called by a writer.
+	///
+	/// Snapshots that have been replaced are deleted by the next assign()
+	/// that finds no ReadGuard pinning them anymore, or by the destructor.
+	/// Only snapshots still pinned by a reader are kept, so the number
+	/// of retained snapshots is bounded by the number of active readers.
+{
+public:
+	class ReadGuard
+		/// Pins the current snapshot of a CopyOnWritePtr for reading.
+		/// The snapshot stays valid until the ReadGuard is destroyed.
+		/// A ReadGuard must be destroyed by the thread that created it.
+	{
+	public:
+		explicit ReadGuard(const CopyOnWritePtr& ptr):
+			_pSlot(Impl::HazardSlots::acquire())
+		{
+			const C* pSnapshot = ptr._pCurrent.load();
+			for (;;)
+			{
+				_pSlot->store(pSnapshot);
+				const C* pCurrent = ptr._pCurrent.load();
+				if (pCurrent == pSnapshot) break;
+				pSnapshot = pCurrent;
+			}
+			_pSnapshot = pSnapshot;
+		}
+
+		~ReadGuard()
+		{
+			_pSlot->store(0, std::memory_order_release);
+		}
+
+		const C& operator * () const
+		{
+			return *_pSnapshot;
+		}
+
+		const C* operator -> () const
+		{
+			return _pSnapshot;
+		}
+
+		const C* get() const
+		{
+			return _pSnapshot;
+		}
+
+	private:
+		ReadGuard(const ReadGuard&);
+		ReadGuard& operator = (const ReadGuard&);
+
+		Impl::HazardSlots::Slot* _pSlot;
+		const C* _pSnapshot;
+	};
+
+	CopyOnWritePtr():
+		_pCurrent(new C)
+	{
+	}
+
+	explicit CopyOnWritePtr(const C& value):
+		_pCurrent(new C(value))
+	{
+	}
+
+	~CopyOnWritePtr()
+		/// Destroys the CopyOnWritePtr and all snapshots.
+		/// No ReadGuard must be active.
+	{
+		delete _pCurrent.load();
+		for (typename std::vector<C*>::iterator it = _retired.begin(); it != _retired.end(); ++it)
+		{
+			delete *it;
+		}
+	}
+
+	const C* get() const
+		/// Returns the current snapshot. Must only be called by
+		/// a writer; readers must use a ReadGuard.
+	{
+		return _pCurrent.load();
+	}
+
+	void assign(C* pSnapshot)
+		/// Publishes the given snapshot, taking ownership of it.
+		/// The previous snapshot is deleted once no reader uses it anymore.
+	{
+		poco_check_ptr (pSnapshot);
+
+		_retired.reserve(_retired.size() + 1);
+		_retired.push_back(_pCurrent.exchange(pSnapshot));
+		reclaim();
+	}
+
+private:
+	CopyOnWritePtr(const CopyOnWritePtr&);
+	CopyOnWritePtr& operator = (const CopyOnWritePtr&);
+
+	void reclaim()
+		/// Deletes all retired snapshots not pinned by a ReadGuard.
+	{
+		std::vector<const void*> hazards;
+		Impl::HazardSlots::collect(hazards);
+
+		typename std::vector<C*>::iterator keep = _retired.begin();
+		for (typename std::vector<C*>::iterator it = _retired.begin(); it != _retired.end(); ++it)
+		{
+			if (std::binary_search(hazards.begin(), hazards.end(), static_cast<const void*>(*it)))
+				*keep++ = *it;
+			else
+				delete *it;
+		}
+		_retired.erase(keep, _retired.end());
+	}
+
+	std::atomic<C*> _pCurrent;
+	std::vector<C*> _retired;
+};
+
+
+} // namespace Lucid
+
+
+#endif // Foundation_CopyOnWritePtr_INCLUDED
@@ -29,6 +29,7 @@
 #include "lucid/Runnable.h"
 #include "lucid/Thread.h"
 #include "lucid/AtomicCounter.h"
+#include <vector>
 
 
 namespace Lucid {
@@ -48,8 +49,10 @@ class Foundation_API DirectoryWatcher: protected Runnable
 	/// of this thread. 
 	///
 	/// Note that changes to files in subdirectories of the watched
-	/// directory are not reported. Separate DirectoryWatcher objects
-	/// must be created for these directories if they should be watched.
+	/// directory are not reported, unless the DW_OPT_RECURSIVE option
+	/// is given, which is only supported with inotify. Otherwise, separate
+	/// DirectoryWatcher objects must be created for these directories
+	/// if they should be watched.
 	///
 	/// Changes to file attributes are not reported.
 	///
@@ -68,6 +71,30 @@ class Foundation_API DirectoryWatcher: protected Runnable
 	/// The order of these two events is not defined.
 	///
 	/// An event mask can be specified to enable only certain events.
+	///
+	/// In addition to the events for single items, all changes detected
+	/// together are reported as one batch via the itemsChanged event.
+	/// With inotify, a coalescing window can be specified. All changes
+	/// within the window are then combined into one batch, with multiple
+	/// changes to the same item reduced to the net change (e.g., an item
+	/// that has been added and modified is only reported as added, and
+	/// an item that has been added and removed again is not reported).
+	/// An item that has been removed and added again (e.g., replaced
+	/// by renaming another file over it) is reported as modified if
+	/// DW_ITEM_MODIFIED is in the event mask. Otherwise, the removal and
+	/// the addition are reported as two separate changes.
+	/// Unless DW_OPT_BATCH_ONLY is given, every change is therefore
+	/// delivered twice: once to the event for the single item, and once
+	/// as part of the batch. Subscribers should use either the events
+	/// for single items or itemsChanged, but not both.
+	///
+	/// If the inotify event queue overflows, the watched directory is
+	/// scanned again, and all differences found are reported. To keep
+	/// starting a watcher for a large tree cheap, the initial scan only
+	/// lists the items. Size and modification date of an item are
+	/// recorded once a change to it has been reported. After an overflow,
+	/// items without recorded metadata are reported as modified if they
+	/// have been modified after the watcher was started.
 {
 public:
 	enum DirectoryEventType
@@ -97,6 +124,21 @@ public:
 			/// Disables all event types.
 	};
 	
+	enum DirectoryWatcherOption
+	{
+		DW_OPT_RECURSIVE = 1,
+			/// Also watch all subdirectories, including subdirectories
+			/// that are created after the DirectoryWatcher has been started.
+			/// The items in a directory that is created or moved into the
+			/// watched tree are reported as added. The items in a directory
+			/// that is moved out of the tree are not reported individually.
+			/// Only supported with inotify.
+
+		DW_OPT_BATCH_ONLY = 2
+			/// Report changes only via the itemsChanged event. The events
+			/// for single items (itemAdded, itemRemoved, etc.) are not fired.
+	};
+
 	enum
 	{
 		DW_DEFAULT_SCAN_INTERVAL = 5 /// Default scan interval for platforms that don't provide a native notification mechanism.
@@ -113,6 +155,20 @@ public:
 		const File& item;          /// The directory or file that has been changed.
 		DirectoryEventType event;  /// The kind of event.
 	};
+
+	struct DirectoryChange
+	{
+		DirectoryChange(const File& f, DirectoryEventType ev):
+			item(f),
+			event(ev)
+		{
+		}
+
+		File item;                 /// The directory or file that has been changed.
+		DirectoryEventType event;  /// The kind of event.
+	};
+
+	typedef std::vector<DirectoryChange> DirectoryChangeList;
 	
 	BasicEvent<const DirectoryEvent> itemAdded;
 		/// Fired when a file or directory has been created or added to the directory.
@@ -129,6 +185,11 @@ public:
 	BasicEvent<const DirectoryEvent> itemMovedTo;
 		/// Fired when a file or directory has been moved. This event delivers the new name.
 		
+	BasicEvent<const DirectoryChangeList> itemsChanged;
+		/// Fired once for every batch of changes, after the events
+		/// for the single items have been fired (unless
+		/// DW_OPT_BATCH_ONLY has been specified).
+
 	BasicEvent<const Exception> scanError;
 		/// Fired when an error occurs while scanning for changes.
 	
@@ -148,6 +209,30 @@ public:
 		/// scanInterval specifies the interval in seconds between scans
 		/// of the directory.
 
+	DirectoryWatcher(const std::string& path, int eventMask, int scanInterval, int options, long coalesceWindow = 0);
+		/// Creates a DirectoryWatcher for the directory given in path,
+		/// using the given options (see DirectoryWatcherOption).
+		///
+		/// With inotify, changes are collected for coalesceWindow
+		/// milliseconds after the first change has been detected,
+		/// and are then reported as one batch. If coalesceWindow is 0,
+		/// changes are reported as soon as they have been read.
+		///
+		/// Throws a NotImplementedException if DW_OPT_RECURSIVE is
+		/// given on a platform without inotify.
+
+	DirectoryWatcher(const File& directory, int eventMask, int scanInterval, int options, long coalesceWindow = 0);
+		/// Creates a DirectoryWatcher for the specified directory,
+		/// using the given options (see DirectoryWatcherOption).
+		///
+		/// With inotify, changes are collected for coalesceWindow
+		/// milliseconds after the first change has been detected,
+		/// and are then reported as one batch. If coalesceWindow is 0,
+		/// changes are reported as soon as they have been read.
+		///
+		/// Throws a NotImplementedException if DW_OPT_RECURSIVE is
+		/// given on a platform without inotify.
+
 	~DirectoryWatcher();
 		/// Destroys the DirectoryWatcher.
 		
@@ -166,6 +251,18 @@ public:
 		
 	int scanInterval() const;
 		/// Returns the scan interval in seconds.
+
+	int options() const;
+		/// Returns the options passed to the constructor.
+
+	bool recursive() const;
+		/// Returns true iff subdirectories are watched as well.
+
+	bool batchOnly() const;
+		/// Returns true iff changes are only reported via itemsChanged.
+
+	long coalesceWindow() const;
+		/// Returns the coalescing window in milliseconds.
 		
 	const File& directory() const;
 		/// Returns the directory being watched.
@@ -189,6 +286,8 @@ private:
 	int _eventMask;
 	AtomicCounter _eventsSuspended;
 	int _scanInterval;
+	int _options;
+	long _coalesceWindow;
 	DirectoryWatcherStrategy* _pStrategy;
 };
 
@@ -216,6 +315,30 @@ inline int DirectoryWatcher::scanInterval() const
 }
 
 
+inline int DirectoryWatcher::options() const
+{
+	return _options;
+}
+
+
+inline bool DirectoryWatcher::recursive() const
+{
+	return (_options & DW_OPT_RECURSIVE) != 0;
+}
+
+
+inline bool DirectoryWatcher::batchOnly() const
+{
+	return (_options & DW_OPT_BATCH_ONLY) != 0;
+}
+
+
+inline long DirectoryWatcher::coalesceWindow() const
+{
+	return _coalesceWindow;
+}
+
+
 inline const File& DirectoryWatcher::directory() const
 {
 	return _directory;
@@ -162,6 +162,26 @@ class Foundation_API FileChannel: public Channel
 	///            if it exists (unless other conditions for a rotation are met). 
 	///            This is the default.
 	///
+	/// The asyncArchive property specifies whether rotated log files are
+	/// archived, compressed and purged in the background. Valid values are:
+	///
+	///   * true:  When the log file is rotated, it is only renamed to a
+	///            temporary name (e.g., "access.log~0") before logging
+	///            continues in a new log file. Archiving, compressing and
+	///            purging is done by a background thread. At most eight
+	///            rotations can be pending; if more log files are rotated
+	///            in the meantime, logging waits until the oldest pending
+	///            rotation has been completed. Closing the channel waits
+	///            for all pending rotations. Errors are reported to the
+	///            ErrorHandler. Archive strategies that do not support
+	///            ArchiveStrategy::archiveFile() always archive synchronously.
+	///   * false: Log files are archived and purged by the thread
+	///            logging the message that causes the rotation, and
+	///            compressed by a background thread. This is the default.
+	///
+	/// Renamed log files that have not been archived when the process
+	/// terminated are archived when the channel is opened again.
+	///
 	/// For a more lightweight file channel class, see SimpleFileChannel.
 {
 public:
@@ -205,6 +225,9 @@ public:
 		///                   for details.
 		///   * rotateOnOpen: Specifies whether an existing log file should be 
 		///                   rotated and archived when the channel is opened.
+		///   * asyncArchive: Specifies whether rotated log files are archived
+		///                   and purged in the background. See the FileChannel
+		///                   class for details.
 
 	std::string getProperty(const std::string& name) const;
 		/// Returns the value of the property with the given name.
@@ -229,6 +252,7 @@ public:
 	static const std::string PROP_PURGECOUNT;
 	static const std::string PROP_FLUSH;
 	static const std::string PROP_ROTATEONOPEN;
+	static const std::string PROP_ASYNCARCHIVE;
 
 protected:
 	~FileChannel();
@@ -239,9 +263,16 @@ protected:
 	void setPurgeCount(const std::string& count);
 	void setFlush(const std::string& flush);
 	void setRotateOnOpen(const std::string& rotateOnOpen);
+	void setAsyncArchive(const std::string& asyncArchive);
 	void purge();
 
 private:
+	class Archiver;
+
+	void rotate();
+	void archivePending();
+	void archiveRotated(const std::string& rotatedPath);
+	void waitForArchiver();
 	bool setNoPurge(const std::string& value);
 	int extractDigit(const std::string& value, std::string::const_iterator* nextToDigit = NULL) const;
 	void setPurgeStrategy(PurgeStrategy* strategy);
@@ -256,10 +287,12 @@ private:
 	std::string      _purgeCount;
 	bool             _flush;
 	bool             _rotateOnOpen;
+	bool             _asyncArchive;
 	LogFile*         _pFile;
 	RotateStrategy*  _pRotateStrategy;
 	ArchiveStrategy* _pArchiveStrategy;
 	PurgeStrategy*   _pPurgeStrategy;
+	Archiver*        _pArchiver;
 	FastMutex        _mutex;
 };
 
@@ -20,6 +20,7 @@
 
 #include "lucid/Foundation.h"
 #include <cstddef>
+#include <string>
 
 
 namespace Lucid {
@@ -34,6 +35,28 @@ std::size_t Foundation_API hash(UInt32 n);
 std::size_t Foundation_API hash(Int64 n);
 std::size_t Foundation_API hash(UInt64 n);
 std::size_t Foundation_API hash(const std::string& str);
+std::size_t Foundation_API hash(UInt64 n, UInt64 seed);
+std::size_t Foundation_API hash(const std::string& str, UInt64 seed);
+
+
+UInt64 Foundation_API hash64(const void* data, std::size_t length, UInt64 seed = 0);
+	/// Returns a 64-bit hash of length bytes starting at data.
+	///
+	/// The hash function is based on wyhash and processes
+	/// the data eight bytes at a time. Different seeds give
+	/// unrelated hash values for the same data. The hash
+	/// values are the same on all platforms, but they are
+	/// not suitable for cryptographic purposes.
+
+
+UInt64 Foundation_API randomHashSeed();
+	/// Returns a random seed for hash64(). The seed is chosen
+	/// once per process.
+	///
+	/// Hash tables whose keys come from untrusted sources
+	/// (e.g., HTTP request headers) should use a random seed,
+	/// so that an attacker can't choose keys that collide.
+	/// See SeededHash.
 
 
 template <class T>
@@ -48,54 +71,100 @@ struct Hash
 };
 
 
+template <>
+struct Hash<std::string>
+	/// The hash function for strings.
+{
+	std::size_t operator () (const std::string& value) const
+		/// Returns the hash for the given value.
+	{
+		return Lucid::hash(value);
+	}
+};
+
+
+template <class T>
+struct SeededHash
+	/// A hash function that uses the process-wide random
+	/// seed returned by randomHashSeed(). Use it with
+	/// HashMap, HashSet or LinearHashTable to protect them
+	/// against hash flooding, e.g.:
+	///
+	///     HashMap<std::string, int, SeededHash<std::string>> map;
+	///
+	/// Unlike Hash, the hash values differ between runs.
+{
+	SeededHash():
+		_seed(randomHashSeed())
+	{
+	}
+
+	std::size_t operator () (const T& value) const
+		/// Returns the hash for the given value.
+	{
+		return Lucid::hash(value, _seed);
+	}
+
+private:
+	UInt64 _seed;
+};
+
+
 //
 // inlines
 //
 inline std::size_t hash(Int8 n)
 {
-	return static_cast<std::size_t>(n)*2654435761U; 
+	return hash(static_cast<UInt64>(n));
 }
 
 
 inline std::size_t hash(UInt8 n)
 {
-	return static_cast<std::size_t>(n)*2654435761U; 
+	return hash(static_cast<UInt64>(n));
 }
 
 
 inline std::size_t hash(Int16 n)
 {
-	return static_cast<std::size_t>(n)*2654435761U; 
+	return hash(static_cast<UInt64>(n));
 }
 
 
 inline std::size_t hash(UInt16 n)
 {
-	return static_cast<std::size_t>(n)*2654435761U; 
+	return hash(static_cast<UInt64>(n));
 }
 
 
 inline std::size_t hash(Int32 n)
 {
-	return static_cast<std::size_t>(n)*2654435761U; 
+	return hash(static_cast<UInt64>(n));
 }
 
 
 inline std::size_t hash(UInt32 n)
 {
-	return static_cast<std::size_t>(n)*2654435761U; 
+	return hash(static_cast<UInt64>(n));
 }
 
 
 inline std::size_t hash(Int64 n)
 {
-	return static_cast<std::size_t>(n)*2654435761U; 
+	return hash(static_cast<UInt64>(n));
 }
 
 
 inline std::size_t hash(UInt64 n)
 {
-	return static_cast<std::size_t>(n)*2654435761U; 
+	n *= 0x9E3779B97F4A7C15ULL;
+	return static_cast<std::size_t>(n ^ (n >> 32));
+}
+
+
+inline std::size_t hash(UInt64 n, UInt64 seed)
+{
+	return hash(n ^ seed);
 }
 
 
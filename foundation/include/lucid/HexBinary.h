@@ -0,0 +1,94 @@
+//
+// HexBinary.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  HexBinary
+//
+// Definition of class HexBinary.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_HexBinary_INCLUDED
+#define Foundation_HexBinary_INCLUDED
+
+
+#include "lucid/Foundation.h"
+#include <string>
+#include <cstddef>
+
+
+namespace Lucid {
+
+
+enum HexBinaryEncodingOptions
+{
+	HEXBINARY_UPPERCASE = 0x01,
+		/// Use uppercase hexadecimal digits for encoding.
+
+	HEXBINARY_LENIENT   = 0x02
+		/// Only used by HexBinary::decode(). Skip whitespace.
+};
+
+
+class Foundation_API HexBinary
+	/// This class provides buffer-to-buffer hexBinary encoding
+	/// and decoding, where each octet is represented by two
+	/// hexadecimal digits.
+	///
+	/// Unlike HexBinaryEncoder and HexBinaryDecoder, which are streams,
+	/// the functions of this class process a whole buffer at once.
+	/// On x86 CPUs with SSSE3, a vectorized implementation is
+	/// selected at runtime; otherwise a table-driven implementation
+	/// is used.
+	///
+	/// Both uppercase and lowercase digits are accepted for decoding.
+	/// By default, decode() rejects whitespace. Specify HEXBINARY_LENIENT
+	/// to skip it.
+{
+public:
+	static std::size_t encode(const void* data, std::size_t size, char* buffer, int options = 0);
+		/// Encodes size bytes starting at data and writes the
+		/// result to buffer, which must have room for at least
+		/// 2*size characters.
+		///
+		/// Returns the number of characters written.
+
+	static std::string encode(const void* data, std::size_t size, int options = 0);
+		/// Encodes size bytes starting at data and returns the result.
+
+	static std::string encode(const std::string& data, int options = 0);
+		/// Encodes the given data and returns the result.
+
+	static std::size_t decode(const char* data, std::size_t size, void* buffer, int options = 0);
+		/// Decodes size characters starting at data and writes
+		/// the result to buffer, which must have room for at least
+		/// size/2 bytes.
+		///
+		/// Returns the number of bytes written. Throws a
+		/// DataFormatException if the data is not valid hexBinary.
+
+	static std::string decode(const std::string& data, int options = 0);
+		/// Decodes the given data and returns the result.
+		/// Throws a DataFormatException if the data is not
+		/// valid hexBinary.
+};
+
+
+//
+// inlines
+//
+inline std::string HexBinary::encode(const std::string& data, int options)
+{
+	return encode(data.data(), data.size(), options);
+}
+
+
+} // namespace Lucid
+
+
+#endif // Foundation_HexBinary_INCLUDED
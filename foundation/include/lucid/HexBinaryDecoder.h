@@ -21,6 +21,7 @@
 #include "lucid/Foundation.h"
 #include "lucid/UnbufferedStreamBuf.h"
 #include <istream>
+#include <string>
 
 
 namespace Lucid {
@@ -47,8 +48,17 @@ public:
 private:
 	int readFromDevice();
 	int readOne();
+	std::streamsize xsgetn(char* p, std::streamsize count);
+	std::size_t readChars(std::size_t count);
+
+	enum
+	{
+		BLOCK_SIZE = 2048
+	};
 
 	std::streambuf& _buf;
+	std::string     _chars;
+	std::size_t     _charsIndex;
 };
 
 
@@ -232,27 +232,34 @@ private:
 		return val1 == val2;
 	}
 
-	bool isEqual(const std::string& s1, const std::string& s2) const
+	bool isEqual(const StringView& s1, const StringView& s2) const
 	{
-		if (!CaseSensitive)
+		if (s1.size() != s2.size())
+			return false;
+		else if (!CaseSensitive)
 			return Lucid::icompare(s1, s2) == 0;
 		else
 			return s1 == s2;
 	}
 
+	bool isEqual(const std::string& s1, const std::string& s2) const
+	{
+		return isEqual(StringView(s1), StringView(s2));
+	}
+
 	bool isEqual(const std::string& s1, const char* s2) const
 	{
-		return isEqual(s1, std::string(s2));
+		return isEqual(StringView(s1), StringView(s2));
 	}
 
 	bool isEqual(const char* s1, const std::string& s2) const
 	{
-		return isEqual(std::string(s1), s2);
+		return isEqual(StringView(s1), StringView(s2));
 	}
 
 	bool isEqual(const char* s1, const char* s2) const
 	{
-		return isEqual(std::string(s1), std::string(s2));
+		return isEqual(StringView(s1), StringView(s2));
 	}
 
 	Container _container;
@@ -190,8 +190,24 @@ public:
 		/// If the parameter does not exist, it is created with an
 		/// empty string value.
 
+	static void setCoarseClock(bool coarse);
+		/// If coarse is true, new messages take their time from
+		/// CoarseClock::now() instead of Timestamp(). This is cheaper,
+		/// but the time may lag the system time by up to
+		/// CoarseClock::resolution() (typically 1 to 4 milliseconds),
+		/// so messages logged in quick succession may have the same time.
+		///
+		/// The default is false.
+
+	static bool getCoarseClock();
+		/// Returns true if new messages take their time from
+		/// CoarseClock::now().
+
 protected:
 	void init();
+	static Timestamp now();
+		/// Returns the time for a new message.
+
 	typedef std::map<std::string, std::string> StringMap;
 
 private:
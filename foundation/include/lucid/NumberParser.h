@@ -35,6 +35,9 @@ class Foundation_API NumberParser
 	/// Note that leading or trailing whitespace is not allowed
 	/// in the string. Lucid::trim() or Lucid::trimInPlace()
 	/// can be used to remove leading or trailing whitespace.
+	///
+	/// The tryParse*() overloads taking a character pointer and
+	/// a length parse a part of a larger buffer without copying it.
 {
 public:
 	static const unsigned short NUM_BASE_OCT = 010;
@@ -50,6 +53,12 @@ public:
 		/// Returns true if a valid integer has been found, false otherwise. 
 		/// If parsing was not successful, value is undefined.
 	
+	static bool tryParse(const char* s, std::size_t length, int& value, char thousandSeparator = ',');
+		/// Parses an integer value in decimal notation from the given
+		/// number of characters starting at s.
+		/// Returns true if a valid integer has been found, false otherwise.
+		/// If parsing was not successful, value is undefined.
+
 	static unsigned parseUnsigned(const std::string& s, char thousandSeparator = ',');
 		/// Parses an unsigned integer value in decimal notation from the given string.
 		/// Throws a SyntaxException if the string does not hold a number in decimal notation.
@@ -59,6 +68,12 @@ public:
 		/// Returns true if a valid integer has been found, false otherwise. 
 		/// If parsing was not successful, value is undefined.
 
+	static bool tryParseUnsigned(const char* s, std::size_t length, unsigned& value, char thousandSeparator = ',');
+		/// Parses an unsigned integer value in decimal notation from the given
+		/// number of characters starting at s.
+		/// Returns true if a valid integer has been found, false otherwise.
+		/// If parsing was not successful, value is undefined.
+
 	static unsigned parseHex(const std::string& s);
 		/// Parses an integer value in hexadecimal notation from the given string.
 		/// Throws a SyntaxException if the string does not hold a number in
@@ -90,6 +105,12 @@ public:
 		/// Returns true if a valid integer has been found, false otherwise. 
 		/// If parsing was not successful, value is undefined.
 
+	static bool tryParse64(const char* s, std::size_t length, Int64& value, char thousandSeparator = ',');
+		/// Parses a 64-bit integer value in decimal notation from the given
+		/// number of characters starting at s.
+		/// Returns true if a valid integer has been found, false otherwise.
+		/// If parsing was not successful, value is undefined.
+
 	static UInt64 parseUnsigned64(const std::string& s, char thousandSeparator = ',');
 		/// Parses an unsigned 64-bit integer value in decimal notation from the given string.
 		/// Throws a SyntaxException if the string does not hold a number in decimal notation.
@@ -99,6 +120,12 @@ public:
 		/// Returns true if a valid integer has been found, false otherwise. 
 		/// If parsing was not successful, value is undefined.
 
+	static bool tryParseUnsigned64(const char* s, std::size_t length, UInt64& value, char thousandSeparator = ',');
+		/// Parses an unsigned 64-bit integer value in decimal notation from the
+		/// given number of characters starting at s.
+		/// Returns true if a valid integer has been found, false otherwise.
+		/// If parsing was not successful, value is undefined.
+
 	static UInt64 parseHex64(const std::string& s);
 		/// Parses a 64 bit-integer value in hexadecimal notation from the given string.
 		/// Throws a SyntaxException if the string does not hold a number in hexadecimal notation.
@@ -132,6 +159,13 @@ public:
 		/// false otherwise.
 		/// If parsing was not successful, value is undefined.
 
+	static bool tryParseFloat(const char* s, std::size_t length, double& value, char decimalSeparator = '.', char thousandSeparator = ',');
+		/// Parses a double value in decimal floating point notation
+		/// from the given number of characters starting at s.
+		/// Returns true if a valid floating point number has been found,
+		/// false otherwise.
+		/// If parsing was not successful, value is undefined.
+
 	static bool parseBool(const std::string& s);
 		/// Parses a bool value in decimal or string notation
 		/// from the given string.
@@ -30,6 +30,7 @@
 #include <limits>
 #include <cmath>
 #include <cctype>
+#include <cstring>
 #if !defined(POCO_NO_LOCALE)
 	#include <locale>
 #endif
@@ -164,21 +165,60 @@ inline char thousandSeparator()
 // String to Number Conversions
 //
 
+namespace Impl {
+
+	inline UInt64 loadEightChars(const char* p)
+		/// Loads eight characters into an integer, with the
+		/// first character in the least significant byte.
+	{
+		UInt64 v;
+		std::memcpy(&v, p, sizeof(v));
+#if defined(POCO_ARCH_BIG_ENDIAN)
+		v = ((v & 0x00000000FFFFFFFFULL) << 32) | ((v & 0xFFFFFFFF00000000ULL) >> 32);
+		v = ((v & 0x0000FFFF0000FFFFULL) << 16) | ((v & 0xFFFF0000FFFF0000ULL) >> 16);
+		v = ((v & 0x00FF00FF00FF00FFULL) << 8)  | ((v & 0xFF00FF00FF00FF00ULL) >> 8);
+#endif
+		return v;
+	}
+
+	inline bool isEightDigits(UInt64 v)
+		/// Returns true if all eight characters loaded by
+		/// loadEightChars() are decimal digits.
+	{
+		return (((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+	}
+
+	inline UInt32 parseEightDigits(UInt64 v)
+		/// Converts eight decimal digits loaded by loadEightChars()
+		/// to their value, combining pairs of digits, then pairs of
+		/// pairs, and so on.
+	{
+		v -= 0x3030303030303030ULL;
+		v = (v*10) + (v >> 8);
+		v = (((v & 0x000000FF000000FFULL)*(100 + (1000000ULL << 32))) + (((v >> 16) & 0x000000FF000000FFULL)*(1 + (10000ULL << 32)))) >> 32;
+		return static_cast<UInt32>(v);
+	}
+
+} // namespace Impl
+
+
 template <typename I>
-bool strToInt(const char* pStr, I& outResult, short base, char thSep = ',')
-	/// Converts zero-terminated character array to integer number;
+bool strToInt(const char* pStr, const char* pEnd, I& outResult, short base, char thSep = ',')
+	/// Converts the characters in the range [pStr, pEnd) to integer number;
 	/// Thousand separators are recognized for base10 and current locale;
 	/// they are silently skipped and not verified for correct positioning.
 	/// It is not allowed to convert a negative number to unsigned integer.
 	///
+	/// For base 10, digits are converted eight at a time.
+	///
 	/// Function returns true if successful. If parsing was unsuccessful,
 	/// the return value is false with the result value undetermined.
 {
 	poco_assert_dbg (base == 2 || base == 8 || base == 10 || base == 16);
 
 	if (!pStr) return false;
-	while (std::isspace(*pStr)) ++pStr;
-	if (*pStr == '\0') return false;
+	while (pStr != pEnd && std::isspace(static_cast<unsigned char>(*pStr))) ++pStr;
+	if (pStr == pEnd) return false;
 	bool negative = false;
 	if ((base == 10) && (*pStr == '-'))
 	{
@@ -208,7 +248,20 @@ bool strToInt(const char* pStr, I& outResult, short base, char thSep = ',')
 	}
 
 	uintmax_t result = 0;
-	for (; *pStr != '\0'; ++pStr)
+	if (base == 10)
+	{
+		// up to 16 digits can't overflow, so they are
+		// converted without checking every digit
+		for (int i = 0; i < 2 && pEnd - pStr >= 8; i++)
+		{
+			UInt64 chunk = Impl::loadEightChars(pStr);
+			if (!Impl::isEightDigits(chunk)) break;
+			result = result*100000000 + Impl::parseEightDigits(chunk);
+			pStr += 8;
+		}
+		if (result > limitCheck) return false;
+	}
+	for (; pStr != pEnd; ++pStr)
 	{
 		if  (result > (limitCheck / base)) return false;
 		switch (*pStr)
@@ -288,11 +341,22 @@ bool strToInt(const char* pStr, I& outResult, short base, char thSep = ',')
 }
 
 
+template <typename I>
+bool strToInt(const char* pStr, I& outResult, short base, char thSep = ',')
+	/// Converts zero-terminated character array to integer number;
+	/// This is a wrapper function, for details see see the
+	/// bool strToInt(const char*, const char*, I&, short, char) implementation.
+{
+	if (!pStr) return false;
+	return strToInt(pStr, pStr + std::strlen(pStr), outResult, base, thSep);
+}
+
+
 template <typename I>
 bool strToInt(const std::string& str, I& result, short base, char thSep = ',')
 	/// Converts string to integer number;
 	/// This is a wrapper function, for details see see the
-	/// bool strToInt(const char*, I&, short, char) implementation.
+	/// bool strToInt(const char*, const char*, I&, short, char) implementation.
 {
 	return strToInt(str.c_str(), result, base, thSep);
 }
@@ -372,6 +436,50 @@ namespace Impl {
 		const char* _end;
 };
 
+	inline char* formatDecimal(uintmax_t value, char* pEnd)
+		/// Writes the decimal digits of value backwards, two at a time,
+		/// ending before pEnd, and returns a pointer to the first digit.
+	{
+		static const char DIGIT_PAIRS[] =
+			"00010203040506070809"
+			"10111213141516171819"
+			"20212223242526272829"
+			"30313233343536373839"
+			"40414243444546474849"
+			"50515253545556575859"
+			"60616263646566676869"
+			"70717273747576777879"
+			"80818283848586878889"
+			"90919293949596979899";
+
+		while (value >= 100)
+		{
+			const unsigned i = static_cast<unsigned>(value % 100)*2;
+			value /= 100;
+			*--pEnd = DIGIT_PAIRS[i + 1];
+			*--pEnd = DIGIT_PAIRS[i];
+		}
+		if (value >= 10)
+		{
+			const unsigned i = static_cast<unsigned>(value)*2;
+			*--pEnd = DIGIT_PAIRS[i + 1];
+			*--pEnd = DIGIT_PAIRS[i];
+		}
+		else *--pEnd = static_cast<char>('0' + value);
+		return pEnd;
+	}
+
+	inline void copyDecimal(const char* pBegin, const char* pEnd, char* result, std::size_t& size)
+		/// Copies the formatted number and a terminating zero to
+		/// result, which has room for size characters.
+	{
+		const std::size_t n = pEnd - pBegin;
+		if (n >= size) throw RangeException();
+		std::memcpy(result, pBegin, n);
+		result[n] = '\0';
+		size = n;
+	}
+
 } // namespace Impl
 
 
@@ -398,6 +506,18 @@ bool intToStr(T value,
 		return false;
 	}
 
+	if (base == 10 && thSep == 0 && width <= 0)
+	{
+		char digits[POCO_MAX_INT_STRING_LEN];
+		char* pEnd = digits + sizeof(digits);
+		const bool negative = isNegative(value);
+		const uintmax_t magnitude = negative ? 0 - static_cast<uintmax_t>(value) : static_cast<uintmax_t>(value);
+		char* pBegin = Impl::formatDecimal(magnitude, pEnd);
+		if (negative) *--pBegin = '-';
+		Impl::copyDecimal(pBegin, pEnd, result, size);
+		return true;
+	}
+
 	Impl::Ptr ptr(result, size);
 	int thCount = 0;
 	T tmpVal;
@@ -476,6 +596,15 @@ bool uIntToStr(T value,
 		return false;
 	}
 
+	if (base == 10 && thSep == 0 && width <= 0)
+	{
+		char digits[POCO_MAX_INT_STRING_LEN];
+		char* pEnd = digits + sizeof(digits);
+		char* pBegin = Impl::formatDecimal(static_cast<uintmax_t>(value), pEnd);
+		Impl::copyDecimal(pBegin, pEnd, result, size);
+		return true;
+	}
+
 	Impl::Ptr ptr(result, size);
 	int thCount = 0;
 	T tmpVal;
@@ -680,6 +809,22 @@ Foundation_API bool strToDouble(const std::string& str, double& result,
 	/// Returns true if successful, false otherwise.
 
 
+Foundation_API bool strToDouble(const char* str, std::size_t length, double& result,
+	char decSep = '.', char thSep = ',',
+	const char* inf = POCO_FLT_INF, const char* nan = POCO_FLT_NAN);
+	/// Converts the given number of characters into double-precision floating point number.
+	/// The conversion result is assigned to the result parameter.
+	/// If decimal separator and/or thousand separator are different from defaults, they should be
+	/// supplied to ensure proper conversion.
+	///
+	/// Numbers with up to 19 significant digits whose value can be computed
+	/// exactly with a single floating-point multiplication or division
+	/// (which covers most numbers found in practice) are converted without
+	/// copying the string.
+	///
+	/// Returns true if successful, false otherwise.
+
+
 } // namespace Lucid
 
 
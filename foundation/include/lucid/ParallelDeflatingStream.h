@@ -0,0 +1,186 @@
+//
+// ParallelDeflatingStream.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  ZLibStream
+//
+// Definition of the ParallelDeflatingStream class.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ParallelDeflatingStream_INCLUDED
+#define Foundation_ParallelDeflatingStream_INCLUDED
+
+
+#include "lucid/Foundation.h"
+#include "lucid/DeflatingStream.h"
+#include "lucid/BufferedStreamBuf.h"
+#include "lucid/Checksum.h"
+#include "lucid/SharedPtr.h"
+#include <ostream>
+#include <deque>
+
+
+namespace Lucid {
+
+
+class ThreadPool;
+
+
+class Foundation_API ParallelDeflatingStreamBuf: public BufferedStreamBuf
+	/// This is the streambuf class used by ParallelDeflatingOutputStream.
+	///
+	/// The data written to the stream is split into blocks of a
+	/// fixed size, which are compressed independently by the threads
+	/// of a ThreadPool. Each block is compressed with the last 32 KB
+	/// of the data preceding it as preset dictionary, so the
+	/// compression ratio is almost the same as with a single
+	/// DeflatingStreamBuf. The compressed blocks are written to the
+	/// output stream in order, forming a single zlib or gzip stream
+	/// that can be decompressed with any zlib or gzip implementation,
+	/// including InflatingStreamBuf. The checksum of the stream is
+	/// combined from the checksums of the blocks.
+	///
+	/// If no thread is available in the pool, a block is compressed
+	/// on the calling thread.
+	///
+	/// Flushing the stream compresses and writes all data passed so far,
+	/// and waits until this has been done. As this also ends the
+	/// current block, the stream should not be flushed more often than
+	/// necessary.
+	///
+	/// close() must always be called to ensure proper completion
+	/// of compression.
+{
+public:
+	enum
+	{
+		DEFAULT_BLOCK_SIZE = 128*1024
+	};
+
+	ParallelDeflatingStreamBuf(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, std::size_t blockSize, ThreadPool& pool, int maxPendingBlocks);
+		/// Creates a ParallelDeflatingStreamBuf for compressing data passed
+		/// through and forwarding it to the given output stream.
+		///
+		/// The data is compressed in blocks of blockSize bytes, using the
+		/// threads of the given pool. At most maxPendingBlocks blocks are
+		/// compressed, or waiting to be written, at any time. If
+		/// maxPendingBlocks is 0, twice the number of processors is used.
+
+	~ParallelDeflatingStreamBuf();
+		/// Destroys the ParallelDeflatingStreamBuf.
+
+	int close();
+		/// Finishes up the stream.
+		///
+		/// Must be called to write the final block and the trailer.
+
+protected:
+	int writeToDevice(const char* buffer, std::streamsize length);
+	int sync();
+
+private:
+	enum
+	{
+		DICTIONARY_SIZE = 32768
+	};
+
+	class Block;
+
+	void writeHeader();
+	void writeTrailer();
+	void startBlock(const char* buffer, std::size_t length, bool last);
+	void writeBlocks(std::size_t maxPending);
+
+	ParallelDeflatingStreamBuf(const ParallelDeflatingStreamBuf&);
+	ParallelDeflatingStreamBuf& operator = (const ParallelDeflatingStreamBuf&);
+
+	std::ostream*      _pOstr;
+	ThreadPool&        _pool;
+	DeflatingStreamBuf::StreamType _type;
+	int                _level;
+	std::size_t        _maxPendingBlocks;
+	std::deque<SharedPtr<Block>> _blocks;
+	std::string        _dictionary;
+	Checksum::Type     _checksumType;
+	Lucid::UInt32      _checksum;
+	Lucid::UInt64      _size;
+	bool               _headerWritten;
+};
+
+
+class Foundation_API ParallelDeflatingIOS: public virtual std::ios
+	/// The base class for ParallelDeflatingOutputStream.
+	///
+	/// This class is needed to ensure the correct initialization
+	/// order of the stream buffer and base classes.
+{
+public:
+	ParallelDeflatingIOS(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, std::size_t blockSize, ThreadPool& pool, int maxPendingBlocks);
+		/// Creates a ParallelDeflatingIOS for compressing data passed
+		/// through and forwarding it to the given output stream.
+
+	~ParallelDeflatingIOS();
+		/// Destroys the ParallelDeflatingIOS.
+
+	ParallelDeflatingStreamBuf* rdbuf();
+		/// Returns a pointer to the underlying stream buffer.
+
+protected:
+	ParallelDeflatingStreamBuf _buf;
+};
+
+
+class Foundation_API ParallelDeflatingOutputStream: public std::ostream, public ParallelDeflatingIOS
+	/// This stream compresses all data passing through it
+	/// using zlib's deflate algorithm, on multiple threads.
+	///
+	/// See ParallelDeflatingStreamBuf for how the data is
+	/// compressed. After all data has been written to the
+	/// stream, close() must be called to ensure completion
+	/// of compression.
+	///
+	/// Example:
+	///     std::ofstream ostr("data.gz", std::ios::binary);
+	///     ParallelDeflatingOutputStream deflater(ostr, DeflatingStreamBuf::STREAM_GZIP);
+	///     StreamCopier::copyStream(istr, deflater);
+	///     deflater.close();
+	///     ostr.close();
+{
+public:
+	ParallelDeflatingOutputStream(std::ostream& ostr, DeflatingStreamBuf::StreamType type = DeflatingStreamBuf::STREAM_GZIP, int level = Z_DEFAULT_COMPRESSION, std::size_t blockSize = ParallelDeflatingStreamBuf::DEFAULT_BLOCK_SIZE);
+		/// Creates a ParallelDeflatingOutputStream for compressing data
+		/// passed through and forwarding it to the given output stream.
+		///
+		/// The blocks are compressed by the threads of the default
+		/// ThreadPool.
+
+	ParallelDeflatingOutputStream(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, std::size_t blockSize, ThreadPool& pool, int maxPendingBlocks = 0);
+		/// Creates a ParallelDeflatingOutputStream for compressing data
+		/// passed through and forwarding it to the given output stream.
+		///
+		/// See ParallelDeflatingStreamBuf for a description of
+		/// the parameters.
+
+	~ParallelDeflatingOutputStream();
+		/// Destroys the ParallelDeflatingOutputStream.
+
+	int close();
+		/// Finishes up the stream.
+		///
+		/// Must be called to ensure completion of compression.
+
+protected:
+	virtual int sync();
+};
+
+
+} // namespace Lucid
+
+
+#endif // Foundation_ParallelDeflatingStream_INCLUDED
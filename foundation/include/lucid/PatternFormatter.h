@@ -74,6 +74,10 @@ class Foundation_API PatternFormatter: public Formatter
 	///   * %v[width] - the message source (%s) but text length is padded/cropped to 'width'
 	///   * %[name] - the value of the message parameter with the given name
 	///   * %% - percent sign
+	///
+	/// The text produced by the date and time fields at the start of
+	/// a pattern (e.g., "%Y-%m-%d %H:%M:%S ") is cached per thread and
+	/// only formatted again when the second changes.
 
 {
 public:
@@ -144,6 +148,9 @@ private:
 	void parsePriorityNames();
 
 	std::vector<PatternAction> _patternActions;
+	std::size_t _prefixActions;   /// number of leading actions that only change once per second
+	bool _prefixLocalTime;        /// true if the leading actions include %L
+	UInt64 _patternId;            /// identifies the pattern in the per-thread prefix cache
 	bool _localTime;
 	std::string _pattern;
 	std::string _priorityNames;
@@ -34,6 +34,12 @@ namespace Lucid {
 class Foundation_API SHA2Engine: public DigestEngine
 	/// This class implements the SHA-2 message digest algorithm.
 	/// (FIPS 180-4, see http://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.180-4.pdf)
+	///
+	/// On x86 CPUs with the SHA extensions, SHA-224 and SHA-256
+	/// use the SHA-NI instructions, selected at runtime.
+	/// digestBatch() computes the digests of many independent
+	/// messages and, on CPUs with AVX2 but without SHA-NI,
+	/// hashes eight SHA-224 or SHA-256 messages at once.
 {
 public:
 	enum ALGORITHM
@@ -51,6 +57,14 @@ public:
 	void reset();
 	const DigestEngine::Digest& digest();
 
+	static void digestBatch(ALGORITHM algorithm, std::size_t count, const void* const data[], const std::size_t lengths[], DigestEngine::Digest digests[]);
+		/// Computes the digests of count independent messages, where
+		/// message i has lengths[i] bytes starting at data[i], and
+		/// stores the digest of message i in digests[i].
+		///
+		/// The result is the same as hashing each message
+		/// with a separate SHA2Engine.
+
 protected:
 	void updateImpl(const void* data, std::size_t length);
 
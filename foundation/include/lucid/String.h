@@ -20,8 +20,10 @@
 
 #include "lucid/Foundation.h"
 #include "lucid/Ascii.h"
+#include "lucid/StringView.h"
 #include <cstring>
 #include <algorithm>
+#include <stdexcept>
 
 
 namespace Lucid {
@@ -112,6 +114,51 @@ S& trimInPlace(S& str)
 }
 
 
+inline StringView trimLeft(const StringView& str)
+	/// Returns a view of str without leading whitespace.
+{
+	StringView::const_iterator it  = str.begin();
+	StringView::const_iterator end = str.end();
+
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	return StringView(it, end - it);
+}
+
+
+inline StringView trimRight(const StringView& str)
+	/// Returns a view of str without trailing whitespace.
+{
+	StringView::const_iterator begin = str.begin();
+	StringView::const_iterator it    = str.end();
+
+	while (it != begin && Ascii::isSpace(*(it - 1))) --it;
+	return StringView(begin, it - begin);
+}
+
+
+inline StringView trim(const StringView& str)
+	/// Returns a view of str without leading and
+	/// trailing whitespace.
+{
+	return trimRight(trimLeft(str));
+}
+
+
+Foundation_API void toUpperInPlace(char* str, std::size_t length);
+	/// Replaces the length characters starting at str
+	/// with their upper-case counterparts.
+
+Foundation_API void toLowerInPlace(char* str, std::size_t length);
+	/// Replaces the length characters starting at str
+	/// with their lower-case counterparts.
+
+Foundation_API std::string toUpper(const StringView& str);
+	/// Returns a copy of str containing all upper-case characters.
+
+Foundation_API std::string toLower(const StringView& str);
+	/// Returns a copy of str containing all lower-case characters.
+
+
 template <class S>
 S toUpper(const S& str)
 	/// Returns a copy of str containing all upper-case characters.
@@ -164,6 +211,46 @@ S& toLowerInPlace(S& str)
 }
 
 
+template <>
+inline std::string& toUpperInPlace(std::string& str)
+{
+	if (!str.empty()) toUpperInPlace(&str[0], str.size());
+	return str;
+}
+
+
+template <>
+inline std::string toUpper(const std::string& str)
+{
+	std::string result(str);
+	toUpperInPlace(result);
+	return result;
+}
+
+
+template <>
+inline std::string& toLowerInPlace(std::string& str)
+{
+	if (!str.empty()) toLowerInPlace(&str[0], str.size());
+	return str;
+}
+
+
+template <>
+inline std::string toLower(const std::string& str)
+{
+	std::string result(str);
+	toLowerInPlace(result);
+	return result;
+}
+
+
+Foundation_API int icompare(const StringView& str1, const StringView& str2);
+	/// Case-insensitive comparison of two character sequences,
+	/// with the same result as the std::string version, but
+	/// comparing 16 characters at a time where possible.
+
+
 #if !defined(POCO_NO_TEMPLATE_ICOMPARE)
 
 
@@ -225,6 +312,13 @@ int icompare(const S& str1, const S& str2)
 }
 
 
+template <>
+inline int icompare(const std::string& str1, const std::string& str2)
+{
+	return icompare(StringView(str1), StringView(str2));
+}
+
+
 template <class S>
 int icompare(const S& str1, typename S::size_type n1, const S& str2, typename S::size_type n2)
 {
@@ -360,6 +454,23 @@ S translate(const S& str, const S& from, const S& to)
 	typename S::const_iterator it  = str.begin();
 	typename S::const_iterator end = str.end();
 	typename S::size_type toSize = to.size();
+	if (sizeof(typename S::value_type) == 1)
+	{
+		// Single-byte characters: look up each character in a table
+		// instead of searching from for it.
+		int table[256];
+		for (int i = 0; i < 256; i++) table[i] = i;
+		for (typename S::size_type i = from.size(); i-- > 0;)
+		{
+			table[static_cast<unsigned char>(from[i])] = i < toSize ? static_cast<unsigned char>(to[i]) : -1;
+		}
+		for (; it != end; ++it)
+		{
+			int c = table[static_cast<unsigned char>(*it)];
+			if (c >= 0) result += static_cast<typename S::value_type>(c);
+		}
+		return result;
+	}
 	while (it != end)
 	{
 		typename S::size_type pos = from.find(*it);
@@ -418,23 +529,41 @@ S translateInPlace(S& str, const typename S::value_type* from, const typename S:
 
 
 template <class S>
-S& replaceInPlace(S& str, const S& from, const S& to, typename S::size_type start = 0)
+S& replaceInPlace(S& str, const typename S::value_type* from, typename S::size_type fromLen, const typename S::value_type* to, typename S::size_type toLen, typename S::size_type start = 0)
+	/// Replaces all occurrences of the fromLen characters at from
+	/// (which must not be empty) in str with the toLen characters at to,
+	/// starting at position start.
+	///
+	/// The string is only modified if there is an occurrence. If the
+	/// replacement has the same length, it is done in place; otherwise
+	/// the result is built in a single pass.
 {
-	poco_assert (from.size() > 0);
+	poco_assert (fromLen > 0);
 
-	S result;
-	typename S::size_type pos = 0;
-	result.append(str, 0, start);
-	do
+	if (start > str.size()) throw std::out_of_range("replaceInPlace: start out of range");
+	typename S::size_type pos = str.find(from, start, fromLen);
+	if (pos == S::npos) return str;
+
+	if (fromLen == toLen)
 	{
-		pos = str.find(from, start);
-		if (pos != S::npos)
+		do
 		{
-			result.append(str, start, pos - start);
-			result.append(to);
-			start = pos + from.length();
+			std::copy(to, to + toLen, str.begin() + pos);
+			pos = str.find(from, pos + fromLen, fromLen);
 		}
-		else result.append(str, start, str.size() - start);
+		while (pos != S::npos);
+		return str;
+	}
+
+	S result;
+	result.reserve(str.size() + (toLen > fromLen ? 4*(toLen - fromLen) : 0));
+	result.append(str, 0, pos);
+	do
+	{
+		result.append(to, toLen);
+		start = pos + fromLen;
+		pos = str.find(from, start, fromLen);
+		result.append(str, start, (pos == S::npos ? str.size() : pos) - start);
 	}
 	while (pos != S::npos);
 	str.swap(result);
@@ -442,47 +571,33 @@ S& replaceInPlace(S& str, const S& from, const S& to, typename S::size_type star
 }
 
 
+template <class S>
+S& replaceInPlace(S& str, const S& from, const S& to, typename S::size_type start = 0)
+{
+	poco_assert (from.size() > 0);
+
+	return replaceInPlace(str, from.data(), from.size(), to.data(), to.size(), start);
+}
+
+
 template <class S>
 S& replaceInPlace(S& str, const typename S::value_type* from, const typename S::value_type* to, typename S::size_type start = 0)
 {
 	poco_assert (*from);
 
-	S result;
-	typename S::size_type pos = 0;
-	typename S::size_type fromLen = std::strlen(from);
-	result.append(str, 0, start);
-	do
-	{
-		pos = str.find(from, start);
-		if (pos != S::npos)
-		{
-			result.append(str, start, pos - start);
-			result.append(to);
-			start = pos + fromLen;
-		}
-		else result.append(str, start, str.size() - start);
-	}
-	while (pos != S::npos);
-	str.swap(result);
-	return str;
+	return replaceInPlace(str, from, std::char_traits<typename S::value_type>::length(from), to, std::char_traits<typename S::value_type>::length(to), start);
 }
 
 
 template <class S>
 S& replaceInPlace(S& str, const typename S::value_type from, const typename S::value_type to = 0, typename S::size_type start = 0)
 {
-	if (from == to) return str;
+	if (from == to || start >= str.size()) return str;
 
-	typename S::size_type pos = 0;
-	do
-	{
-		pos = str.find(from, start);
-		if (pos != S::npos)
-		{
-			if (to) str[pos] = to;
-			else str.erase(pos, 1);
-		}
-	} while (pos != S::npos);
+	if (to)
+		std::replace(str.begin() + start, str.end(), from, to);
+	else
+		str.erase(std::remove(str.begin() + start, str.end(), from), str.end());
 
 	return str;
 }
@@ -31,6 +31,9 @@ class Foundation_API StringTokenizer
 	/// A simple tokenizer that splits a string into
 	/// tokens, which are separated by separator characters.
 	/// An iterator is used to iterate over all tokens.
+	///
+	/// To iterate over the tokens without copying them,
+	/// use StringViewTokenizer.
 {
 public:
 	enum Options
@@ -83,8 +86,6 @@ public:
 		/// Returns the number of tokens equal to the specified token.
 
 private:
-	void trim(std::string& token);
-
 	TokenVec _tokens;
 };
 
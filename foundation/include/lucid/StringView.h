@@ -0,0 +1,265 @@
+//
+// StringView.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringView
+//
+// Definition of the StringView class.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_StringView_INCLUDED
+#define Foundation_StringView_INCLUDED
+
+
+#include "lucid/Foundation.h"
+#include "lucid/Exception.h"
+#include <string>
+#include <cstring>
+#include <ostream>
+
+
+namespace Lucid {
+
+
+class StringView
+	/// A non-owning, read-only reference to a contiguous
+	/// sequence of characters, similar to C++17's std::string_view.
+	///
+	/// A StringView never owns the characters it refers to.
+	/// The owner of the characters must make sure they outlive
+	/// the StringView. The referenced characters are not
+	/// necessarily zero-terminated.
+{
+public:
+	using size_type = std::size_t;
+	using const_iterator = const char*;
+
+	static const size_type npos = size_type(-1);
+
+	StringView();
+		/// Creates an empty StringView.
+
+	StringView(const char* str);
+		/// Creates a StringView referring to the given
+		/// zero-terminated string.
+
+	StringView(const char* data, size_type size);
+		/// Creates a StringView referring to size characters
+		/// starting at data.
+
+	StringView(const std::string& str);
+		/// Creates a StringView referring to the contents of str.
+
+	const char* data() const;
+		/// Returns a pointer to the first character.
+
+	size_type size() const;
+		/// Returns the number of characters.
+
+	size_type length() const;
+		/// Returns the number of characters.
+
+	bool empty() const;
+		/// Returns true iff the view has no characters.
+
+	const_iterator begin() const;
+	const_iterator end() const;
+
+	char operator [] (size_type pos) const;
+		/// Returns the character at the given position.
+		/// No bounds checking is performed.
+
+	void removePrefix(size_type n);
+		/// Moves the start of the view forward by n characters.
+
+	void removeSuffix(size_type n);
+		/// Moves the end of the view backward by n characters.
+
+	StringView substr(size_type pos, size_type n = npos) const;
+		/// Returns a view of at most n characters, starting
+		/// at pos. Throws a RangeException if pos > size().
+
+	size_type find(char c, size_type pos = 0) const;
+		/// Returns the position of the first occurrence of c
+		/// at or after pos, or npos if c is not found.
+
+	int compare(const StringView& other) const;
+		/// Compares the view with other lexicographically.
+		/// Returns a negative value, zero, or a positive value
+		/// if this view is less, equal, or greater than other.
+
+	bool startsWith(const StringView& prefix) const;
+		/// Returns true iff the view starts with prefix.
+
+	std::string toString() const;
+		/// Returns a copy of the referenced characters.
+
+private:
+	const char* _data;
+	size_type _size;
+};
+
+
+//
+// inlines
+//
+inline StringView::StringView():
+	_data(""),
+	_size(0)
+{
+}
+
+
+inline StringView::StringView(const char* str):
+	_data(str),
+	_size(std::strlen(str))
+{
+}
+
+
+inline StringView::StringView(const char* data, size_type size):
+	_data(data),
+	_size(size)
+{
+}
+
+
+inline StringView::StringView(const std::string& str):
+	_data(str.data()),
+	_size(str.size())
+{
+}
+
+
+inline const char* StringView::data() const
+{
+	return _data;
+}
+
+
+inline StringView::size_type StringView::size() const
+{
+	return _size;
+}
+
+
+inline StringView::size_type StringView::length() const
+{
+	return _size;
+}
+
+
+inline bool StringView::empty() const
+{
+	return _size == 0;
+}
+
+
+inline StringView::const_iterator StringView::begin() const
+{
+	return _data;
+}
+
+
+inline StringView::const_iterator StringView::end() const
+{
+	return _data + _size;
+}
+
+
+inline char StringView::operator [] (size_type pos) const
+{
+	return _data[pos];
+}
+
+
+inline void StringView::removePrefix(size_type n)
+{
+	poco_assert_dbg (n <= _size);
+
+	_data += n;
+	_size -= n;
+}
+
+
+inline void StringView::removeSuffix(size_type n)
+{
+	poco_assert_dbg (n <= _size);
+
+	_size -= n;
+}
+
+
+inline StringView StringView::substr(size_type pos, size_type n) const
+{
+	if (pos > _size) throw RangeException("StringView::substr");
+
+	size_type rest = _size - pos;
+	return StringView(_data + pos, n < rest ? n : rest);
+}
+
+
+inline StringView::size_type StringView::find(char c, size_type pos) const
+{
+	if (pos >= _size) return npos;
+
+	const void* p = std::memchr(_data + pos, c, _size - pos);
+	return p ? static_cast<const char*>(p) - _data : npos;
+}
+
+
+inline int StringView::compare(const StringView& other) const
+{
+	size_type n = _size < other._size ? _size : other._size;
+	int rc = n ? std::memcmp(_data, other._data, n) : 0;
+	if (rc != 0) return rc;
+	return _size < other._size ? -1 : (_size > other._size ? 1 : 0);
+}
+
+
+inline bool StringView::startsWith(const StringView& prefix) const
+{
+	return prefix._size <= _size && (prefix._size == 0 || std::memcmp(_data, prefix._data, prefix._size) == 0);
+}
+
+
+inline std::string StringView::toString() const
+{
+	return std::string(_data, _size);
+}
+
+
+inline bool operator == (const StringView& a, const StringView& b)
+{
+	return a.size() == b.size() && (a.size() == 0 || std::memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+
+inline bool operator != (const StringView& a, const StringView& b)
+{
+	return !(a == b);
+}
+
+
+inline bool operator < (const StringView& a, const StringView& b)
+{
+	return a.compare(b) < 0;
+}
+
+
+inline std::ostream& operator << (std::ostream& ostr, const StringView& view)
+{
+	return ostr.write(view.data(), static_cast<std::streamsize>(view.size()));
+}
+
+
+} // namespace Lucid
+
+
+#endif // Foundation_StringView_INCLUDED
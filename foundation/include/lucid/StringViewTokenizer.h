@@ -0,0 +1,144 @@
+//
+// StringViewTokenizer.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringTokenizer
+//
+// Definition of the StringViewTokenizer class.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_StringViewTokenizer_INCLUDED
+#define Foundation_StringViewTokenizer_INCLUDED
+
+
+#include "lucid/Foundation.h"
+#include "lucid/StringTokenizer.h"
+#include "lucid/StringView.h"
+#include "lucid/String.h"
+#include <cstring>
+
+
+namespace Lucid {
+
+
+class StringViewTokenizer
+	/// A tokenizer that splits a string into tokens, which are
+	/// separated by separator characters, without copying them.
+	///
+	/// Unlike StringTokenizer, which stores all tokens in a vector
+	/// of strings, StringViewTokenizer finds the tokens one at a
+	/// time and returns them as views into the original string,
+	/// which must outlive the tokenizer and the returned views.
+	///
+	/// The same options as for StringTokenizer are supported,
+	/// and the tokens are the same:
+	///
+	///     StringViewTokenizer tok(header, ";", StringTokenizer::TOK_TRIM);
+	///     StringView token;
+	///     while (tok.next(token))
+	///     {
+	///         ...
+	///     }
+{
+public:
+	StringViewTokenizer(const StringView& str, const StringView& separators, int options = 0);
+		/// Creates the StringViewTokenizer for the given string. The
+		/// tokens are expected to be separated by one of the separator
+		/// characters given in separators.
+		/// Additionally, options can be specified:
+		///   * StringTokenizer::TOK_IGNORE_EMPTY: empty tokens are ignored
+		///   * StringTokenizer::TOK_TRIM: trailing and leading whitespace is removed from tokens.
+
+	bool next(StringView& token);
+		/// Stores the next token in token and returns true,
+		/// or returns false if there are no more tokens.
+
+	void reset();
+		/// Restarts the tokenizer at the beginning of the string.
+
+private:
+	const char* findSeparator(const char* it, const char* end) const;
+
+	StringView _str;
+	std::size_t _pos;
+	bool _done;
+	bool _trim;
+	bool _ignoreEmpty;
+	int _separator;
+		/// The separator, if there is only one, or -1.
+	unsigned char _separators[256];
+};
+
+
+//
+// inlines
+//
+inline StringViewTokenizer::StringViewTokenizer(const StringView& str, const StringView& separators, int options):
+	_str(str),
+	_pos(0),
+	_done(str.empty()),
+	_trim((options & StringTokenizer::TOK_TRIM) != 0),
+	_ignoreEmpty((options & StringTokenizer::TOK_IGNORE_EMPTY) != 0),
+	_separator(separators.size() == 1 ? static_cast<unsigned char>(separators[0]) : -1)
+{
+	std::memset(_separators, 0, sizeof(_separators));
+	for (StringView::const_iterator it = separators.begin(); it != separators.end(); ++it)
+	{
+		_separators[static_cast<unsigned char>(*it)] = 1;
+	}
+}
+
+
+inline const char* StringViewTokenizer::findSeparator(const char* it, const char* end) const
+{
+	if (_separator >= 0)
+	{
+		const void* p = std::memchr(it, _separator, end - it);
+		return p ? static_cast<const char*>(p) : end;
+	}
+	while (it != end && !_separators[static_cast<unsigned char>(*it)]) ++it;
+	return it;
+}
+
+
+inline bool StringViewTokenizer::next(StringView& token)
+{
+	while (!_done)
+	{
+		const char* begin = _str.data() + _pos;
+		const char* end = _str.data() + _str.size();
+		const char* sep = findSeparator(begin, end);
+		if (sep == end)
+			_done = true;
+		else
+			_pos = sep + 1 - _str.data();
+
+		StringView result(begin, sep - begin);
+		if (_trim) result = trim(result);
+		if (!result.empty() || !_ignoreEmpty)
+		{
+			token = result;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+inline void StringViewTokenizer::reset()
+{
+	_pos = 0;
+	_done = _str.empty();
+}
+
+
+} // namespace Lucid
+
+
+#endif // Foundation_StringViewTokenizer_INCLUDED
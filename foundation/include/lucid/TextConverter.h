@@ -30,6 +30,11 @@ class TextEncoding;
 class Foundation_API TextConverter
 	/// A TextConverter converts strings from one encoding
 	/// into another.
+	///
+	/// If no transform function is given, runs of ASCII characters
+	/// are copied in bulk if both encodings map them to themselves,
+	/// and well-formed UTF-8 is copied unchanged if both encodings
+	/// are UTF-8.
 {
 public:
 	typedef int (*Transform)(int);
@@ -84,6 +89,9 @@ private:
 	const TextEncoding& _inEncoding;
 	const TextEncoding& _outEncoding;
 	int                 _defaultChar;
+	bool                _asciiCompatible;
+	bool                _utf8In;
+	bool                _utf8Out;
 };
 
 
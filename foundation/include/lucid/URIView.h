@@ -0,0 +1,291 @@
+//
+// URIView.h
+//
+// Library: Foundation
+// Package: URI
+// Module:  URIView
+//
+// Definition of the URIView class.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_URIView_INCLUDED
+#define Foundation_URIView_INCLUDED
+
+
+#include "lucid/Foundation.h"
+#include "lucid/StringView.h"
+#include "lucid/URI.h"
+
+
+namespace Lucid {
+
+
+class Foundation_API URIView
+	/// A read-only, non-owning view of a Uniform Resource Identifier,
+	/// as specified in RFC 3986.
+	///
+	/// URIView splits an URI into its parts the same way URI does,
+	/// but without copying them. All parts are views into the
+	/// string the URIView was created from, which must outlive the
+	/// URIView and the views obtained from it.
+	///
+	/// Unlike URI, URIView does not normalize the parts it returns:
+	/// the scheme and host are not converted to lower case, and
+	/// the path, query and fragment are returned in their raw,
+	/// usually percent-encoded form. The decoded path and fragment
+	/// are only computed on request, and query parameters can be
+	/// iterated without allocating memory:
+	///
+	///     URIView uri(request.getURI());
+	///     URIView::QueryParameterTokenizer params(uri.getRawQuery());
+	///     StringView name;
+	///     StringView value;
+	///     while (params.next(name, value))
+	///     {
+	///         ...
+	///     }
+	///
+	/// To split the raw path into segments, use a StringViewTokenizer
+	/// with '/' as separator and StringTokenizer::TOK_IGNORE_EMPTY.
+	///
+	/// As percent-encoded characters are only decoded on request,
+	/// an invalid percent-encoding is only reported (by a
+	/// URISyntaxException) when the respective part is decoded.
+{
+public:
+	class Foundation_API QueryParameterTokenizer
+		/// Splits a raw query string into name-value pairs,
+		/// without decoding or copying them.
+		///
+		/// Parameters are separated by '&', and name and value
+		/// are separated by the first '='. Use decodeQueryParameter()
+		/// to decode names and values.
+	{
+	public:
+		explicit QueryParameterTokenizer(const StringView& query);
+			/// Creates the QueryParameterTokenizer for the given
+			/// raw query string.
+
+		bool next(StringView& name, StringView& value);
+			/// Stores the raw name and value of the next parameter
+			/// in name and value and returns true, or returns false
+			/// if there are no more parameters.
+			///
+			/// If the parameter has no value, value is empty.
+
+		void reset();
+			/// Restarts the tokenizer at the first parameter.
+
+	private:
+		StringView _query;
+		std::size_t _pos;
+	};
+
+	URIView();
+		/// Creates an empty URIView.
+
+	explicit URIView(const StringView& uri);
+		/// Parses an URI from the given string. Throws a
+		/// URISyntaxException if the uri is not valid.
+		///
+		/// The string must outlive the URIView.
+
+	URIView& operator = (const StringView& uri);
+		/// Parses and assigns an URI from the given string. Throws a
+		/// URISyntaxException if the uri is not valid.
+
+	void clear();
+		/// Clears all parts of the URIView.
+
+	const StringView& toStringView() const;
+		/// Returns the string the URIView has been created from.
+
+	URI toURI() const;
+		/// Returns an URI with the same parts as the URIView.
+
+	const StringView& getScheme() const;
+		/// Returns the scheme part of the URI, in the
+		/// original case.
+
+	const StringView& getAuthority() const;
+		/// Returns the raw authority part (user-info, host and port)
+		/// of the URI.
+
+	const StringView& getUserInfo() const;
+		/// Returns the user-info part of the URI.
+
+	const StringView& getHost() const;
+		/// Returns the host part of the URI, in the original case
+		/// and without the brackets of an IPv6 address.
+
+	unsigned short getPort() const;
+		/// Returns the port number part of the URI.
+		///
+		/// If no port number (0) has been specified, the
+		/// well-known port number (e.g., 80 for http) for
+		/// the given scheme is returned if it is known.
+		/// Otherwise, 0 is returned.
+
+	unsigned short getSpecifiedPort() const;
+		/// Returns the port number part of the URI.
+		///
+		/// If no explicit port number has been specified,
+		/// returns 0.
+
+	const StringView& getRawPath() const;
+		/// Returns the raw, usually percent-encoded,
+		/// path part of the URI.
+
+	std::string getPath() const;
+		/// Returns the decoded path part of the URI.
+
+	const StringView& getRawQuery() const;
+		/// Returns the raw, usually percent-encoded,
+		/// query part of the URI.
+
+	bool getQueryParameter(const StringView& name, std::string& value) const;
+		/// Searches the query for the first parameter with the
+		/// given (decoded) name. If found, stores the decoded value
+		/// of the parameter in value and returns true. Otherwise
+		/// returns false and leaves value unchanged.
+
+	const StringView& getRawFragment() const;
+		/// Returns the raw, usually percent-encoded,
+		/// fragment part of the URI.
+
+	std::string getFragment() const;
+		/// Returns the decoded fragment part of the URI.
+
+	const StringView& getPathEtc() const;
+		/// Returns the raw path, query and fragment
+		/// parts of the URI.
+
+	bool isRelative() const;
+		/// Returns true if the URI is a relative reference, false otherwise.
+
+	bool empty() const;
+		/// Returns true if the URI is empty, false otherwise.
+
+	static void decode(const StringView& str, std::string& decodedStr, bool plusAsSpace = false);
+		/// URI-decodes the given string by replacing percent-encoded
+		/// characters with the actual character. The decoded string
+		/// is appended to decodedStr.
+		///
+		/// Behaves like URI::decode().
+
+	static void decodeQueryParameter(const StringView& str, std::string& decodedStr);
+		/// URI-decodes the given raw query parameter name or value
+		/// and appends it to decodedStr. Plus signs are decoded as
+		/// spaces, as done by URI::getQueryParameters().
+
+protected:
+	void parse(const StringView& uri);
+	void parseAuthority(const char*& it, const char* end);
+	void parseHostAndPort(const char* it, const char* end);
+	void parsePathEtc(const char*& it, const char* end);
+
+private:
+	StringView     _uri;
+	StringView     _scheme;
+	StringView     _authority;
+	StringView     _userInfo;
+	StringView     _host;
+	unsigned short _port;
+	StringView     _path;
+	StringView     _query;
+	StringView     _fragment;
+	StringView     _pathEtc;
+};
+
+
+//
+// inlines
+//
+inline URIView::QueryParameterTokenizer::QueryParameterTokenizer(const StringView& query):
+	_query(query),
+	_pos(0)
+{
+}
+
+
+inline void URIView::QueryParameterTokenizer::reset()
+{
+	_pos = 0;
+}
+
+
+inline const StringView& URIView::toStringView() const
+{
+	return _uri;
+}
+
+
+inline const StringView& URIView::getScheme() const
+{
+	return _scheme;
+}
+
+
+inline const StringView& URIView::getAuthority() const
+{
+	return _authority;
+}
+
+
+inline const StringView& URIView::getUserInfo() const
+{
+	return _userInfo;
+}
+
+
+inline const StringView& URIView::getHost() const
+{
+	return _host;
+}
+
+
+inline unsigned short URIView::getSpecifiedPort() const
+{
+	return _port;
+}
+
+
+inline const StringView& URIView::getRawPath() const
+{
+	return _path;
+}
+
+
+inline const StringView& URIView::getRawQuery() const
+{
+	return _query;
+}
+
+
+inline const StringView& URIView::getRawFragment() const
+{
+	return _fragment;
+}
+
+
+inline const StringView& URIView::getPathEtc() const
+{
+	return _pathEtc;
+}
+
+
+inline bool URIView::isRelative() const
+{
+	return _scheme.empty();
+}
+
+
+} // namespace Lucid
+
+
+#endif // Foundation_URIView_INCLUDED
@@ -36,6 +36,9 @@ struct Foundation_API UTF8
 	///
 	/// removeBOM() removes the UTF-8 Byte Order Mark sequence (0xEF, 0xBB, 0xBF)
 	/// from the beginning of the given string, if it's there.
+	///
+	/// isValid() and asciiPrefix() check whole buffers at once. On x86 CPUs
+	/// with SSSE3, a vectorized implementation is selected at runtime.
 {
 	static int icompare(const std::string& str, std::string::size_type pos, std::string::size_type n, std::string::const_iterator it2, std::string::const_iterator end2);
 	static int icompare(const std::string& str1, const std::string& str2);
@@ -57,6 +60,19 @@ struct Foundation_API UTF8
 		/// Remove the UTF-8 Byte Order Mark sequence (0xEF, 0xBB, 0xBF)
 		/// from the beginning of the string, if it's there.
 
+	static bool isValid(const char* data, std::size_t length);
+		/// Returns true if the given buffer contains well-formed UTF-8,
+		/// as defined in RFC 3629. Overlong sequences, surrogates and
+		/// code points above U+10FFFF are rejected, exactly as
+		/// UTF8Encoding::isLegal() does.
+
+	static bool isValid(const std::string& str);
+		/// Returns true if the given string contains well-formed UTF-8.
+
+	static std::size_t asciiPrefix(const char* data, std::size_t length);
+		/// Returns the length of the longest prefix of the given
+		/// buffer that consists of ASCII characters (0x00 - 0x7F) only.
+
 	static std::string escape(const std::string& s, bool strictJSON = false);
 		/// Escapes a string. Special characters like tab, backslash, ... are
 		/// escaped. Unicode characters are escaped to \uxxxx.
@@ -77,6 +93,15 @@ struct Foundation_API UTF8
 };
 
 
+//
+// inlines
+//
+inline bool UTF8::isValid(const std::string& str)
+{
+	return isValid(str.data(), str.size());
+}
+
+
 } // namespace Lucid
 
 
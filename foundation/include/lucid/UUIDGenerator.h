@@ -24,6 +24,7 @@
 #include "lucid/Random.h"
 #include "lucid/Timestamp.h"
 #include "lucid/Environment.h"
+#include <vector>
 
 
 namespace Lucid {
@@ -39,6 +40,11 @@ class Foundation_API UUIDGenerator
 	/// RFC 2518 (WebDAV), section 6.4.1 and the UUIDs and GUIDs internet
 	/// draft by Leach/Salz from February, 1998
 	/// (http://ftp.ics.uci.edu/pub/ietf/webdav/uuid-guid/draft-leach-uuids-guids-01.txt)
+	///
+	/// Random and time-ordered UUIDs are created from a ChaCha20-based
+	/// generator that is kept separately for every thread and seeded
+	/// from the operating system's random source. Creating them takes no
+	/// lock and does not allocate memory.
 {
 public:
 	UUIDGenerator();
@@ -68,7 +74,27 @@ public:
 		/// Creates a name-based UUID, using the given digest engine and version.
 
 	UUID createRandom();
-		/// Creates a random UUID.
+		/// Creates a random (version 4) UUID.
+
+	UUID createTimeOrdered();
+		/// Creates a time-ordered (version 7) UUID, as specified
+		/// in RFC 9562.
+		///
+		/// The UUID starts with the Unix time in milliseconds,
+		/// followed by a 12-bit counter and 62 random bits.
+		/// UUIDs created by the same thread sort in the order of
+		/// their creation, which keeps database indexes compact.
+
+	void createMany(UUID uuids[], std::size_t count, UUID::Version version = UUID::UUID_RANDOM);
+		/// Stores count new UUIDs of the given version in uuids.
+		///
+		/// Supported versions are UUID_RANDOM, UUID_TIME_ORDERED
+		/// and UUID_TIME_BASED. Throws an InvalidArgumentException
+		/// for all other versions.
+
+	std::vector<UUID> createMany(std::size_t count, UUID::Version version = UUID::UUID_RANDOM);
+		/// Returns count new UUIDs of the given version.
+		/// See createMany(UUID[], std::size_t, UUID::Version).
 
 	UUID createOne();
 		/// Tries to create and return a time-based UUID (see create()), and,
@@ -77,6 +103,9 @@ public:
 		///
 		/// The UUID::version() method can be used to determine the actual kind of
 		/// the UUID generated.
+		///
+		/// Time-based UUIDs are created under a lock. Use createRandom()
+		/// or createTimeOrdered() where many threads need UUIDs at a high rate.
 
 	void seed(UInt32 n);
 		/// Seeds the internal pseudo random generator for time-based UUIDs with the given seed.
@@ -47,8 +47,9 @@ public:
 	
 	ActiveMethod<void, std::string, ArchiveCompressor, ActiveStarter<ActiveDispatcher>> compress;
 
-protected:
-	void compressImpl(const std::string& path)
+	static void compressFile(const std::string& path)
+		/// Compresses the given file to path.gz and removes it.
+		/// If compressing fails, the file is left uncompressed.
 	{
 		std::string gzPath(path);
 		gzPath.append(".gz");
@@ -73,7 +74,12 @@ protected:
 		}
 		File f(path);
 		f.remove();
-		return;
+	}
+
+protected:
+	void compressImpl(const std::string& path)
+	{
+		compressFile(path);
 	}
 };
 
@@ -102,7 +108,19 @@ void ArchiveStrategy::compress(bool flag)
 }
 
 
-void ArchiveStrategy::moveFile(const std::string& oldPath, const std::string& newPath)
+void ArchiveStrategy::archiveFile(const std::string& path, const std::string& rotatedPath)
+{
+	throw NotImplementedException("ArchiveStrategy::archiveFile()");
+}
+
+
+bool ArchiveStrategy::canArchiveFile() const
+{
+	return false;
+}
+
+
+void ArchiveStrategy::moveFile(const std::string& oldPath, const std::string& newPath, bool compressNow)
 {
 	bool compressed = false;
 	Path p(oldPath);
@@ -122,6 +140,11 @@ void ArchiveStrategy::moveFile(const std::string& oldPath, const std::string& ne
 	else
 	{
 		f.renameTo(newPath);
+		if (compressNow)
+		{
+			ArchiveCompressor::compressFile(newPath);
+			return;
+		}
 		if (!_pCompressor) _pCompressor = new ArchiveCompressor;
 		_pCompressor->compress(newPath);
 	}
@@ -165,6 +188,25 @@ LogFile* ArchiveByNumberStrategy::archive(LogFile* pFile)
 {
 	std::string basePath = pFile->path();
 	delete pFile;
+	archiveByNumber(basePath, basePath, false);
+	return new LogFile(basePath);
+}
+
+
+void ArchiveByNumberStrategy::archiveFile(const std::string& path, const std::string& rotatedPath)
+{
+	archiveByNumber(path, rotatedPath, true);
+}
+
+
+bool ArchiveByNumberStrategy::canArchiveFile() const
+{
+	return true;
+}
+
+
+void ArchiveByNumberStrategy::archiveByNumber(const std::string& basePath, const std::string& rotatedPath, bool compressNow)
+{
 	int n = -1;
 	std::string path;
 	do
@@ -177,19 +219,19 @@ LogFile* ArchiveByNumberStrategy::archive(LogFile* pFile)
 	
 	while (n >= 0)
 	{
-		std::string oldPath = basePath;
+		std::string oldPath = rotatedPath;
 		if (n > 0)
 		{
+			oldPath = basePath;
 			oldPath.append(".");
 			NumberFormatter::append(oldPath, n - 1);
 		}
 		std::string newPath = basePath;
 		newPath.append(".");
 		NumberFormatter::append(newPath, n);
-		moveFile(oldPath, newPath);
+		moveFile(oldPath, newPath, compressNow);
 		--n;
 	}
-	return new LogFile(basePath);
 }
 
 
@@ -0,0 +1,230 @@
+//
+// Base32.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base32
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "lucid/Base32.h"
+#include "lucid/Exception.h"
+#include <cstring>
+
+
+namespace Lucid {
+
+
+namespace
+{
+	const char ENCODING[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+	const UInt8 INVALID = 0xFF;
+
+	struct DecodingTable
+	{
+		DecodingTable()
+		{
+			std::memset(d, INVALID, sizeof(d));
+			for (int i = 0; i < 32; i++)
+			{
+				d[static_cast<unsigned char>(ENCODING[i])] = static_cast<UInt8>(i);
+			}
+		}
+
+		UInt8 d[256];
+	};
+
+	const DecodingTable& decodingTable()
+	{
+		static const DecodingTable table;
+		return table;
+	}
+
+	void encodeGroups(const unsigned char* in, std::size_t groups, char* out)
+	{
+		for (std::size_t i = 0; i < groups; i++, in += 5, out += 8)
+		{
+			UInt64 v = (UInt64(in[0]) << 32) | (UInt64(in[1]) << 24) | (UInt64(in[2]) << 16) | (UInt64(in[3]) << 8) | in[4];
+			for (int k = 0; k < 8; k++)
+			{
+				out[k] = ENCODING[(v >> (35 - 5*k)) & 0x1F];
+			}
+		}
+	}
+
+	void decodeGroups(const char* in, std::size_t groups, unsigned char* out)
+	{
+		const UInt8* table = decodingTable().d;
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(in);
+		for (std::size_t i = 0; i < groups; i++, p += 8, out += 5)
+		{
+			UInt64 v = 0;
+			UInt8 check = 0;
+			for (int k = 0; k < 8; k++)
+			{
+				UInt8 d = table[p[k]];
+				check |= d;
+				v = (v << 5) | d;
+			}
+			if (check & 0x80) throw DataFormatException("Invalid Base32 character");
+			out[0] = static_cast<unsigned char>(v >> 32);
+			out[1] = static_cast<unsigned char>(v >> 24);
+			out[2] = static_cast<unsigned char>(v >> 16);
+			out[3] = static_cast<unsigned char>(v >> 8);
+			out[4] = static_cast<unsigned char>(v);
+		}
+	}
+
+	std::size_t decodeTail(const char* in, std::size_t length, unsigned char* out, bool strict)
+		/// Decodes a final group of 2, 4, 5 or 7 characters.
+	{
+		const UInt8* table = decodingTable().d;
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(in);
+		if (length != 2 && length != 4 && length != 5 && length != 7) throw DataFormatException("Invalid Base32 length");
+
+		UInt64 v = 0;
+		for (std::size_t k = 0; k < length; k++)
+		{
+			UInt8 d = table[p[k]];
+			if (d == INVALID) throw DataFormatException("Invalid Base32 character");
+			v = (v << 5) | d;
+		}
+		std::size_t n = length*5/8;
+		int unused = static_cast<int>(length*5 - n*8);
+		if (strict && (v & ((UInt64(1) << unused) - 1))) throw DataFormatException("Non-canonical Base32 data");
+		v >>= unused;
+		for (std::size_t k = 0; k < n; k++)
+		{
+			out[k] = static_cast<unsigned char>(v >> (8*(n - k - 1)));
+		}
+		return n;
+	}
+
+	inline bool isSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+
+	std::size_t decodeLenient(const char* data, std::size_t size, unsigned char* out)
+	{
+		enum
+		{
+			CHUNK_SIZE = 4096
+		};
+		char chunk[CHUNK_SIZE];
+		std::size_t length = 0;
+		unsigned char* begin = out;
+		const char* it = data;
+		const char* end = data + size;
+		bool padding = false;
+		while (it != end && !padding)
+		{
+			while (it != end && length < CHUNK_SIZE)
+			{
+				char c = *it++;
+				if (c == '=')
+				{
+					padding = true;
+					break;
+				}
+				if (!isSpace(c)) chunk[length++] = c;
+			}
+			std::size_t groups = length/8;
+			decodeGroups(chunk, groups, out);
+			out += 5*groups;
+			length -= 8*groups;
+			std::memmove(chunk, chunk + 8*groups, length);
+		}
+		for (; it != end; ++it)
+		{
+			if (*it != '=' && !isSpace(*it)) throw DataFormatException("Invalid Base32 padding");
+		}
+		if (length > 0) out += decodeTail(chunk, length, out, false);
+		return out - begin;
+	}
+}
+
+
+std::size_t Base32::encode(const void* data, std::size_t size, char* buffer, int options)
+{
+	poco_assert (data || size == 0);
+
+	const unsigned char* in = static_cast<const unsigned char*>(data);
+	std::size_t groups = size/5;
+	encodeGroups(in, groups, buffer);
+	char* out = buffer + 8*groups;
+
+	std::size_t rest = size - 5*groups;
+	if (rest > 0)
+	{
+		unsigned char group[5] = {0, 0, 0, 0, 0};
+		std::memcpy(group, in + 5*groups, rest);
+		char chars[8];
+		encodeGroups(group, 1, chars);
+		std::size_t length = encodedLength(rest, BASE32_NO_PADDING);
+		std::memcpy(out, chars, length);
+		out += length;
+		if (!(options & BASE32_NO_PADDING))
+		{
+			for (; length < 8; length++) *out++ = '=';
+		}
+	}
+	return out - buffer;
+}
+
+
+std::string Base32::encode(const void* data, std::size_t size, int options)
+{
+	std::string result(encodedLength(size, options), '\0');
+	if (!result.empty()) encode(data, size, &result[0], options);
+	return result;
+}
+
+
+std::size_t Base32::decode(const char* data, std::size_t size, void* buffer, int options)
+{
+	poco_assert (data || size == 0);
+
+	unsigned char* out = static_cast<unsigned char*>(buffer);
+	if (options & BASE32_LENIENT) return decodeLenient(data, size, out);
+
+	std::size_t tailLength = 0;
+	std::size_t tailChars = 0;
+	if (options & BASE32_NO_PADDING)
+	{
+		tailLength = size % 8;
+		tailChars  = tailLength;
+	}
+	else
+	{
+		if (size % 8) throw DataFormatException("Invalid Base32 length");
+		if (size > 0 && data[size - 1] == '=')
+		{
+			tailChars  = 8;
+			tailLength = 7;
+			while (tailLength > 0 && data[size - 8 + tailLength - 1] == '=') --tailLength;
+		}
+	}
+
+	std::size_t groups = (size - tailChars)/8;
+	decodeGroups(data, groups, out);
+	std::size_t n = 5*groups;
+	if (tailChars > 0) n += decodeTail(data + 8*groups, tailLength, out + n, true);
+	return n;
+}
+
+
+std::string Base32::decode(const std::string& data, int options)
+{
+	std::string result(decodedLength(data.size()), '\0');
+	if (!result.empty()) result.resize(decode(data.data(), data.size(), &result[0], options));
+	return result;
+}
+
+
+} // namespace Lucid
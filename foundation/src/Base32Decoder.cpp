@@ -14,6 +14,7 @@
 
 #include "lucid/Base32Decoder.h"
 #include "lucid/Base32Encoder.h"
+#include "lucid/Base32.h"
 #include "lucid/Exception.h"
 #include "lucid/Mutex.h"
 #include <cstring>
@@ -35,7 +36,8 @@ namespace
 Base32DecoderBuf::Base32DecoderBuf(std::istream& istr): 
 	_groupLength(0),
 	_groupIndex(0),
-	_buf(*istr.rdbuf())
+	_buf(*istr.rdbuf()),
+	_charsIndex(0)
 {
 	FastMutex::ScopedLock lock(mutex);
 	if (!IN_ENCODING_INIT)
@@ -125,11 +127,84 @@ int Base32DecoderBuf::readFromDevice()
 
 int Base32DecoderBuf::readOne()
 {
+	if (_charsIndex < _chars.size())
+		return static_cast<unsigned char>(_chars[_charsIndex++]);
+
 	int ch = _buf.sbumpc();
 	return ch;
 }
 
 
+std::streamsize Base32DecoderBuf::xsgetn(char* p, std::streamsize count)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	if (count <= 0) return 0;
+	int c = uflow();
+	if (c == eof) return 0;
+	*p++ = static_cast<char>(c);
+	std::streamsize copied = 1;
+	while (copied < count && _groupIndex < _groupLength)
+	{
+		*p++ = static_cast<char>(_group[_groupIndex++]);
+		++copied;
+	}
+
+	// Decode complete groups in blocks, up to the first
+	// padding character, which is left to readFromDevice().
+	while (count - copied >= 5)
+	{
+		std::size_t groups = static_cast<std::size_t>((count - copied)/5);
+		if (groups > BLOCK_GROUPS) groups = BLOCK_GROUPS;
+		std::size_t length = readChars(8*groups);
+		if (length > 8*groups) length = 8*groups;
+		const char* q = _chars.data() + _charsIndex;
+		const char* padding = static_cast<const char*>(std::memchr(q, '=', length));
+		if (padding) length = padding - q;
+		std::size_t n = length/8;
+		if (n == 0) break;
+		Base32::decode(q, 8*n, p, BASE32_NO_PADDING);
+		_charsIndex += 8*n;
+		p      += 5*n;
+		copied += 5*n;
+		if (n < groups) break;
+	}
+
+	while (copied < count)
+	{
+		c = uflow();
+		if (c == eof) break;
+		*p++ = static_cast<char>(c);
+		++copied;
+	}
+	return copied;
+}
+
+
+std::size_t Base32DecoderBuf::readChars(std::size_t count)
+{
+	if (_charsIndex == _chars.size())
+	{
+		_chars.clear();
+		_charsIndex = 0;
+	}
+	while (_chars.size() - _charsIndex < count)
+	{
+		std::size_t offset = _chars.size();
+		std::size_t wanted = count - (offset - _charsIndex);
+		_chars.resize(offset + wanted);
+		std::streamsize n = _buf.sgetn(&_chars[offset], static_cast<std::streamsize>(wanted));
+		if (n <= 0)
+		{
+			_chars.resize(offset);
+			break;
+		}
+		_chars.resize(offset + static_cast<std::size_t>(n));
+	}
+	return _chars.size() - _charsIndex;
+}
+
+
 Base32DecoderIOS::Base32DecoderIOS(std::istream& istr): _buf(istr)
 {
 	poco_ios_init(&_buf);
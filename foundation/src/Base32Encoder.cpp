@@ -13,6 +13,7 @@
 
 
 #include "lucid/Base32Encoder.h"
+#include "lucid/Base32.h"
 
 
 namespace Lucid {
@@ -78,6 +79,36 @@ int Base32EncoderBuf::writeToDevice(char c)
 }
 
 
+std::streamsize Base32EncoderBuf::xsputn(const char* s, std::streamsize count)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	std::streamsize written = 0;
+	while (_groupLength > 0 && written < count)
+	{
+		if (writeToDevice(s[written]) == eof) return written;
+		++written;
+	}
+
+	char block[BLOCK_GROUPS*8];
+	while (count - written >= 5)
+	{
+		std::size_t groups = static_cast<std::size_t>((count - written)/5);
+		if (groups > BLOCK_GROUPS) groups = BLOCK_GROUPS;
+		std::size_t length = Base32::encode(s + written, 5*groups, block, BASE32_NO_PADDING);
+		if (_buf.sputn(block, length) != static_cast<std::streamsize>(length)) return written;
+		written += 5*groups;
+	}
+
+	while (written < count)
+	{
+		if (writeToDevice(s[written]) == eof) return written;
+		++written;
+	}
+	return written;
+}
+
+
 int Base32EncoderBuf::close()
 {
 	static const int eof = std::char_traits<char>::eof();
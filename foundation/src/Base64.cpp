@@ -0,0 +1,472 @@
+//
+// Base64.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base64
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "lucid/Base64.h"
+#include "lucid/CPUFeatures.h"
+#include "lucid/Exception.h"
+#include <cstring>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define POCO_BASE64_X86 1
+	#include <immintrin.h>
+#endif
+
+
+namespace Lucid {
+
+
+namespace
+{
+	const char ENCODING[]     = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	const char ENCODING_URL[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+	const UInt32 INVALID = 0x01000000;
+
+	struct DecodingTable
+		/// Four tables mapping a character at position 0-3 of a
+		/// group to its bits in the decoded 24-bit value, so that
+		/// a group can be decoded with four lookups. Invalid
+		/// characters map to INVALID.
+	{
+		explicit DecodingTable(const char* alphabet)
+		{
+			for (int k = 0; k < 4; k++)
+			{
+				for (int i = 0; i < 256; i++) d[k][i] = INVALID;
+			}
+			for (int i = 0; i < 64; i++)
+			{
+				unsigned char c = static_cast<unsigned char>(alphabet[i]);
+				d[0][c] = i << 18;
+				d[1][c] = i << 12;
+				d[2][c] = i << 6;
+				d[3][c] = i;
+			}
+		}
+
+		UInt32 d[4][256];
+	};
+
+	const DecodingTable& decodingTable(bool url)
+	{
+		static const DecodingTable table(ENCODING);
+		static const DecodingTable urlTable(ENCODING_URL);
+		return url ? urlTable : table;
+	}
+
+	void encodeScalar(const unsigned char* in, std::size_t groups, char* out, const char* alphabet)
+	{
+		for (std::size_t i = 0; i < groups; i++, in += 3, out += 4)
+		{
+			UInt32 v = (UInt32(in[0]) << 16) | (UInt32(in[1]) << 8) | in[2];
+			out[0] = alphabet[v >> 18];
+			out[1] = alphabet[(v >> 12) & 0x3F];
+			out[2] = alphabet[(v >> 6) & 0x3F];
+			out[3] = alphabet[v & 0x3F];
+		}
+	}
+
+	std::size_t decodeScalar(const char* in, std::size_t groups, unsigned char* out, const DecodingTable& table)
+		/// Decodes up to the given number of groups. Returns the
+		/// number of groups decoded before the first invalid one.
+	{
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(in);
+		for (std::size_t i = 0; i < groups; i++, p += 4, out += 3)
+		{
+			UInt32 v = table.d[0][p[0]] | table.d[1][p[1]] | table.d[2][p[2]] | table.d[3][p[3]];
+			if (v & INVALID) return i;
+			out[0] = static_cast<unsigned char>(v >> 16);
+			out[1] = static_cast<unsigned char>(v >> 8);
+			out[2] = static_cast<unsigned char>(v);
+		}
+		return groups;
+	}
+
+
+#if defined(POCO_BASE64_X86)
+
+
+	//
+	// The vectorized implementations follow W. Mula and D. Lemire,
+	// "Faster Base64 Encoding and Decoding Using AVX2 Instructions",
+	// ACM Transactions on the Web 12(3), 2018.
+	//
+	// Decoding uses range checks instead of nibble lookup tables,
+	// so the same code handles both alphabets.
+	//
+
+
+	__attribute__((target("ssse3")))
+	inline __m128i encodeIndices(__m128i in)
+		/// Splits 12 bytes into 16 6-bit indices.
+	{
+		in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+		const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+		const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+		const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+		const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+		return _mm_or_si128(t1, t3);
+	}
+
+
+	__attribute__((target("ssse3")))
+	inline __m128i encodeCharacters(__m128i indices, __m128i shift)
+		/// Translates 16 indices into characters.
+	{
+		__m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+		const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+		result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+		return _mm_add_epi8(_mm_shuffle_epi8(shift, result), indices);
+	}
+
+
+	__attribute__((target("ssse3")))
+	std::size_t encodeSSSE3(const unsigned char* in, std::size_t size, char* out, const char* alphabet)
+		/// Encodes blocks of 12 bytes. Returns the number of bytes encoded.
+	{
+		const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, static_cast<char>(alphabet[62] - 62), static_cast<char>(alphabet[63] - 63), 'A', 0, 0);
+
+		std::size_t done = 0;
+		while (size - done >= 16)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+			v = encodeCharacters(encodeIndices(v), shift);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+			done += 12;
+			out  += 16;
+		}
+		return done;
+	}
+
+
+	__attribute__((target("avx2")))
+	std::size_t encodeAVX2(const unsigned char* in, std::size_t size, char* out, const char* alphabet)
+		/// Encodes blocks of 24 bytes. Returns the number of bytes encoded.
+	{
+		const __m256i shift = _mm256_broadcastsi128_si256(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, static_cast<char>(alphabet[62] - 62), static_cast<char>(alphabet[63] - 63), 'A', 0, 0));
+		const __m256i reshuffle = _mm256_setr_epi8(
+			1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+			1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+		std::size_t done = 0;
+		while (size - done >= 28)
+		{
+			__m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+			__m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done + 12));
+			__m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+			v = _mm256_shuffle_epi8(v, reshuffle);
+			const __m256i t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00));
+			const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+			const __m256i t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0));
+			const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+			const __m256i indices = _mm256_or_si256(t1, t3);
+
+			__m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+			const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+			result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+			result = _mm256_add_epi8(_mm256_shuffle_epi8(shift, result), indices);
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), result);
+			done += 24;
+			out  += 32;
+		}
+		return done;
+	}
+
+
+	__attribute__((target("ssse3")))
+	std::size_t decodeSSSE3(const char* in, std::size_t groups, unsigned char* out, const char* alphabet)
+		/// Decodes blocks of four groups, stopping at the first block
+		/// containing an invalid character. Each block writes 16 bytes
+		/// of which 12 are valid, so the last two groups are always
+		/// left to the caller. Returns the number of groups decoded.
+	{
+		const __m128i c62 = _mm_set1_epi8(alphabet[62]);
+		const __m128i c63 = _mm_set1_epi8(alphabet[63]);
+		const __m128i shift62 = _mm_set1_epi8(static_cast<char>(62 - alphabet[62]));
+		const __m128i shift63 = _mm_set1_epi8(static_cast<char>(63 - alphabet[63]));
+
+		std::size_t done = 0;
+		while (groups - done >= 6)
+		{
+			const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 4*done));
+			const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(s, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(s, _mm_set1_epi8('Z' + 1)));
+			const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(s, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(s, _mm_set1_epi8('z' + 1)));
+			const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(s, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(s, _mm_set1_epi8('9' + 1)));
+			const __m128i is62  = _mm_cmpeq_epi8(s, c62);
+			const __m128i is63  = _mm_cmpeq_epi8(s, c63);
+			const __m128i valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, is62)), is63);
+			if (_mm_movemask_epi8(valid) != 0xFFFF) break;
+
+			__m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-65));
+			shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(-71)));
+			shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(4)));
+			shift = _mm_or_si128(shift, _mm_and_si128(is62, shift62));
+			shift = _mm_or_si128(shift, _mm_and_si128(is63, shift63));
+			const __m128i values = _mm_add_epi8(s, shift);
+
+			__m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+			merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+			merged = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 3*done), merged);
+			done += 4;
+		}
+		return done;
+	}
+
+
+	__attribute__((target("avx2")))
+	std::size_t decodeAVX2(const char* in, std::size_t groups, unsigned char* out, const char* alphabet)
+		/// Decodes blocks of eight groups, stopping at the first block
+		/// containing an invalid character. Each block writes 32 bytes
+		/// of which 24 are valid. Returns the number of groups decoded.
+	{
+		const __m256i c62 = _mm256_set1_epi8(alphabet[62]);
+		const __m256i c63 = _mm256_set1_epi8(alphabet[63]);
+		const __m256i shift62 = _mm256_set1_epi8(static_cast<char>(62 - alphabet[62]));
+		const __m256i shift63 = _mm256_set1_epi8(static_cast<char>(63 - alphabet[63]));
+		const __m256i pack = _mm256_setr_epi8(
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+		const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+		std::size_t done = 0;
+		while (groups - done >= 11)
+		{
+			const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 4*done));
+			const __m256i upper = _mm256_andnot_si256(_mm256_cmpgt_epi8(s, _mm256_set1_epi8('Z')), _mm256_cmpgt_epi8(s, _mm256_set1_epi8('A' - 1)));
+			const __m256i lower = _mm256_andnot_si256(_mm256_cmpgt_epi8(s, _mm256_set1_epi8('z')), _mm256_cmpgt_epi8(s, _mm256_set1_epi8('a' - 1)));
+			const __m256i digit = _mm256_andnot_si256(_mm256_cmpgt_epi8(s, _mm256_set1_epi8('9')), _mm256_cmpgt_epi8(s, _mm256_set1_epi8('0' - 1)));
+			const __m256i is62  = _mm256_cmpeq_epi8(s, c62);
+			const __m256i is63  = _mm256_cmpeq_epi8(s, c63);
+			const __m256i valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, is62)), is63);
+			if (_mm256_movemask_epi8(valid) != -1) break;
+
+			__m256i shift = _mm256_and_si256(upper, _mm256_set1_epi8(-65));
+			shift = _mm256_or_si256(shift, _mm256_and_si256(lower, _mm256_set1_epi8(-71)));
+			shift = _mm256_or_si256(shift, _mm256_and_si256(digit, _mm256_set1_epi8(4)));
+			shift = _mm256_or_si256(shift, _mm256_and_si256(is62, shift62));
+			shift = _mm256_or_si256(shift, _mm256_and_si256(is63, shift63));
+			const __m256i values = _mm256_add_epi8(s, shift);
+
+			__m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+			merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+			merged = _mm256_shuffle_epi8(merged, pack);
+			merged = _mm256_permutevar8x32_epi32(merged, compact);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 3*done), merged);
+			done += 8;
+		}
+		return done;
+	}
+
+
+#endif // POCO_BASE64_X86
+
+
+	std::size_t encodeBlocks(const unsigned char* in, std::size_t size, char* out, const char* alphabet)
+		/// Encodes as many bytes as possible with a vectorized
+		/// implementation. Returns the number of bytes encoded,
+		/// which is always a multiple of 3.
+	{
+		std::size_t done = 0;
+#if defined(POCO_BASE64_X86)
+		static const bool avx2 = CPUFeatures::hasAVX2();
+		static const bool ssse3 = CPUFeatures::hasSSSE3();
+		if (avx2)
+			done = encodeAVX2(in, size, out, alphabet);
+		if (ssse3)
+			done += encodeSSSE3(in + done, size - done, out + done/3*4, alphabet);
+#endif
+		return done;
+	}
+
+
+	void decodeGroups(const char* in, std::size_t groups, unsigned char* out, bool url)
+		/// Decodes complete groups of four characters.
+		/// Throws a DataFormatException if an invalid
+		/// character is found.
+	{
+		const char* alphabet = url ? ENCODING_URL : ENCODING;
+		std::size_t done = 0;
+#if defined(POCO_BASE64_X86)
+		static const bool avx2 = CPUFeatures::hasAVX2();
+		static const bool ssse3 = CPUFeatures::hasSSSE3();
+		if (avx2)
+			done = decodeAVX2(in, groups, out, alphabet);
+		if (ssse3)
+			done += decodeSSSE3(in + 4*done, groups - done, out + 3*done, alphabet);
+#else
+		(void) alphabet;
+#endif
+		done += decodeScalar(in + 4*done, groups - done, out + 3*done, decodingTable(url));
+		if (done < groups) throw DataFormatException("Invalid Base64 character");
+	}
+
+
+	std::size_t decodeTail(const char* in, std::size_t length, unsigned char* out, bool url, bool strict)
+		/// Decodes a final group of 2 or 3 characters.
+	{
+		const DecodingTable& table = decodingTable(url);
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(in);
+		UInt32 a = table.d[3][p[0]];
+		UInt32 b = table.d[3][p[1]];
+		UInt32 c = length == 3 ? table.d[3][p[2]] : 0;
+		if ((a | b | c) & INVALID) throw DataFormatException("Invalid Base64 character");
+
+		out[0] = static_cast<unsigned char>((a << 2) | (b >> 4));
+		if (length == 2)
+		{
+			if (strict && (b & 0x0F)) throw DataFormatException("Non-canonical Base64 data");
+			return 1;
+		}
+		out[1] = static_cast<unsigned char>(((b & 0x0F) << 4) | (c >> 2));
+		if (strict && (c & 0x03)) throw DataFormatException("Non-canonical Base64 data");
+		return 2;
+	}
+
+
+	inline bool isSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+
+
+	std::size_t decodeLenient(const char* data, std::size_t size, unsigned char* out, bool url)
+		/// Removes whitespace in chunks and decodes the complete
+		/// groups of each chunk, up to an optional padding.
+	{
+		enum
+		{
+			CHUNK_SIZE = 4096
+		};
+		char chunk[CHUNK_SIZE];
+		std::size_t length = 0;
+		unsigned char* begin = out;
+		const char* it = data;
+		const char* end = data + size;
+		bool padding = false;
+		while (it != end && !padding)
+		{
+			while (it != end && length < CHUNK_SIZE)
+			{
+				char c = *it++;
+				if (c == '=')
+				{
+					padding = true;
+					break;
+				}
+				if (!isSpace(c)) chunk[length++] = c;
+			}
+			std::size_t groups = length/4;
+			decodeGroups(chunk, groups, out, url);
+			out += 3*groups;
+			length -= 4*groups;
+			std::memmove(chunk, chunk + 4*groups, length);
+		}
+		for (; it != end; ++it)
+		{
+			if (*it != '=' && !isSpace(*it)) throw DataFormatException("Invalid Base64 padding");
+		}
+		if (length == 1) throw DataFormatException("Invalid Base64 length");
+		if (length > 1) out += decodeTail(chunk, length, out, url, false);
+		return out - begin;
+	}
+}
+
+
+std::size_t Base64::encode(const void* data, std::size_t size, char* buffer, int options)
+{
+	poco_assert (data || size == 0);
+
+	const unsigned char* in = static_cast<const unsigned char*>(data);
+	const char* alphabet = (options & BASE64_URL_ENCODING) ? ENCODING_URL : ENCODING;
+	char* out = buffer;
+
+	std::size_t done = encodeBlocks(in, size, out, alphabet);
+	std::size_t groups = (size - done)/3;
+	encodeScalar(in + done, groups, out + done/3*4, alphabet);
+	done += 3*groups;
+	out  += done/3*4;
+	in   += done;
+
+	std::size_t rest = size - done;
+	if (rest > 0)
+	{
+		UInt32 v = UInt32(in[0]) << 16;
+		if (rest == 2) v |= UInt32(in[1]) << 8;
+		*out++ = alphabet[v >> 18];
+		*out++ = alphabet[(v >> 12) & 0x3F];
+		if (rest == 2) *out++ = alphabet[(v >> 6) & 0x3F];
+		if (!(options & BASE64_NO_PADDING))
+		{
+			*out++ = '=';
+			if (rest == 1) *out++ = '=';
+		}
+	}
+	return out - buffer;
+}
+
+
+std::string Base64::encode(const void* data, std::size_t size, int options)
+{
+	std::string result(encodedLength(size, options), '\0');
+	if (!result.empty()) encode(data, size, &result[0], options);
+	return result;
+}
+
+
+std::size_t Base64::decode(const char* data, std::size_t size, void* buffer, int options)
+{
+	poco_assert (data || size == 0);
+
+	unsigned char* out = static_cast<unsigned char*>(buffer);
+	bool url = (options & BASE64_URL_ENCODING) != 0;
+	if (options & BASE64_LENIENT) return decodeLenient(data, size, out, url);
+
+	std::size_t tailLength = 0;
+	std::size_t tailChars = 0;
+	if (options & BASE64_NO_PADDING)
+	{
+		tailLength = size % 4;
+		tailChars  = tailLength;
+		if (tailLength == 1) throw DataFormatException("Invalid Base64 length");
+	}
+	else
+	{
+		if (size % 4) throw DataFormatException("Invalid Base64 length");
+		if (size > 0 && data[size - 1] == '=')
+		{
+			tailLength = data[size - 2] == '=' ? 2 : 3;
+			tailChars  = 4;
+		}
+	}
+
+	std::size_t groups = (size - tailChars)/4;
+	decodeGroups(data, groups, out, url);
+	std::size_t n = 3*groups;
+	if (tailLength > 0) n += decodeTail(data + 4*groups, tailLength, out + n, url, true);
+	return n;
+}
+
+
+std::string Base64::decode(const std::string& data, int options)
+{
+	std::string result(decodedLength(data.size()), '\0');
+	if (!result.empty()) result.resize(decode(data.data(), data.size(), &result[0], options));
+	return result;
+}
+
+
+} // namespace Lucid
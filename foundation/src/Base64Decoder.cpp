@@ -14,8 +14,10 @@
 
 #include "lucid/Base64Decoder.h"
 #include "lucid/Base64Encoder.h"
+#include "lucid/Base64.h"
 #include "lucid/Exception.h"
 #include "lucid/Mutex.h"
+#include <cstring>
 
 
 namespace Lucid {
@@ -38,6 +40,7 @@ Base64DecoderBuf::Base64DecoderBuf(std::istream& istr, int options):
 	_groupLength(0),
 	_groupIndex(0),
 	_buf(*istr.rdbuf()),
+	_charsIndex(0),
 	_pInEncoding((options & BASE64_URL_ENCODING) ? IN_ENCODING_URL : IN_ENCODING)
 {
 	FastMutex::ScopedLock lock(mutex);
@@ -138,6 +141,9 @@ int Base64DecoderBuf::readFromDevice()
 
 int Base64DecoderBuf::readOne()
 {
+	if (_charsIndex < _chars.size())
+		return static_cast<unsigned char>(_chars[_charsIndex++]);
+
 	int ch = _buf.sbumpc();
 	if (!(_options & BASE64_URL_ENCODING))
 	{
@@ -148,6 +154,87 @@ int Base64DecoderBuf::readOne()
 }
 
 
+std::streamsize Base64DecoderBuf::xsgetn(char* p, std::streamsize count)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	if (count <= 0) return 0;
+	int c = uflow();
+	if (c == eof) return 0;
+	*p++ = static_cast<char>(c);
+	std::streamsize copied = 1;
+	while (copied < count && _groupIndex < _groupLength)
+	{
+		*p++ = static_cast<char>(_group[_groupIndex++]);
+		++copied;
+	}
+
+	// Decode complete groups in blocks, up to the first
+	// padding character, which is left to readFromDevice().
+	while (count - copied >= 3)
+	{
+		std::size_t groups = static_cast<std::size_t>((count - copied)/3);
+		if (groups > BLOCK_GROUPS) groups = BLOCK_GROUPS;
+		std::size_t length = readChars(4*groups);
+		if (length > 4*groups) length = 4*groups;
+		const char* q = _chars.data() + _charsIndex;
+		const char* padding = static_cast<const char*>(std::memchr(q, '=', length));
+		if (padding) length = padding - q;
+		std::size_t n = length/4;
+		if (n == 0) break;
+		Base64::decode(q, 4*n, p, (_options & BASE64_URL_ENCODING) | BASE64_NO_PADDING);
+		_charsIndex += 4*n;
+		p      += 3*n;
+		copied += 3*n;
+		if (n < groups) break;
+	}
+
+	while (copied < count)
+	{
+		c = uflow();
+		if (c == eof) break;
+		*p++ = static_cast<char>(c);
+		++copied;
+	}
+	return copied;
+}
+
+
+std::size_t Base64DecoderBuf::readChars(std::size_t count)
+{
+	if (_charsIndex == _chars.size())
+	{
+		_chars.clear();
+		_charsIndex = 0;
+	}
+	while (_chars.size() - _charsIndex < count)
+	{
+		std::size_t offset = _chars.size();
+		std::size_t wanted = count - (offset - _charsIndex);
+		_chars.resize(offset + wanted);
+		std::streamsize n = _buf.sgetn(&_chars[offset], static_cast<std::streamsize>(wanted));
+		if (n <= 0)
+		{
+			_chars.resize(offset);
+			break;
+		}
+		std::size_t end = offset + static_cast<std::size_t>(n);
+		if (!(_options & BASE64_URL_ENCODING))
+		{
+			std::size_t it = offset;
+			for (std::size_t i = offset; i < end; i++)
+			{
+				char ch = _chars[i];
+				if (ch != ' ' && ch != '\r' && ch != '\t' && ch != '\n') _chars[it++] = ch;
+			}
+			end = it;
+		}
+		_chars.resize(end);
+	}
+	return _chars.size() - _charsIndex;
+}
+
+
 Base64DecoderIOS::Base64DecoderIOS(std::istream& istr, int options): _buf(istr, options)
 {
 	poco_ios_init(&_buf);
@@ -108,6 +108,57 @@ int Base64EncoderBuf::writeToDevice(char c)
 }
 
 
+std::streamsize Base64EncoderBuf::xsputn(const char* s, std::streamsize count)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	std::streamsize written = 0;
+	while (_groupLength > 0 && written < count)
+	{
+		if (writeToDevice(s[written]) == eof) return written;
+		++written;
+	}
+
+	// Encode complete groups in blocks, breaking lines
+	// exactly like writeToDevice() does.
+	char block[BLOCK_GROUPS*6];
+	while (count - written >= 3)
+	{
+		std::size_t groups = static_cast<std::size_t>((count - written)/3);
+		if (groups > BLOCK_GROUPS) groups = BLOCK_GROUPS;
+		std::streamsize begin = written;
+		char* out = block;
+		while (groups > 0)
+		{
+			std::size_t n = groups;
+			if (_lineLength > 0)
+			{
+				std::size_t left = _pos < _lineLength ? static_cast<std::size_t>(_lineLength - _pos + 3)/4 : 1;
+				if (n > left) n = left;
+			}
+			out += Base64::encode(s + written, 3*n, out, _options & BASE64_URL_ENCODING);
+			written += 3*n;
+			groups  -= n;
+			_pos += static_cast<int>(4*n);
+			if (_lineLength > 0 && _pos >= _lineLength)
+			{
+				*out++ = '\r';
+				*out++ = '\n';
+				_pos = 0;
+			}
+		}
+		if (_buf.sputn(block, out - block) != out - block) return begin;
+	}
+
+	while (written < count)
+	{
+		if (writeToDevice(s[written]) == eof) return written;
+		++written;
+	}
+	return written;
+}
+
+
 int Base64EncoderBuf::close()
 {
 	static const int eof = std::char_traits<char>::eof();
@@ -0,0 +1,106 @@
+//
+// CPUFeatures.cpp
+//
+// Library: Foundation
+// Package: Core
+// Module:  CPUFeatures
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "lucid/CPUFeatures.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define POCO_CPUFEATURES_X86 1
+	#include <cpuid.h>
+#endif
+
+
+namespace Lucid {
+
+
+namespace
+{
+	struct Features
+	{
+		Features():
+			ssse3(false),
+			sse41(false),
+			sse42(false),
+			pclmul(false),
+			avx2(false),
+			sha(false)
+		{
+#if defined(POCO_CPUFEATURES_X86)
+			__builtin_cpu_init();
+			ssse3  = __builtin_cpu_supports("ssse3");
+			sse41  = __builtin_cpu_supports("sse4.1");
+			sse42  = __builtin_cpu_supports("sse4.2");
+			pclmul = __builtin_cpu_supports("pclmul");
+			avx2   = __builtin_cpu_supports("avx2");
+
+			// __builtin_cpu_supports() does not know about SHA-NI
+			// in all supported compiler versions.
+			unsigned eax, ebx, ecx, edx;
+			if (sse41 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+			{
+				sha = (ebx & (1u << 29)) != 0;
+			}
+#endif
+		}
+
+		bool ssse3;
+		bool sse41;
+		bool sse42;
+		bool pclmul;
+		bool avx2;
+		bool sha;
+	};
+
+	const Features& features()
+	{
+		static const Features f;
+		return f;
+	}
+}
+
+
+bool CPUFeatures::hasSSSE3()
+{
+	return features().ssse3;
+}
+
+
+bool CPUFeatures::hasSSE41()
+{
+	return features().sse41;
+}
+
+
+bool CPUFeatures::hasSSE42()
+{
+	return features().sse42;
+}
+
+
+bool CPUFeatures::hasPCLMUL()
+{
+	return features().pclmul;
+}
+
+
+bool CPUFeatures::hasAVX2()
+{
+	return features().avx2;
+}
+
+
+bool CPUFeatures::hasSHA()
+{
+	return features().sha;
+}
+
+
+} // namespace Lucid
@@ -13,16 +13,393 @@
 
 
 #include "lucid/Checksum.h"
+#include "lucid/CPUFeatures.h"
 #if defined(POCO_UNBUNDLED)
 #include <zlib.h>
 #else
 #include "lucid/zlib.h"
 #endif
+#include <cstring>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define POCO_CHECKSUM_X86 1
+	#include <immintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+	#define POCO_CHECKSUM_ARM 1
+	#include <arm_acle.h>
+#endif
 
 
 namespace Lucid {
 
 
+namespace
+{
+	const UInt32 CRC32_POLY  = 0xEDB88320;
+	const UInt32 CRC32C_POLY = 0x82F63B78;
+
+	const UInt32 ADLER_BASE = 65521;
+	const unsigned ADLER_NMAX = 5552;
+
+
+	class CRCTables
+		/// Lookup tables for a reflected 32-bit CRC polynomial.
+	{
+	public:
+		explicit CRCTables(UInt32 poly):
+			_poly(poly)
+		{
+			for (UInt32 i = 0; i < 256; i++)
+			{
+				UInt32 c = i;
+				for (int k = 0; k < 8; k++) c = (c & 1) ? (c >> 1) ^ poly : c >> 1;
+				slice[0][i] = c;
+			}
+			for (int i = 0; i < 256; i++)
+			{
+				for (int k = 1; k < 8; k++)
+				{
+					slice[k][i] = (slice[k - 1][i] >> 8) ^ slice[0][slice[k - 1][i] & 0xFF];
+				}
+			}
+			UInt32 p = UInt32(1) << 30;
+			for (int n = 0; n < 32; n++)
+			{
+				_powers[n] = p;
+				p = multiply(p, p);
+			}
+		}
+
+		UInt32 multiply(UInt32 a, UInt32 b) const
+			/// Multiplies a and b modulo the polynomial.
+			/// a must not be zero.
+		{
+			UInt32 m = UInt32(1) << 31;
+			UInt32 p = 0;
+			for (;;)
+			{
+				if (a & m)
+				{
+					p ^= b;
+					if ((a & (m - 1)) == 0) break;
+				}
+				m >>= 1;
+				b = (b & 1) ? (b >> 1) ^ _poly : b >> 1;
+			}
+			return p;
+		}
+
+		UInt32 shift(UInt64 length) const
+			/// Returns x^(8*length) modulo the polynomial, which
+			/// advances a CRC register over length zero bytes
+			/// when multiplied with it.
+		{
+			UInt32 p = UInt32(1) << 31;
+			for (int k = 3; length; length >>= 1, k++)
+			{
+				if (length & 1) p = multiply(_powers[k & 31], p);
+			}
+			return p;
+		}
+
+		UInt32 slice[8][256];
+
+	private:
+		UInt32 _poly;
+		UInt32 _powers[32];
+	};
+
+
+	const CRCTables& crc32Tables()
+	{
+		static const CRCTables tables(CRC32_POLY);
+		return tables;
+	}
+
+
+	const CRCTables& crc32cTables()
+	{
+		static const CRCTables tables(CRC32C_POLY);
+		return tables;
+	}
+
+
+	UInt32 crcSlicing(const CRCTables& t, UInt32 crc, const unsigned char* p, std::size_t n)
+		/// Updates the CRC register with eight bytes per step
+		/// (slicing-by-8).
+	{
+		for (; n >= 8; p += 8, n -= 8)
+		{
+			UInt32 lo = crc ^ (UInt32(p[0]) | (UInt32(p[1]) << 8) | (UInt32(p[2]) << 16) | (UInt32(p[3]) << 24));
+			UInt32 hi = UInt32(p[4]) | (UInt32(p[5]) << 8) | (UInt32(p[6]) << 16) | (UInt32(p[7]) << 24);
+			crc = t.slice[7][lo & 0xFF] ^ t.slice[6][(lo >> 8) & 0xFF] ^ t.slice[5][(lo >> 16) & 0xFF] ^ t.slice[4][lo >> 24]
+			    ^ t.slice[3][hi & 0xFF] ^ t.slice[2][(hi >> 8) & 0xFF] ^ t.slice[1][(hi >> 16) & 0xFF] ^ t.slice[0][hi >> 24];
+		}
+		while (n--) crc = (crc >> 8) ^ t.slice[0][(crc ^ *p++) & 0xFF];
+		return crc;
+	}
+
+
+#if defined(POCO_CHECKSUM_X86)
+
+
+	__attribute__((target("pclmul,sse4.1")))
+	inline __m128i fold(__m128i x, __m128i k, __m128i data)
+	{
+		return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11)), data);
+	}
+
+
+	__attribute__((target("pclmul,sse4.1")))
+	UInt32 crc32PCLMUL(UInt32 crc, const unsigned char* p, std::size_t n)
+		/// Updates the CRC-32 register by folding 64 bytes per step
+		/// with carry-less multiplication, as described in Intel's
+		/// "Fast CRC Computation for Generic Polynomials Using
+		/// PCLMULQDQ Instruction". n must be at least 64 and a
+		/// multiple of 16.
+	{
+		const __m128i k1k2 = _mm_set_epi64x(0x1C6E41596LL, 0x154442BD4LL);
+		const __m128i k3k4 = _mm_set_epi64x(0x0CCAA009ELL, 0x1751997D0LL);
+		const __m128i k5   = _mm_set_epi64x(0, 0x163CD6124LL);
+		const __m128i poly = _mm_set_epi64x(0x1F7011641LL, 0x1DB710641LL);
+		const __m128i mask = _mm_setr_epi32(-1, 0, 0, 0);
+
+		__m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		__m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+		__m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32));
+		__m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48));
+		x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+		p += 64;
+		n -= 64;
+
+		for (; n >= 64; p += 64, n -= 64)
+		{
+			x1 = fold(x1, k1k2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+			x2 = fold(x2, k1k2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)));
+			x3 = fold(x3, k1k2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 32)));
+			x4 = fold(x4, k1k2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 48)));
+		}
+
+		x1 = fold(x1, k3k4, x2);
+		x1 = fold(x1, k3k4, x3);
+		x1 = fold(x1, k3k4, x4);
+		for (; n >= 16; p += 16, n -= 16)
+		{
+			x1 = fold(x1, k3k4, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+		}
+
+		// reduce 128 to 64 bits
+		x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), _mm_clmulepi64_si128(k3k4, x1, 0x01));
+
+		// reduce 64 to 32 bits
+		__m128i t = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k5, 0x00);
+		x1 = _mm_xor_si128(_mm_srli_si128(x1, 4), t);
+
+		// Barrett reduction
+		t = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), poly, 0x10);
+		t = _mm_clmulepi64_si128(_mm_and_si128(t, mask), poly, 0x00);
+		x1 = _mm_xor_si128(x1, t);
+		return static_cast<UInt32>(_mm_extract_epi32(x1, 1));
+	}
+
+
+	__attribute__((target("sse4.2")))
+	UInt32 crc32cSSE42(UInt32 crc, const unsigned char* p, std::size_t n)
+		/// Updates the CRC-32C register with the crc32 instruction.
+		/// Large inputs are processed in three interleaved streams
+		/// to hide the latency of the instruction; the partial
+		/// results are then merged.
+	{
+		enum
+		{
+			BLOCK_SIZE = 4096
+		};
+
+#if defined(__x86_64__)
+		if (n >= 3*BLOCK_SIZE)
+		{
+			const CRCTables& tables = crc32cTables();
+			static const UInt32 blockShift = tables.shift(BLOCK_SIZE);
+			for (; n >= 3*BLOCK_SIZE; p += 3*BLOCK_SIZE, n -= 3*BLOCK_SIZE)
+			{
+				UInt64 c0 = crc;
+				UInt64 c1 = 0;
+				UInt64 c2 = 0;
+				for (std::size_t i = 0; i < BLOCK_SIZE; i += 8)
+				{
+					UInt64 v0;
+					UInt64 v1;
+					UInt64 v2;
+					std::memcpy(&v0, p + i, 8);
+					std::memcpy(&v1, p + BLOCK_SIZE + i, 8);
+					std::memcpy(&v2, p + 2*BLOCK_SIZE + i, 8);
+					c0 = _mm_crc32_u64(c0, v0);
+					c1 = _mm_crc32_u64(c1, v1);
+					c2 = _mm_crc32_u64(c2, v2);
+				}
+				crc = tables.multiply(blockShift, static_cast<UInt32>(c0)) ^ static_cast<UInt32>(c1);
+				crc = tables.multiply(blockShift, crc) ^ static_cast<UInt32>(c2);
+			}
+		}
+		UInt64 c = crc;
+		for (; n >= 8; p += 8, n -= 8)
+		{
+			UInt64 v;
+			std::memcpy(&v, p, 8);
+			c = _mm_crc32_u64(c, v);
+		}
+		crc = static_cast<UInt32>(c);
+#endif
+		for (; n >= 4; p += 4, n -= 4)
+		{
+			UInt32 v;
+			std::memcpy(&v, p, 4);
+			crc = _mm_crc32_u32(crc, v);
+		}
+		while (n--) crc = _mm_crc32_u8(crc, *p++);
+		return crc;
+	}
+
+
+	__attribute__((target("ssse3")))
+	UInt32 adler32SSSE3(UInt32 adler, const unsigned char* p, std::size_t n)
+		/// Updates the Adler-32 checksum with 32 bytes per step,
+		/// computing the weighted sums for s2 with multiply-add
+		/// instructions. n must be a multiple of 32.
+	{
+		enum
+		{
+			BLOCK_SIZE = 32
+		};
+
+		UInt32 s1 = adler & 0xFFFF;
+		UInt32 s2 = adler >> 16;
+		std::size_t blocks = n/BLOCK_SIZE;
+
+		const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+		const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i ones = _mm_set1_epi16(1);
+
+		while (blocks > 0)
+		{
+			std::size_t count = ADLER_NMAX/BLOCK_SIZE;
+			if (count > blocks) count = blocks;
+			blocks -= count;
+
+			__m128i vps = _mm_cvtsi32_si128(static_cast<int>(s1*count));
+			__m128i vs1 = _mm_setzero_si128();
+			__m128i vs2 = _mm_cvtsi32_si128(static_cast<int>(s2));
+			for (; count > 0; --count, p += BLOCK_SIZE)
+			{
+				const __m128i bytes1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+				const __m128i bytes2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+				vps = _mm_add_epi32(vps, vs1);
+				vs1 = _mm_add_epi32(vs1, _mm_sad_epu8(bytes1, zero));
+				vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+				vs1 = _mm_add_epi32(vs1, _mm_sad_epu8(bytes2, zero));
+				vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+			}
+			vs2 = _mm_add_epi32(vs2, _mm_slli_epi32(vps, 5));
+
+			vs1 = _mm_add_epi32(vs1, _mm_shuffle_epi32(vs1, _MM_SHUFFLE(2, 3, 0, 1)));
+			vs1 = _mm_add_epi32(vs1, _mm_shuffle_epi32(vs1, _MM_SHUFFLE(1, 0, 3, 2)));
+			s1 += static_cast<UInt32>(_mm_cvtsi128_si32(vs1));
+			vs2 = _mm_add_epi32(vs2, _mm_shuffle_epi32(vs2, _MM_SHUFFLE(2, 3, 0, 1)));
+			vs2 = _mm_add_epi32(vs2, _mm_shuffle_epi32(vs2, _MM_SHUFFLE(1, 0, 3, 2)));
+			s2 = static_cast<UInt32>(_mm_cvtsi128_si32(vs2));
+
+			s1 %= ADLER_BASE;
+			s2 %= ADLER_BASE;
+		}
+		return s1 | (s2 << 16);
+	}
+
+
+#elif defined(POCO_CHECKSUM_ARM)
+
+
+	UInt32 crcARM(UInt32 crc, const unsigned char* p, std::size_t n, bool castagnoli)
+		/// Updates the CRC register with the ARMv8 CRC32 instructions.
+	{
+		for (; n >= 8; p += 8, n -= 8)
+		{
+			UInt64 v;
+			std::memcpy(&v, p, 8);
+			crc = castagnoli ? __crc32cd(crc, v) : __crc32d(crc, v);
+		}
+		for (; n > 0; ++p, --n)
+		{
+			crc = castagnoli ? __crc32cb(crc, *p) : __crc32b(crc, *p);
+		}
+		return crc;
+	}
+
+
+#endif
+
+
+	UInt32 updateCRC32(UInt32 crc, const unsigned char* p, std::size_t n)
+	{
+#if defined(POCO_CHECKSUM_X86)
+		static const bool pclmul = CPUFeatures::hasPCLMUL() && CPUFeatures::hasSSE41();
+		if (pclmul && n >= 64)
+		{
+			std::size_t m = n & ~std::size_t(15);
+			crc = crc32PCLMUL(crc, p, m);
+			p += m;
+			n -= m;
+		}
+#elif defined(POCO_CHECKSUM_ARM)
+		return crcARM(crc, p, n, false);
+#endif
+		return crcSlicing(crc32Tables(), crc, p, n);
+	}
+
+
+	UInt32 updateCRC32C(UInt32 crc, const unsigned char* p, std::size_t n)
+	{
+#if defined(POCO_CHECKSUM_X86)
+		static const bool sse42 = CPUFeatures::hasSSE42();
+		if (sse42) return crc32cSSE42(crc, p, n);
+#elif defined(POCO_CHECKSUM_ARM)
+		return crcARM(crc, p, n, true);
+#endif
+		return crcSlicing(crc32cTables(), crc, p, n);
+	}
+
+
+	UInt32 updateAdler32(UInt32 adler, const unsigned char* p, std::size_t n)
+	{
+#if defined(POCO_CHECKSUM_X86)
+		static const bool ssse3 = CPUFeatures::hasSSSE3();
+		if (ssse3 && n >= 64)
+		{
+			std::size_t m = n & ~std::size_t(31);
+			adler = adler32SSSE3(adler, p, m);
+			p += m;
+			n -= m;
+		}
+#endif
+		return static_cast<UInt32>(adler32(adler, p, static_cast<uInt>(n)));
+	}
+
+
+	UInt32 combineAdler32(UInt32 adler1, UInt32 adler2, UInt64 length2)
+	{
+		UInt32 rem = static_cast<UInt32>(length2 % ADLER_BASE);
+		UInt32 sum1 = adler1 & 0xFFFF;
+		UInt32 sum2 = (rem*sum1) % ADLER_BASE;
+		sum1 += (adler2 & 0xFFFF) + ADLER_BASE - 1;
+		sum2 += (adler1 >> 16) + (adler2 >> 16) + ADLER_BASE - rem;
+		if (sum1 >= ADLER_BASE) sum1 -= ADLER_BASE;
+		if (sum1 >= ADLER_BASE) sum1 -= ADLER_BASE;
+		if (sum2 >= (ADLER_BASE << 1)) sum2 -= (ADLER_BASE << 1);
+		if (sum2 >= ADLER_BASE) sum2 -= ADLER_BASE;
+		return sum1 | (sum2 << 16);
+	}
+}
+
+
 Checksum::Checksum():
 	_type(TYPE_CRC32),
 	_value(crc32(0L, Z_NULL, 0))
@@ -34,10 +411,10 @@ Checksum::Checksum(Type t):
 	_type(t),
 	_value(0)
 {
-	if (t == TYPE_CRC32)
-		_value = crc32(0L, Z_NULL, 0);
-	else
+	if (t == TYPE_ADLER32)
 		_value = adler32(0L, Z_NULL, 0);
+	else
+		_value = crc32(0L, Z_NULL, 0);
 }
 
 
@@ -48,10 +425,34 @@ Checksum::~Checksum()
 
 void Checksum::update(const char* data, unsigned length)
 {
-	if (_type == TYPE_ADLER32)
-		_value = adler32(_value, reinterpret_cast<const Bytef*>(data), length);
-	else
-		_value = crc32(_value, reinterpret_cast<const Bytef*>(data), length);
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+	switch (_type)
+	{
+	case TYPE_ADLER32:
+		_value = updateAdler32(_value, p, length);
+		break;
+	case TYPE_CRC32:
+		_value = ~updateCRC32(~_value, p, length);
+		break;
+	case TYPE_CRC32C:
+		_value = ~updateCRC32C(~_value, p, length);
+		break;
+	}
+}
+
+
+UInt32 Checksum::combine(Type t, UInt32 checksum1, UInt32 checksum2, UInt64 length2)
+{
+	switch (t)
+	{
+	case TYPE_ADLER32:
+		return combineAdler32(checksum1, checksum2, length2);
+	case TYPE_CRC32:
+		return crc32Tables().multiply(crc32Tables().shift(length2), checksum1) ^ checksum2;
+	case TYPE_CRC32C:
+		return crc32cTables().multiply(crc32cTables().shift(length2), checksum1) ^ checksum2;
+	}
+	return 0;
 }
 
 
@@ -0,0 +1,104 @@
+//
+// CoarseClock.cpp
+//
+// Library: Foundation
+// Package: DateTime
+// Module:  CoarseClock
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "lucid/CoarseClock.h"
+#include "lucid/DateTimeFormatter.h"
+#include "lucid/DateTimeFormat.h"
+#include "lucid/Exception.h"
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <time.h>
+#endif
+
+
+#if defined(CLOCK_REALTIME_COARSE) && defined(CLOCK_MONOTONIC_COARSE)
+	#define POCO_HAVE_COARSE_CLOCK
+#endif
+
+
+namespace Lucid {
+
+
+namespace
+{
+	struct HTTPDateCache
+	{
+		HTTPDateCache():
+			second(0),
+			valid(false)
+		{
+		}
+
+		std::time_t second;
+		bool valid;
+		std::string date;
+	};
+
+	thread_local HTTPDateCache httpDateCache;
+}
+
+
+Timestamp CoarseClock::now()
+{
+#if defined(POCO_HAVE_COARSE_CLOCK)
+	struct timespec ts;
+	if (clock_gettime(CLOCK_REALTIME_COARSE, &ts))
+		throw SystemException("cannot get coarse system time");
+	return Timestamp(Timestamp::TimeVal(ts.tv_sec)*Timestamp::resolution() + ts.tv_nsec/1000);
+#else
+	return Timestamp();
+#endif
+}
+
+
+Clock CoarseClock::clock()
+{
+#if defined(POCO_HAVE_COARSE_CLOCK)
+	struct timespec ts;
+	if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts))
+		throw SystemException("cannot get coarse system clock");
+	return Clock(Clock::ClockVal(ts.tv_sec)*Clock::resolution() + ts.tv_nsec/1000);
+#else
+	return Clock();
+#endif
+}
+
+
+Timestamp::TimeDiff CoarseClock::resolution()
+{
+#if defined(POCO_HAVE_COARSE_CLOCK)
+	struct timespec ts;
+	if (clock_getres(CLOCK_REALTIME_COARSE, &ts))
+		throw SystemException("cannot get coarse system time resolution");
+	Timestamp::TimeDiff res = Timestamp::TimeDiff(ts.tv_sec)*Timestamp::resolution() + ts.tv_nsec/1000;
+	return res > 0 ? res : 1;
+#else
+	return 1;
+#endif
+}
+
+
+const std::string& CoarseClock::httpDate()
+{
+	std::time_t second = now().epochTime();
+	HTTPDateCache& cache = httpDateCache;
+	if (!cache.valid || cache.second != second)
+	{
+		cache.date = DateTimeFormatter::format(Timestamp::fromEpochTime(second), DateTimeFormat::HTTP_FORMAT);
+		cache.second = second;
+		cache.valid = true;
+	}
+	return cache.date;
+}
+
+
+} // namespace Lucid
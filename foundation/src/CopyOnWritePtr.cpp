@@ -0,0 +1,147 @@
+//
+// CopyOnWritePtr.cpp
+//
+// Library: Foundation
+// Package: Core
+// Module:  CopyOnWritePtr
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "lucid/CopyOnWritePtr.h"
+
+
+namespace Lucid {
+namespace Impl {
+
+
+namespace
+{
+	struct HazardRecord
+		/// A set of hazard slots owned by one thread. Records are
+		/// never deleted, but reused once their thread has terminated.
+	{
+		enum
+		{
+			SLOTS = 8
+		};
+
+		HazardRecord():
+			inUse(true),
+			pNext(0),
+			pNextOwned(0)
+		{
+			for (int i = 0; i < SLOTS; ++i) slots[i].store(0, std::memory_order_relaxed);
+		}
+
+		HazardSlots::Slot slots[SLOTS];
+		std::atomic<bool> inUse;
+		HazardRecord* pNext;      /// next record in the registry, immutable once published
+		HazardRecord* pNextOwned; /// next record of the owning thread, used for nested ReadGuards
+		char pad[64];             /// keeps records of different threads on different cache lines
+	};
+
+	std::atomic<HazardRecord*> registry(0);
+
+	HazardRecord* claimRecord()
+	{
+		for (HazardRecord* pRec = registry.load(std::memory_order_acquire); pRec; pRec = pRec->pNext)
+		{
+			bool inUse = false;
+			if (!pRec->inUse.load(std::memory_order_relaxed) && pRec->inUse.compare_exchange_strong(inUse, true))
+			{
+				pRec->pNextOwned = 0;
+				return pRec;
+			}
+		}
+
+		HazardRecord* pRec = new HazardRecord;
+		HazardRecord* pHead = registry.load(std::memory_order_relaxed);
+		do
+		{
+			pRec->pNext = pHead;
+		}
+		while (!registry.compare_exchange_weak(pHead, pRec, std::memory_order_release, std::memory_order_relaxed));
+		return pRec;
+	}
+
+	struct ThreadRecords
+		/// Returns the records of a thread to the registry
+		/// when the thread terminates.
+	{
+		ThreadRecords():
+			pFirst(0)
+		{
+		}
+
+		~ThreadRecords();
+
+		HazardRecord* pFirst;
+	};
+
+	thread_local ThreadRecords threadRecords;
+
+	// ReadGuards created after the thread's ThreadRecords have been
+	// destroyed (e.g., by static destructors) use a record that is
+	// never returned to the registry.
+	thread_local bool threadExited = false;
+	thread_local HazardRecord* pExitRecord = 0;
+
+	ThreadRecords::~ThreadRecords()
+	{
+		for (HazardRecord* pRec = pFirst; pRec; pRec = pRec->pNextOwned)
+		{
+			pRec->inUse.store(false, std::memory_order_release);
+		}
+		pFirst = 0;
+		threadExited = true;
+	}
+}
+
+
+HazardSlots::Slot* HazardSlots::acquire()
+{
+	HazardRecord* pRec;
+	if (!threadExited)
+	{
+		pRec = threadRecords.pFirst;
+		if (!pRec) pRec = threadRecords.pFirst = claimRecord();
+	}
+	else
+	{
+		if (!pExitRecord) pExitRecord = claimRecord();
+		pRec = pExitRecord;
+	}
+
+	for (;;)
+	{
+		// Only the owning thread stores non-null pointers,
+		// so a slot found empty here stays free.
+		for (int i = 0; i < HazardRecord::SLOTS; ++i)
+		{
+			if (!pRec->slots[i].load(std::memory_order_relaxed)) return &pRec->slots[i];
+		}
+		if (!pRec->pNextOwned) pRec->pNextOwned = claimRecord();
+		pRec = pRec->pNextOwned;
+	}
+}
+
+
+void HazardSlots::collect(std::vector<const void*>& hazards)
+{
+	for (HazardRecord* pRec = registry.load(std::memory_order_acquire); pRec; pRec = pRec->pNext)
+	{
+		for (int i = 0; i < HazardRecord::SLOTS; ++i)
+		{
+			const void* p = pRec->slots[i].load();
+			if (p) hazards.push_back(p);
+		}
+	}
+	std::sort(hazards.begin(), hazards.end());
+}
+
+
+} } // namespace Lucid::Impl
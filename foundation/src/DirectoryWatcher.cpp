@@ -27,6 +27,8 @@
 #if POCO_OS == POCO_OS_LINUX || POCO_OS == POCO_OS_ANDROID
 	#include <sys/inotify.h>
 	#include <sys/select.h>
+	#include <sys/stat.h>
+	#include <dirent.h>
 	#include <unistd.h>
 #elif POCO_OS == POCO_OS_MAC_OS_X || POCO_OS == POCO_OS_FREE_BSD
 	#include <fcntl.h>
@@ -40,6 +42,7 @@
 #endif
 #include <algorithm>
 #include <map>
+#include <vector>
 
 
 namespace Lucid {
@@ -107,6 +110,7 @@ protected:
 	
 	void compare(ItemInfoMap& oldEntries, ItemInfoMap& newEntries)
 	{
+		DirectoryWatcher::DirectoryChangeList changes;
 		for (auto& np: newEntries)
 		{
 			ItemInfoMap::iterator ito = oldEntries.find(np.first);
@@ -117,8 +121,7 @@ protected:
 					if (np.second.size != ito->second.size || np.second.lastModified != ito->second.lastModified)
 					{
 						Lucid::File f(np.second.path);
-						DirectoryWatcher::DirectoryEvent ev(f, DirectoryWatcher::DW_ITEM_MODIFIED);
-						owner().itemModified(&owner(), ev);
+						notifyItem(f, DirectoryWatcher::DW_ITEM_MODIFIED, changes);
 					}
 				}
 				oldEntries.erase(ito);
@@ -126,8 +129,7 @@ protected:
 			else if ((owner().eventMask() & DirectoryWatcher::DW_ITEM_ADDED) && !owner().eventsSuspended())
 			{
 				Lucid::File f(np.second.path);
-				DirectoryWatcher::DirectoryEvent ev(f, DirectoryWatcher::DW_ITEM_ADDED);
-				owner().itemAdded(&owner(), ev);
+				notifyItem(f, DirectoryWatcher::DW_ITEM_ADDED, changes);
 			}
 		}
 		if ((owner().eventMask() & DirectoryWatcher::DW_ITEM_REMOVED) && !owner().eventsSuspended())
@@ -135,10 +137,51 @@ protected:
 			for (const auto& i: oldEntries)
 			{
 				Lucid::File f(i.second.path);
-				DirectoryWatcher::DirectoryEvent ev(f, DirectoryWatcher::DW_ITEM_REMOVED);
+				notifyItem(f, DirectoryWatcher::DW_ITEM_REMOVED, changes);
+			}
+		}
+		notifyChanges(changes);
+	}
+
+	void notifyItem(const File& f, DirectoryWatcher::DirectoryEventType type, DirectoryWatcher::DirectoryChangeList& changes)
+		/// Fires the event for a single item, unless only batches are
+		/// reported, and adds the change to changes, if anyone is
+		/// interested in batches.
+	{
+		if (!owner().batchOnly())
+		{
+			DirectoryWatcher::DirectoryEvent ev(f, type);
+			switch (type)
+			{
+			case DirectoryWatcher::DW_ITEM_ADDED:
+				owner().itemAdded(&owner(), ev);
+				break;
+			case DirectoryWatcher::DW_ITEM_REMOVED:
 				owner().itemRemoved(&owner(), ev);
+				break;
+			case DirectoryWatcher::DW_ITEM_MODIFIED:
+				owner().itemModified(&owner(), ev);
+				break;
+			case DirectoryWatcher::DW_ITEM_MOVED_FROM:
+				owner().itemMovedFrom(&owner(), ev);
+				break;
+			case DirectoryWatcher::DW_ITEM_MOVED_TO:
+				owner().itemMovedTo(&owner(), ev);
+				break;
 			}
 		}
+		if (!owner().itemsChanged.empty())
+		{
+			changes.push_back(DirectoryWatcher::DirectoryChange(f, type));
+		}
+	}
+
+	void notifyChanges(const DirectoryWatcher::DirectoryChangeList& changes)
+	{
+		if (!changes.empty())
+		{
+			owner().itemsChanged(&owner(), changes);
+		}
 	}
 
 private:
@@ -257,10 +300,14 @@ public:
 	LinuxDirectoryWatcherStrategy(DirectoryWatcher& owner):
 		DirectoryWatcherStrategy(owner),
 		_fd(-1),
+		_mask(0),
 		_stopped(false)
 	{
 		_fd = inotify_init();
 		if (_fd == -1) throw Lucid::IOException("cannot initialize inotify", errno);
+
+		_root = owner.directory().path();
+		while (_root.size() > 1 && _root[_root.size() - 1] == '/') _root.resize(_root.size() - 1);
 	}
 	
 	~LinuxDirectoryWatcherStrategy()
@@ -270,93 +317,55 @@ public:
 	
 	void run()
 	{
-		int mask = 0;
 		if (owner().eventMask() & DirectoryWatcher::DW_ITEM_ADDED)
-			mask |= IN_CREATE;
+			_mask |= IN_CREATE;
 		if (owner().eventMask() & DirectoryWatcher::DW_ITEM_REMOVED)
-			mask |= IN_DELETE;
+			_mask |= IN_DELETE;
 		if (owner().eventMask() & DirectoryWatcher::DW_ITEM_MODIFIED)
-			mask |= IN_MODIFY;
+			_mask |= IN_MODIFY;
 		if (owner().eventMask() & DirectoryWatcher::DW_ITEM_MOVED_FROM)
-			mask |= IN_MOVED_FROM;
+			_mask |= IN_MOVED_FROM;
 		if (owner().eventMask() & DirectoryWatcher::DW_ITEM_MOVED_TO)
-			mask |= IN_MOVED_TO;
-		int wd = inotify_add_watch(_fd, owner().directory().path().c_str(), mask);
-		if (wd == -1)
-		{
-			try
-			{
-				FileImpl::handleLastErrorImpl(owner().directory().path());
-			}
-			catch (Lucid::Exception& exc)
-			{
-				owner().scanError(&owner(), exc);
-			}
-		}
-		
-		Lucid::Buffer<char> buffer(4096);
+			_mask |= IN_MOVED_TO;
+		if (owner().recursive())
+			_mask |= IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+
+		_started.update();
+		addTree(_root, _snapshot, false);
+
+		Lucid::Buffer<char> buffer(BUFFER_SIZE);
 		while (!_stopped)
 		{
 			fd_set fds;
 			FD_ZERO(&fds);
 			FD_SET(_fd, &fds);
 
+			Lucid::Timestamp::TimeDiff timeout = 200000;
+			if (!_pending.empty())
+			{
+				Lucid::Timestamp::TimeDiff remaining = _deadline - Lucid::Timestamp();
+				if (remaining < timeout) timeout = remaining > 0 ? remaining : 0;
+			}
 			struct timeval tv;
 			tv.tv_sec  = 0;
-			tv.tv_usec = 200000;
+			tv.tv_usec = static_cast<long>(timeout);
 
 			if (select(_fd + 1, &fds, NULL, NULL, &tv) == 1)
 			{
 				int n = read(_fd, buffer.begin(), buffer.size());
 				int i = 0;
-				if (n > 0)
+				while (n > 0)
 				{
-					while (n > 0)
-					{
-						struct inotify_event* pEvent = reinterpret_cast<struct inotify_event*>(buffer.begin() + i);
-						
-						if (pEvent->len > 0)
-						{						
-							if (!owner().eventsSuspended())
-							{
-								Lucid::Path p(owner().directory().path());
-								p.makeDirectory();
-								p.setFileName(pEvent->name);
-								Lucid::File f(p.toString());
-	
-								if ((pEvent->mask & IN_CREATE) && (owner().eventMask() & DirectoryWatcher::DW_ITEM_ADDED))
-								{
-									DirectoryWatcher::DirectoryEvent ev(f, DirectoryWatcher::DW_ITEM_ADDED);
-									owner().itemAdded(&owner(), ev);
-								}
-								if ((pEvent->mask & IN_DELETE) && (owner().eventMask() & DirectoryWatcher::DW_ITEM_REMOVED))
-								{
-									DirectoryWatcher::DirectoryEvent ev(f, DirectoryWatcher::DW_ITEM_REMOVED);
-									owner().itemRemoved(&owner(), ev);
-								}
-								if ((pEvent->mask & IN_MODIFY) && (owner().eventMask() & DirectoryWatcher::DW_ITEM_MODIFIED))
-								{
-									DirectoryWatcher::DirectoryEvent ev(f, DirectoryWatcher::DW_ITEM_MODIFIED);
-									owner().itemModified(&owner(), ev);
-								}
-								if ((pEvent->mask & IN_MOVED_FROM) && (owner().eventMask() & DirectoryWatcher::DW_ITEM_MOVED_FROM))
-								{
-									DirectoryWatcher::DirectoryEvent ev(f, DirectoryWatcher::DW_ITEM_MOVED_FROM);
-									owner().itemMovedFrom(&owner(), ev);
-								}
-								if ((pEvent->mask & IN_MOVED_TO) && (owner().eventMask() & DirectoryWatcher::DW_ITEM_MOVED_TO))
-								{
-									DirectoryWatcher::DirectoryEvent ev(f, DirectoryWatcher::DW_ITEM_MOVED_TO);
-									owner().itemMovedTo(&owner(), ev);
-								}
-							}
-						}
-						
-						i += sizeof(inotify_event) + pEvent->len;
-						n -= sizeof(inotify_event) + pEvent->len;
-					}
+					const struct inotify_event* pEvent = reinterpret_cast<const struct inotify_event*>(buffer.begin() + i);
+					handleEvent(pEvent);
+					i += sizeof(inotify_event) + pEvent->len;
+					n -= sizeof(inotify_event) + pEvent->len;
 				}
 			}
+			if (!_pending.empty() && (owner().coalesceWindow() == 0 || _deadline <= Lucid::Timestamp()))
+			{
+				flush();
+			}
 		}
 	}
 	
@@ -371,8 +380,369 @@ public:
 	}
 
 private:
+	enum
+	{
+		BUFFER_SIZE = 65536
+	};
+
+	struct Entry
+	{
+		File::FileSize size;
+		Timestamp lastModified;
+		bool isDirectory;
+		bool hasStat; /// false if size and lastModified are not known yet
+	};
+	typedef std::map<std::string, Entry> Snapshot;
+	typedef std::map<int, std::string> WatchMap;
+	typedef std::map<std::string, int> PathMap;
+
+	struct Change
+	{
+		Change(const std::string& p, DirectoryWatcher::DirectoryEventType ev):
+			path(p),
+			event(ev),
+			cancelled(false)
+		{
+		}
+
+		std::string path;
+		DirectoryWatcher::DirectoryEventType event;
+		bool cancelled;
+	};
+	typedef std::vector<Change> ChangeVec;
+	typedef std::map<std::string, std::size_t> ChangeIndex;
+
+	void handleEvent(const struct inotify_event* pEvent)
+	{
+		if (pEvent->mask & IN_Q_OVERFLOW)
+		{
+			rescan();
+			return;
+		}
+		if (pEvent->mask & IN_IGNORED)
+		{
+			removeWatch(pEvent->wd);
+			return;
+		}
+		if (pEvent->len == 0) return;
+
+		WatchMap::const_iterator it = _watches.find(pEvent->wd);
+		if (it == _watches.end()) return;
+
+		std::string path(it->second);
+		path += '/';
+		path += pEvent->name;
+
+		if (pEvent->mask & IN_CREATE)
+			record(path, DirectoryWatcher::DW_ITEM_ADDED);
+		if (pEvent->mask & IN_DELETE)
+			record(path, DirectoryWatcher::DW_ITEM_REMOVED);
+		if (pEvent->mask & IN_MODIFY)
+			record(path, DirectoryWatcher::DW_ITEM_MODIFIED);
+		if (pEvent->mask & IN_MOVED_FROM)
+			record(path, DirectoryWatcher::DW_ITEM_MOVED_FROM);
+		if (pEvent->mask & IN_MOVED_TO)
+			record(path, DirectoryWatcher::DW_ITEM_MOVED_TO);
+
+		if ((pEvent->mask & IN_ISDIR) && owner().recursive())
+		{
+			if (pEvent->mask & (IN_DELETE | IN_MOVED_FROM))
+				removeTree(path);
+			if (pEvent->mask & (IN_CREATE | IN_MOVED_TO))
+				addTree(path, _snapshot, true);
+		}
+	}
+
+	void record(const std::string& path, DirectoryWatcher::DirectoryEventType event)
+		/// Adds a change to the current batch. If a coalescing window
+		/// has been specified, a change to an item that already has
+		/// a pending change is combined with the pending change.
+	{
+		if (_pending.empty())
+		{
+			_deadline.update();
+			_deadline += static_cast<Lucid::Timestamp::TimeDiff>(owner().coalesceWindow())*1000;
+		}
+		if (owner().coalesceWindow() > 0)
+		{
+			ChangeIndex::iterator it = _index.find(path);
+			if (it != _index.end())
+			{
+				Change& change = _pending[it->second];
+				if (isReplacement(change.event, event) && !(owner().eventMask() & DirectoryWatcher::DW_ITEM_MODIFIED))
+				{
+					// a replaced item cannot be reported as modified,
+					// so report the removal and the addition
+					it->second = _pending.size();
+					_pending.push_back(Change(path, event));
+					return;
+				}
+				int net = coalesce(change.event, event);
+				if (net)
+				{
+					change.event = static_cast<DirectoryWatcher::DirectoryEventType>(net);
+				}
+				else
+				{
+					change.cancelled = true;
+					_index.erase(it);
+				}
+				return;
+			}
+			_index[path] = _pending.size();
+		}
+		_pending.push_back(Change(path, event));
+	}
+
+	static int coalesce(int pending, int event)
+		/// Returns the net change of an item with the given pending
+		/// change and a subsequent event, or 0 if the item is
+		/// effectively unchanged.
+	{
+		switch (event)
+		{
+		case DirectoryWatcher::DW_ITEM_REMOVED:
+		case DirectoryWatcher::DW_ITEM_MOVED_FROM:
+			if (pending == DirectoryWatcher::DW_ITEM_ADDED || pending == DirectoryWatcher::DW_ITEM_MOVED_TO)
+				return 0;
+			return event;
+		case DirectoryWatcher::DW_ITEM_ADDED:
+		case DirectoryWatcher::DW_ITEM_MOVED_TO:
+			if (isReplacement(pending, event))
+				return DirectoryWatcher::DW_ITEM_MODIFIED;
+			return event;
+		default:
+			return pending;
+		}
+	}
+
+	static bool isReplacement(int pending, int event)
+		/// Returns true if the given event adds an item
+		/// that has a pending removal.
+	{
+		return (event == DirectoryWatcher::DW_ITEM_ADDED || event == DirectoryWatcher::DW_ITEM_MOVED_TO)
+			&& (pending == DirectoryWatcher::DW_ITEM_REMOVED || pending == DirectoryWatcher::DW_ITEM_MOVED_FROM);
+	}
+
+	void flush()
+		/// Updates the snapshot with the pending changes
+		/// and reports them.
+	{
+		DirectoryWatcher::DirectoryChangeList changes;
+		for (ChangeVec::const_iterator it = _pending.begin(); it != _pending.end(); ++it)
+		{
+			if (it->cancelled) continue;
+
+			switch (it->event)
+			{
+			case DirectoryWatcher::DW_ITEM_REMOVED:
+			case DirectoryWatcher::DW_ITEM_MOVED_FROM:
+				_snapshot.erase(it->path);
+				break;
+			default:
+				{
+					Entry entry;
+					if (statItem(it->path, entry))
+						_snapshot[it->path] = entry;
+					else
+						_snapshot.erase(it->path);
+				}
+				break;
+			}
+
+			if ((owner().eventMask() & it->event) && !owner().eventsSuspended())
+			{
+				Lucid::File f(it->path);
+				notifyItem(f, it->event, changes);
+			}
+		}
+		_pending.clear();
+		_index.clear();
+		notifyChanges(changes);
+	}
+
+	void rescan()
+		/// Called when the event queue has overflowed and events have
+		/// been lost. Scans the directory again, registers any new
+		/// subdirectories, and records all differences to the snapshot.
+	{
+		flush();
+
+		Snapshot snapshot;
+		WatchMap watches;
+		watches.swap(_watches);
+		_paths.clear();
+		addTree(_root, snapshot, false);
+		for (WatchMap::const_iterator it = watches.begin(); it != watches.end(); ++it)
+		{
+			if (_watches.find(it->first) == _watches.end())
+				inotify_rm_watch(_fd, it->first);
+		}
+
+		Snapshot::const_iterator ito = _snapshot.begin();
+		Snapshot::const_iterator itn = snapshot.begin();
+		while (ito != _snapshot.end() || itn != snapshot.end())
+		{
+			if (itn == snapshot.end() || (ito != _snapshot.end() && ito->first < itn->first))
+			{
+				record(ito->first, DirectoryWatcher::DW_ITEM_REMOVED);
+				++ito;
+			}
+			else if (ito == _snapshot.end() || itn->first < ito->first)
+			{
+				record(itn->first, DirectoryWatcher::DW_ITEM_ADDED);
+				++itn;
+			}
+			else
+			{
+				if (!itn->second.isDirectory)
+				{
+					// Items only listed by the initial scan have no metadata
+					// to compare with. They count as modified if they have
+					// been modified after the watcher was started.
+					Entry& entry = snapshot[itn->first];
+					if (statItem(itn->first, entry) && !entry.isDirectory &&
+						(ito->second.hasStat ? (entry.size != ito->second.size || entry.lastModified != ito->second.lastModified) : entry.lastModified >= _started))
+					{
+						record(itn->first, DirectoryWatcher::DW_ITEM_MODIFIED);
+					}
+				}
+				++ito;
+				++itn;
+			}
+		}
+		_snapshot.swap(snapshot);
+	}
+
+	void addTree(const std::string& root, Snapshot& snapshot, bool report)
+		/// Adds a watch for the directory at root and, in recursive mode,
+		/// for all its subdirectories, and adds all items found to the
+		/// snapshot. Items are not stat()ed unless the file system does
+		/// not report their type. If report is true, the items are also
+		/// recorded as added, as they may have been created before the
+		/// watch was in place.
+	{
+		std::vector<std::string> dirs(1, root);
+		while (!dirs.empty())
+		{
+			std::string dir;
+			dir.swap(dirs.back());
+			dirs.pop_back();
+			if (!addWatch(dir)) continue;
+
+			DIR* pDir = opendir(dir.c_str());
+			if (!pDir) continue;
+			struct dirent* pEntry;
+			while ((pEntry = readdir(pDir)))
+			{
+				const char* name = pEntry->d_name;
+				if (name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0))) continue;
+
+				std::string path(dir);
+				path += '/';
+				path += name;
+				Entry entry;
+				if (pEntry->d_type != DT_UNKNOWN)
+				{
+					entry.size = 0;
+					entry.isDirectory = pEntry->d_type == DT_DIR;
+					entry.hasStat = false;
+				}
+				else if (!statItem(path, entry)) continue;
+				snapshot[path] = entry;
+				if (report) record(path, DirectoryWatcher::DW_ITEM_ADDED);
+				if (entry.isDirectory && owner().recursive()) dirs.push_back(path);
+			}
+			closedir(pDir);
+		}
+	}
+
+	void removeTree(const std::string& root)
+		/// Removes the watches for all directories in and below root,
+		/// and removes the items below root from the snapshot.
+	{
+		std::string prefix(root);
+		prefix += '/';
+		std::string end(root);
+		end += static_cast<char>('/' + 1);
+
+		PathMap::iterator it = _paths.find(root);
+		if (it != _paths.end())
+		{
+			inotify_rm_watch(_fd, it->second);
+			_watches.erase(it->second);
+			_paths.erase(it);
+		}
+		it = _paths.lower_bound(prefix);
+		while (it != _paths.end() && it->first < end)
+		{
+			inotify_rm_watch(_fd, it->second);
+			_watches.erase(it->second);
+			_paths.erase(it++);
+		}
+		_snapshot.erase(_snapshot.lower_bound(prefix), _snapshot.lower_bound(end));
+	}
+
+	bool addWatch(const std::string& dir)
+	{
+		int wd = inotify_add_watch(_fd, dir.c_str(), _mask);
+		if (wd == -1)
+		{
+			if (errno != ENOENT && errno != ENOTDIR)
+			{
+				try
+				{
+					FileImpl::handleLastErrorImpl(dir);
+				}
+				catch (Lucid::Exception& exc)
+				{
+					owner().scanError(&owner(), exc);
+				}
+			}
+			return false;
+		}
+
+		// A directory that has been moved keeps its watch.
+		WatchMap::iterator it = _watches.find(wd);
+		if (it != _watches.end()) _paths.erase(it->second);
+		_watches[wd] = dir;
+		_paths[dir] = wd;
+		return true;
+	}
+
+	void removeWatch(int wd)
+	{
+		WatchMap::iterator it = _watches.find(wd);
+		if (it != _watches.end())
+		{
+			_paths.erase(it->second);
+			_watches.erase(it);
+		}
+	}
+
+	static bool statItem(const std::string& path, Entry& entry)
+	{
+		struct stat st;
+		if (::lstat(path.c_str(), &st) != 0) return false;
+
+		entry.isDirectory = S_ISDIR(st.st_mode);
+		entry.size = S_ISREG(st.st_mode) ? st.st_size : 0;
+		entry.lastModified = Timestamp(static_cast<Timestamp::TimeVal>(st.st_mtim.tv_sec)*Timestamp::resolution() + st.st_mtim.tv_nsec/1000);
+		entry.hasStat = true;
+		return true;
+	}
+
 	int _fd;
+	int _mask;
 	bool _stopped;
+	std::string _root;
+	WatchMap _watches;
+	PathMap _paths;
+	Snapshot _snapshot;
+	ChangeVec _pending;
+	ChangeIndex _index;
+	Lucid::Timestamp _deadline;
+	Lucid::Timestamp _started;
 };
 
 
@@ -515,7 +885,9 @@ private:
 DirectoryWatcher::DirectoryWatcher(const std::string& path, int eventMask, int scanInterval):
 	_directory(path),
 	_eventMask(eventMask),
-	_scanInterval(scanInterval)
+	_scanInterval(scanInterval),
+	_options(0),
+	_coalesceWindow(0)
 {
 	init();
 }
@@ -524,7 +896,31 @@ DirectoryWatcher::DirectoryWatcher(const std::string& path, int eventMask, int s
 DirectoryWatcher::DirectoryWatcher(const Lucid::File& directory, int eventMask, int scanInterval):
 	_directory(directory),
 	_eventMask(eventMask),
-	_scanInterval(scanInterval)
+	_scanInterval(scanInterval),
+	_options(0),
+	_coalesceWindow(0)
+{
+	init();
+}
+
+
+DirectoryWatcher::DirectoryWatcher(const std::string& path, int eventMask, int scanInterval, int options, long coalesceWindow):
+	_directory(path),
+	_eventMask(eventMask),
+	_scanInterval(scanInterval),
+	_options(options),
+	_coalesceWindow(coalesceWindow)
+{
+	init();
+}
+
+
+DirectoryWatcher::DirectoryWatcher(const Lucid::File& directory, int eventMask, int scanInterval, int options, long coalesceWindow):
+	_directory(directory),
+	_eventMask(eventMask),
+	_scanInterval(scanInterval),
+	_options(options),
+	_coalesceWindow(coalesceWindow)
 {
 	init();
 }
@@ -566,6 +962,13 @@ void DirectoryWatcher::init()
 	if (!_directory.isDirectory())
 		throw Lucid::InvalidArgumentException("not a directory", _directory.path());
 
+	poco_assert (_coalesceWindow >= 0);
+
+#if (POCO_OS != POCO_OS_LINUX && POCO_OS != POCO_OS_ANDROID) || defined(POCO_DW_FORCE_POLLING)
+	if (recursive())
+		throw Lucid::NotImplementedException("recursive DirectoryWatcher", _directory.path());
+#endif
+
 #if (POCO_OS == POCO_OS_WINDOWS_NT) && !defined(POCO_DW_FORCE_POLLING)
 	_pStrategy = new WindowsDirectoryWatcherStrategy(*this);
 #elif (POCO_OS == POCO_OS_LINUX || POCO_OS == POCO_OS_ANDROID) && !defined(POCO_DW_FORCE_POLLING)
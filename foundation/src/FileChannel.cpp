@@ -24,6 +24,16 @@
 #include "lucid/String.h"
 #include "lucid/Exception.h"
 #include "lucid/Ascii.h"
+#include "lucid/File.h"
+#include "lucid/NumberFormatter.h"
+#include "lucid/ActiveDispatcher.h"
+#include "lucid/ActiveMethod.h"
+#include "lucid/Semaphore.h"
+#include "lucid/ErrorHandler.h"
+#include "lucid/DirectoryIterator.h"
+#include "lucid/Path.h"
+#include <algorithm>
+#include <vector>
 
 
 namespace Lucid {
@@ -38,16 +48,134 @@ const std::string FileChannel::PROP_PURGEAGE     = "purgeAge";
 const std::string FileChannel::PROP_PURGECOUNT   = "purgeCount";
 const std::string FileChannel::PROP_FLUSH        = "flush";
 const std::string FileChannel::PROP_ROTATEONOPEN = "rotateOnOpen";
+const std::string FileChannel::PROP_ASYNCARCHIVE = "asyncArchive";
+
+
+//
+// FileChannel::Archiver
+//
+
+
+class FileChannel::Archiver: public ActiveDispatcher
+	/// Archives rotated log files and purges archived log files
+	/// in the background, one rotation after the other. At most
+	/// BACKLOG rotations can be pending at any time; archive()
+	/// waits until a pending rotation has been completed if
+	/// the backlog is full.
+{
+public:
+	enum
+	{
+		BACKLOG = 8
+	};
+
+	Archiver():
+		process(this, &Archiver::processImpl),
+		_backlog(BACKLOG, BACKLOG)
+	{
+	}
+
+	~Archiver()
+	{
+	}
+
+	void archive(const std::string& path, const std::string& rotatedPath, ArchiveStrategy* pArchiveStrategy, PurgeStrategy* pPurgeStrategy)
+	{
+		_backlog.wait();
+		try
+		{
+			Job job = { path, rotatedPath, pArchiveStrategy, pPurgeStrategy };
+			process(job);
+		}
+		catch (...)
+		{
+			_backlog.set();
+			throw;
+		}
+	}
+
+	void wait()
+		/// Waits until all pending rotations have been completed.
+	{
+		for (int i = 0; i < BACKLOG; ++i) _backlog.wait();
+		for (int i = 0; i < BACKLOG; ++i) _backlog.set();
+	}
+
+protected:
+	struct Job
+	{
+		std::string path;
+		std::string rotatedPath;
+		ArchiveStrategy* pArchiveStrategy;
+		PurgeStrategy* pPurgeStrategy;
+	};
+
+	ActiveMethod<void, Job, Archiver, ActiveStarter<ActiveDispatcher>> process;
+
+	void processImpl(const Job& job)
+	{
+		// Failures are reported to the ErrorHandler, as there is
+		// no caller to report them to. Purging is done even if
+		// archiving failed.
+		try
+		{
+			job.pArchiveStrategy->archiveFile(job.path, job.rotatedPath);
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+		if (job.pPurgeStrategy)
+		{
+			try
+			{
+				job.pPurgeStrategy->purge(job.path);
+			}
+			catch (Exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (std::exception& exc)
+			{
+				ErrorHandler::handle(exc);
+			}
+			catch (...)
+			{
+				ErrorHandler::handle();
+			}
+		}
+		_backlog.set();
+	}
+
+private:
+	Semaphore _backlog;
+};
+
+
+//
+// FileChannel
+//
+
 
 FileChannel::FileChannel(): 
 	_times("utc"),
 	_compress(false),
 	_flush(true),
 	_rotateOnOpen(false),
+	_asyncArchive(false),
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
-	_pPurgeStrategy(0)
+	_pPurgeStrategy(0),
+	_pArchiver(0)
 {
 }
 
@@ -58,10 +186,12 @@ FileChannel::FileChannel(const std::string& path):
 	_compress(false),
 	_flush(true),
 	_rotateOnOpen(false),
+	_asyncArchive(false),
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
-	_pPurgeStrategy(0)
+	_pPurgeStrategy(0),
+	_pArchiver(0)
 {
 }
 
@@ -71,6 +201,7 @@ FileChannel::~FileChannel()
 	try
 	{
 		close();
+		delete _pArchiver;
 		delete _pRotateStrategy;
 		delete _pArchiveStrategy;
 		delete _pPurgeStrategy;
@@ -89,17 +220,10 @@ void FileChannel::open()
 	if (!_pFile)
 	{
 		_pFile = new LogFile(_path);
+		archivePending();
 		if (_rotateOnOpen && _pFile->size() > 0)
 		{
-			try
-			{
-				_pFile = _pArchiveStrategy->archive(_pFile);
-				purge();
-			}
-			catch (...)
-			{
-				_pFile = new LogFile(_path);
-			}
+			rotate();
 		}
 	}
 }
@@ -111,6 +235,7 @@ void FileChannel::close()
 
 	delete _pFile;
 	_pFile = 0;
+	waitForArchiver();
 }
 
 
@@ -122,15 +247,7 @@ void FileChannel::log(const Message& msg)
 
 	if (_pRotateStrategy && _pArchiveStrategy && _pRotateStrategy->mustRotate(_pFile))
 	{
-		try
-		{
-			_pFile = _pArchiveStrategy->archive(_pFile);
-			purge();
-		}
-		catch (...)
-		{
-			_pFile = new LogFile(_path);
-		}
+		rotate();
 		// we must call mustRotate() again to give the
 		// RotateByIntervalStrategy a chance to write its timestamp
 		// to the new file.
@@ -170,6 +287,8 @@ void FileChannel::setProperty(const std::string& name, const std::string& value)
 		setFlush(value);
 	else if (name == PROP_ROTATEONOPEN)
 		setRotateOnOpen(value);
+	else if (name == PROP_ASYNCARCHIVE)
+		setAsyncArchive(value);
 	else
 		Channel::setProperty(name, value);
 }
@@ -195,6 +314,8 @@ std::string FileChannel::getProperty(const std::string& name) const
 		return std::string(_flush ? "true" : "false");
 	else if (name == PROP_ROTATEONOPEN)
 		return std::string(_rotateOnOpen ? "true" : "false");
+	else if (name == PROP_ASYNCARCHIVE)
+		return std::string(_asyncArchive ? "true" : "false");
 	else
 		return Channel::getProperty(name);
 }
@@ -294,6 +415,7 @@ void FileChannel::setArchive(const std::string& archive)
 			throw PropertyNotSupportedException("times", _times);
 	}
 	else throw InvalidArgumentException("archive", archive);
+	waitForArchiver();
 	delete _pArchiveStrategy;
 	pStrategy->compress(_compress);
 	_pArchiveStrategy = pStrategy;
@@ -304,6 +426,7 @@ void FileChannel::setArchive(const std::string& archive)
 void FileChannel::setCompress(const std::string& compress)
 {
 	_compress = icompare(compress, "true") == 0;
+	waitForArchiver();
 	if (_pArchiveStrategy)
 		_pArchiveStrategy->compress(_compress);
 }
@@ -343,6 +466,125 @@ void FileChannel::setRotateOnOpen(const std::string& rotateOnOpen)
 }
 
 
+void FileChannel::setAsyncArchive(const std::string& asyncArchive)
+{
+	_asyncArchive = icompare(asyncArchive, "true") == 0;
+}
+
+
+void FileChannel::rotate()
+{
+	if (_asyncArchive && _pArchiveStrategy->canArchiveFile())
+	{
+		// Only the rename is done here. Archiving the renamed
+		// file and purging is left to the archiver thread.
+		std::string rotatedPath;
+		try
+		{
+			int n = 0;
+			do
+			{
+				rotatedPath = _path;
+				rotatedPath.append("~");
+				NumberFormatter::append(rotatedPath, n++);
+			}
+			while (File(rotatedPath).exists());
+			delete _pFile;
+			_pFile = 0;
+			File(_path).renameTo(rotatedPath);
+		}
+		catch (...)
+		{
+			rotatedPath.clear();
+		}
+		if (!_pFile) _pFile = new LogFile(_path);
+		if (!rotatedPath.empty()) archiveRotated(rotatedPath);
+	}
+	else
+	{
+		try
+		{
+			_pFile = _pArchiveStrategy->archive(_pFile);
+			purge();
+		}
+		catch (...)
+		{
+			_pFile = new LogFile(_path);
+		}
+	}
+}
+
+
+void FileChannel::archivePending()
+{
+	// Log files renamed for background archiving by a previous
+	// run that did not get to archive them (e.g., because the
+	// process crashed) have names like "access.log~0".
+	if (!_pArchiveStrategy || !_pArchiveStrategy->canArchiveFile()) return;
+
+	std::vector<File> files;
+	try
+	{
+		Path p(_path);
+		p.makeAbsolute();
+		std::string prefix = p.getFileName();
+		prefix.append("~");
+
+		DirectoryIterator it(p.parent());
+		DirectoryIterator end;
+		while (it != end)
+		{
+			const std::string& name = it.name();
+			if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0 &&
+				std::find_if(name.begin() + prefix.size(), name.end(), [](char c) { return !Ascii::isDigit(c); }) == name.end())
+			{
+				files.push_back(*it);
+			}
+			++it;
+		}
+
+		// archive the oldest file first, so that it ends up
+		// with the highest number or oldest timestamp
+		std::sort(files.begin(), files.end(), [](const File& f1, const File& f2) { return f1.getLastModified() < f2.getLastModified(); });
+	}
+	catch (...)
+	{
+		return;
+	}
+	for (const auto& f: files)
+	{
+		archiveRotated(f.path());
+	}
+}
+
+
+void FileChannel::archiveRotated(const std::string& rotatedPath)
+{
+	if (_asyncArchive)
+	{
+		if (!_pArchiver) _pArchiver = new Archiver;
+		_pArchiver->archive(_path, rotatedPath, _pArchiveStrategy, _pPurgeStrategy);
+	}
+	else
+	{
+		try
+		{
+			_pArchiveStrategy->archiveFile(_path, rotatedPath);
+		}
+		catch (...)
+		{
+		}
+		purge();
+	}
+}
+
+
+void FileChannel::waitForArchiver()
+{
+	if (_pArchiver) _pArchiver->wait();
+}
+
+
 void FileChannel::purge()
 {
 	if (_pPurgeStrategy)
@@ -362,6 +604,7 @@ bool FileChannel::setNoPurge(const std::string& value)
 {
 	if (value.empty() || 0 == icompare(value, "none"))
 	{
+		waitForArchiver();
 		delete _pPurgeStrategy;
 		_pPurgeStrategy = 0;
 		_purgeAge = "none";
@@ -394,6 +637,7 @@ int FileChannel::extractDigit(const std::string& value, std::string::const_itera
 
 void FileChannel::setPurgeStrategy(PurgeStrategy* strategy)
 {
+	waitForArchiver();
 	delete _pPurgeStrategy;
 	_pPurgeStrategy = strategy;
 }
@@ -13,21 +13,159 @@
 
 
 #include "lucid/Hash.h"
+#include "lucid/ByteOrder.h"
+#include "lucid/RandomStream.h"
+#include <cstring>
 
 
 namespace Lucid {
 
 
+namespace
+{
+	// The constants and the structure of hash64() follow wyhash
+	// by Wang Yi (https://github.com/wangyi-fudan/wyhash),
+	// which has been released into the public domain.
+
+	const UInt64 SECRET[4] =
+	{
+		0xA0761D6478BD642FULL,
+		0xE7037ED1A0B428DBULL,
+		0x8EBC6AF09C88C6E3ULL,
+		0x589965CC75374CC3ULL
+	};
+
+	inline void multiply(UInt64& a, UInt64& b)
+		/// Computes the 128-bit product of a and b and
+		/// stores the low half in a and the high half in b.
+	{
+#if defined(__SIZEOF_INT128__)
+		unsigned __int128 r = static_cast<unsigned __int128>(a)*b;
+		a = static_cast<UInt64>(r);
+		b = static_cast<UInt64>(r >> 64);
+#else
+		UInt64 ha = a >> 32, hb = b >> 32, la = static_cast<UInt32>(a), lb = static_cast<UInt32>(b);
+		UInt64 rh = ha*hb, rm0 = ha*lb, rm1 = hb*la, rl = la*lb;
+		UInt64 t = rl + (rm0 << 32);
+		UInt64 c = t < rl;
+		UInt64 lo = t + (rm1 << 32);
+		c += lo < t;
+		UInt64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+		a = lo;
+		b = hi;
+#endif
+	}
+
+	inline UInt64 mix(UInt64 a, UInt64 b)
+	{
+		multiply(a, b);
+		return a ^ b;
+	}
+
+	inline UInt64 read64(const unsigned char* p)
+	{
+		UInt64 v;
+		std::memcpy(&v, p, sizeof(v));
+		return ByteOrder::fromLittleEndian(v);
+	}
+
+	inline UInt64 read32(const unsigned char* p)
+	{
+		UInt32 v;
+		std::memcpy(&v, p, sizeof(v));
+		return ByteOrder::fromLittleEndian(v);
+	}
+
+	inline UInt64 read3(const unsigned char* p, std::size_t k)
+		/// Reads 1 to 3 bytes.
+	{
+		return (UInt64(p[0]) << 16) | (UInt64(p[k >> 1]) << 8) | p[k - 1];
+	}
+}
+
+
 std::size_t hash(const std::string& str)
 {
-	std::size_t h = 0;
-	std::string::const_iterator it  = str.begin();
-	std::string::const_iterator end = str.end();
-	while (it != end)
+	return static_cast<std::size_t>(hash64(str.data(), str.size()));
+}
+
+
+std::size_t hash(const std::string& str, UInt64 seed)
+{
+	return static_cast<std::size_t>(hash64(str.data(), str.size(), seed));
+}
+
+
+UInt64 hash64(const void* data, std::size_t length, UInt64 seed)
+{
+	poco_assert (data || length == 0);
+
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	UInt64 a;
+	UInt64 b;
+	seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+	if (length <= 16)
+	{
+		if (length >= 4)
+		{
+			a = (read32(p) << 32) | read32(p + ((length >> 3) << 2));
+			b = (read32(p + length - 4) << 32) | read32(p + length - 4 - ((length >> 3) << 2));
+		}
+		else if (length > 0)
+		{
+			a = read3(p, length);
+			b = 0;
+		}
+		else a = b = 0;
+	}
+	else
 	{
-		h = h * 0xf4243 ^ *it++;
+		std::size_t i = length;
+		if (i > 48)
+		{
+			UInt64 seed1 = seed;
+			UInt64 seed2 = seed;
+			do
+			{
+				seed  = mix(read64(p) ^ SECRET[1], read64(p + 8) ^ seed);
+				seed1 = mix(read64(p + 16) ^ SECRET[2], read64(p + 24) ^ seed1);
+				seed2 = mix(read64(p + 32) ^ SECRET[3], read64(p + 40) ^ seed2);
+				p += 48;
+				i -= 48;
+			}
+			while (i > 48);
+			seed ^= seed1 ^ seed2;
+		}
+		while (i > 16)
+		{
+			seed = mix(read64(p) ^ SECRET[1], read64(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+		a = read64(p + i - 16);
+		b = read64(p + i - 8);
 	}
-	return h;
+	a ^= SECRET[1];
+	b ^= seed;
+	multiply(a, b);
+	return mix(a ^ SECRET[0] ^ length, b ^ SECRET[1]);
+}
+
+
+UInt64 randomHashSeed()
+{
+	struct Seed
+	{
+		Seed(): value(0)
+		{
+			RandomInputStream rnd;
+			rnd.read(reinterpret_cast<char*>(&value), sizeof(value));
+		}
+
+		UInt64 value;
+	};
+	static const Seed seed;
+	return seed.value;
 }
 
 
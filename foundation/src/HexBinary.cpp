@@ -0,0 +1,245 @@
+//
+// HexBinary.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  HexBinary
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "lucid/HexBinary.h"
+#include "lucid/CPUFeatures.h"
+#include "lucid/Exception.h"
+#include <cstring>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define POCO_HEXBINARY_X86 1
+	#include <immintrin.h>
+#endif
+
+
+namespace Lucid {
+
+
+namespace
+{
+	const char DIGITS[] = "0123456789abcdef0123456789ABCDEF";
+
+	const UInt8 INVALID = 0xFF;
+
+	struct DecodingTable
+	{
+		DecodingTable()
+		{
+			std::memset(d, INVALID, sizeof(d));
+			for (int i = 0; i < 10; i++) d['0' + i] = static_cast<UInt8>(i);
+			for (int i = 0; i < 6; i++)
+			{
+				d['a' + i] = static_cast<UInt8>(10 + i);
+				d['A' + i] = static_cast<UInt8>(10 + i);
+			}
+		}
+
+		UInt8 d[256];
+	};
+
+	const DecodingTable& decodingTable()
+	{
+		static const DecodingTable table;
+		return table;
+	}
+
+	void encodeScalar(const unsigned char* in, std::size_t size, char* out, const char* digits)
+	{
+		for (std::size_t i = 0; i < size; i++)
+		{
+			*out++ = digits[in[i] >> 4];
+			*out++ = digits[in[i] & 0x0F];
+		}
+	}
+
+	std::size_t decodeScalar(const char* in, std::size_t size, unsigned char* out)
+		/// Decodes size bytes from 2*size characters.
+		/// Returns the number of bytes decoded before
+		/// the first invalid character.
+	{
+		const UInt8* table = decodingTable().d;
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(in);
+		for (std::size_t i = 0; i < size; i++, p += 2)
+		{
+			UInt8 hi = table[p[0]];
+			UInt8 lo = table[p[1]];
+			if ((hi | lo) & 0x80) return i;
+			out[i] = static_cast<unsigned char>((hi << 4) | lo);
+		}
+		return size;
+	}
+
+
+#if defined(POCO_HEXBINARY_X86)
+
+
+	__attribute__((target("ssse3")))
+	std::size_t encodeSSSE3(const unsigned char* in, std::size_t size, char* out, const char* digits)
+		/// Encodes blocks of 16 bytes. Returns the number of bytes encoded.
+	{
+		const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+		const __m128i mask = _mm_set1_epi8(0x0F);
+
+		std::size_t done = 0;
+		for (; size - done >= 16; done += 16, out += 32)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+			const __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+			const __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(v, mask));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(hi, lo));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_unpackhi_epi8(hi, lo));
+		}
+		return done;
+	}
+
+
+	__attribute__((target("ssse3")))
+	inline bool decodeDigits(__m128i s, __m128i& values)
+		/// Converts 16 hexadecimal digits to their values.
+		/// Returns false if any character is not a digit.
+	{
+		const __m128i lower = _mm_or_si128(s, _mm_set1_epi8(0x20));
+		const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(s, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(s, _mm_set1_epi8('9' + 1)));
+		const __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+		if (_mm_movemask_epi8(_mm_or_si128(digit, alpha)) != 0xFFFF) return false;
+
+		values = _mm_or_si128(
+			_mm_and_si128(digit, _mm_sub_epi8(s, _mm_set1_epi8('0'))),
+			_mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+		return true;
+	}
+
+
+	__attribute__((target("ssse3")))
+	std::size_t decodeSSSE3(const char* in, std::size_t size, unsigned char* out)
+		/// Decodes blocks of 16 bytes from 32 characters, stopping at the
+		/// first block containing an invalid character. Returns the number
+		/// of bytes decoded.
+	{
+		const __m128i weights = _mm_set1_epi16(0x0110);
+
+		std::size_t done = 0;
+		for (; size - done >= 16; done += 16)
+		{
+			__m128i lo;
+			__m128i hi;
+			if (!decodeDigits(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2*done)), lo)) break;
+			if (!decodeDigits(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2*done + 16)), hi)) break;
+			lo = _mm_maddubs_epi16(lo, weights);
+			hi = _mm_maddubs_epi16(hi, weights);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + done), _mm_packus_epi16(lo, hi));
+		}
+		return done;
+	}
+
+
+#endif // POCO_HEXBINARY_X86
+
+
+	void decodeBytes(const char* in, std::size_t size, unsigned char* out)
+		/// Decodes size bytes from 2*size characters.
+		/// Throws a DataFormatException if an invalid
+		/// character is found.
+	{
+		std::size_t done = 0;
+#if defined(POCO_HEXBINARY_X86)
+		static const bool ssse3 = CPUFeatures::hasSSSE3();
+		if (ssse3) done = decodeSSSE3(in, size, out);
+#endif
+		done += decodeScalar(in + 2*done, size - done, out + done);
+		if (done < size) throw DataFormatException("Invalid hexBinary character");
+	}
+
+
+	inline bool isSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+	}
+
+
+	std::size_t decodeLenient(const char* data, std::size_t size, unsigned char* out)
+	{
+		enum
+		{
+			CHUNK_SIZE = 4096
+		};
+		char chunk[CHUNK_SIZE];
+		std::size_t length = 0;
+		unsigned char* begin = out;
+		const char* it = data;
+		const char* end = data + size;
+		while (it != end)
+		{
+			while (it != end && length < CHUNK_SIZE)
+			{
+				char c = *it++;
+				if (!isSpace(c)) chunk[length++] = c;
+			}
+			std::size_t n = length/2;
+			decodeBytes(chunk, n, out);
+			out += n;
+			length -= 2*n;
+			std::memmove(chunk, chunk + 2*n, length);
+		}
+		if (length > 0) throw DataFormatException("Invalid hexBinary length");
+		return out - begin;
+	}
+}
+
+
+std::size_t HexBinary::encode(const void* data, std::size_t size, char* buffer, int options)
+{
+	poco_assert (data || size == 0);
+
+	const unsigned char* in = static_cast<const unsigned char*>(data);
+	const char* digits = (options & HEXBINARY_UPPERCASE) ? DIGITS + 16 : DIGITS;
+	std::size_t done = 0;
+#if defined(POCO_HEXBINARY_X86)
+	static const bool ssse3 = CPUFeatures::hasSSSE3();
+	if (ssse3) done = encodeSSSE3(in, size, buffer, digits);
+#endif
+	encodeScalar(in + done, size - done, buffer + 2*done, digits);
+	return 2*size;
+}
+
+
+std::string HexBinary::encode(const void* data, std::size_t size, int options)
+{
+	std::string result(2*size, '\0');
+	if (!result.empty()) encode(data, size, &result[0], options);
+	return result;
+}
+
+
+std::size_t HexBinary::decode(const char* data, std::size_t size, void* buffer, int options)
+{
+	poco_assert (data || size == 0);
+
+	unsigned char* out = static_cast<unsigned char*>(buffer);
+	if (options & HEXBINARY_LENIENT) return decodeLenient(data, size, out);
+
+	if (size % 2) throw DataFormatException("Invalid hexBinary length");
+	decodeBytes(data, size/2, out);
+	return size/2;
+}
+
+
+std::string HexBinary::decode(const std::string& data, int options)
+{
+	std::string result(data.size()/2, '\0');
+	if (!result.empty()) result.resize(decode(data.data(), data.size(), &result[0], options));
+	else decode(data.data(), data.size(), 0, options);
+	return result;
+}
+
+
+} // namespace Lucid
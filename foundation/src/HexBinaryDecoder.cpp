@@ -13,6 +13,7 @@
 
 
 #include "lucid/HexBinaryDecoder.h"
+#include "lucid/HexBinary.h"
 #include "lucid/Exception.h"
 
 
@@ -20,7 +21,8 @@ namespace Lucid {
 
 
 HexBinaryDecoderBuf::HexBinaryDecoderBuf(std::istream& istr): 
-	_buf(*istr.rdbuf())
+	_buf(*istr.rdbuf()),
+	_charsIndex(0)
 {
 }
 
@@ -57,6 +59,9 @@ int HexBinaryDecoderBuf::readFromDevice()
 
 int HexBinaryDecoderBuf::readOne()
 {
+	if (_charsIndex < _chars.size())
+		return static_cast<unsigned char>(_chars[_charsIndex++]);
+
 	int ch = _buf.sbumpc();
 	while (ch == ' ' || ch == '\r' || ch == '\t' || ch == '\n')
 		ch = _buf.sbumpc();
@@ -64,6 +69,71 @@ int HexBinaryDecoderBuf::readOne()
 }
 
 
+std::streamsize HexBinaryDecoderBuf::xsgetn(char* p, std::streamsize count)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	if (count <= 0) return 0;
+	int c = uflow();
+	if (c == eof) return 0;
+	*p++ = static_cast<char>(c);
+	std::streamsize copied = 1;
+
+	while (copied < count)
+	{
+		std::size_t size = static_cast<std::size_t>(count - copied);
+		if (size > BLOCK_SIZE) size = BLOCK_SIZE;
+		std::size_t n = readChars(2*size)/2;
+		if (n > size) n = size;
+		if (n == 0) break;
+		HexBinary::decode(_chars.data() + _charsIndex, 2*n, p);
+		_charsIndex += 2*n;
+		p      += n;
+		copied += n;
+		if (n < size) break;
+	}
+
+	while (copied < count)
+	{
+		c = uflow();
+		if (c == eof) break;
+		*p++ = static_cast<char>(c);
+		++copied;
+	}
+	return copied;
+}
+
+
+std::size_t HexBinaryDecoderBuf::readChars(std::size_t count)
+{
+	if (_charsIndex == _chars.size())
+	{
+		_chars.clear();
+		_charsIndex = 0;
+	}
+	while (_chars.size() - _charsIndex < count)
+	{
+		std::size_t offset = _chars.size();
+		std::size_t wanted = count - (offset - _charsIndex);
+		_chars.resize(offset + wanted);
+		std::streamsize n = _buf.sgetn(&_chars[offset], static_cast<std::streamsize>(wanted));
+		if (n <= 0)
+		{
+			_chars.resize(offset);
+			break;
+		}
+		std::size_t end = offset;
+		for (std::size_t i = offset; i < offset + static_cast<std::size_t>(n); i++)
+		{
+			char ch = _chars[i];
+			if (ch != ' ' && ch != '\r' && ch != '\t' && ch != '\n') _chars[end++] = ch;
+		}
+		_chars.resize(end);
+	}
+	return _chars.size() - _charsIndex;
+}
+
+
 HexBinaryDecoderIOS::HexBinaryDecoderIOS(std::istream& istr): _buf(istr)
 {
 	poco_ios_init(&_buf);
@@ -13,6 +13,7 @@
 
 
 #include "lucid/HexBinaryEncoder.h"
+#include "lucid/HexBinary.h"
 
 
 namespace Lucid {
@@ -74,6 +75,42 @@ int HexBinaryEncoderBuf::writeToDevice(char c)
 }
 
 
+std::streamsize HexBinaryEncoderBuf::xsputn(const char* s, std::streamsize count)
+{
+	// Encode in blocks, breaking lines exactly
+	// like writeToDevice() does.
+	char block[BLOCK_SIZE*3];
+	std::streamsize written = 0;
+	while (written < count)
+	{
+		std::size_t size = static_cast<std::size_t>(count - written);
+		if (size > BLOCK_SIZE) size = BLOCK_SIZE;
+		std::streamsize begin = written;
+		char* out = block;
+		while (size > 0)
+		{
+			std::size_t n = size;
+			if (_lineLength > 0)
+			{
+				std::size_t left = _pos < _lineLength ? static_cast<std::size_t>(_lineLength - _pos + 1)/2 : 1;
+				if (n > left) n = left;
+			}
+			out += HexBinary::encode(s + written, n, out, _uppercase ? HEXBINARY_UPPERCASE : 0);
+			written += n;
+			size    -= n;
+			_pos += static_cast<int>(2*n);
+			if (_lineLength > 0 && _pos >= _lineLength)
+			{
+				*out++ = '\n';
+				_pos = 0;
+			}
+		}
+		if (_buf.sputn(block, out - block) != out - block) return begin;
+	}
+	return written;
+}
+
+
 int HexBinaryEncoderBuf::close()
 {
 	sync();
@@ -18,14 +18,23 @@
 #include "lucid/Process.h"
 #endif
 #include "lucid/Thread.h"
+#include "lucid/CoarseClock.h"
 #include <algorithm>
+#include <atomic>
 
 
 namespace Lucid {
 
 
+namespace
+{
+	std::atomic<bool> coarseClock(false);
+}
+
+
 Message::Message():
 	_prio(PRIO_FATAL),
+	_time(now()),
 	_tid(0),
 	_pid(0),
 	_file(0),
@@ -40,6 +49,7 @@ Message::Message(const std::string& source, const std::string& text, Priority pr
 	_source(source),
 	_text(text),
 	_prio(prio),
+	_time(now()),
 	_tid(0),
 	_pid(0),
 	_file(0),
@@ -54,6 +64,7 @@ Message::Message(const std::string& source, const std::string& text, Priority pr
 	_source(source),
 	_text(text),
 	_prio(prio),
+	_time(now()),
 	_tid(0),
 	_pid(0),
 	_file(file),
@@ -122,6 +133,24 @@ Message::~Message()
 }
 
 
+void Message::setCoarseClock(bool coarse)
+{
+	coarseClock.store(coarse, std::memory_order_relaxed);
+}
+
+
+bool Message::getCoarseClock()
+{
+	return coarseClock.load(std::memory_order_relaxed);
+}
+
+
+Timestamp Message::now()
+{
+	return coarseClock.load(std::memory_order_relaxed) ? CoarseClock::now() : Timestamp();
+}
+
+
 void Message::init()
 {
 #if !defined(POCO_VXWORKS)
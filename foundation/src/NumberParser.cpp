@@ -54,6 +54,12 @@ bool NumberParser::tryParse(const std::string& s, int& value, char thSep)
 }
 
 
+bool NumberParser::tryParse(const char* s, std::size_t length, int& value, char thSep)
+{
+	return strToInt(s, s + length, value, NUM_BASE_DEC, thSep);
+}
+
+
 unsigned NumberParser::parseUnsigned(const std::string& s, char thSep)
 {
 	unsigned result;
@@ -70,6 +76,12 @@ bool NumberParser::tryParseUnsigned(const std::string& s, unsigned& value, char
 }
 
 
+bool NumberParser::tryParseUnsigned(const char* s, std::size_t length, unsigned& value, char thSep)
+{
+	return strToInt(s, s + length, value, NUM_BASE_DEC, thSep);
+}
+
+
 unsigned NumberParser::parseHex(const std::string& s)
 {
 	unsigned result;
@@ -123,6 +135,12 @@ bool NumberParser::tryParse64(const std::string& s, Int64& value, char thSep)
 }
 
 
+bool NumberParser::tryParse64(const char* s, std::size_t length, Int64& value, char thSep)
+{
+	return strToInt(s, s + length, value, NUM_BASE_DEC, thSep);
+}
+
+
 UInt64 NumberParser::parseUnsigned64(const std::string& s, char thSep)
 {
 	UInt64 result;
@@ -139,6 +157,12 @@ bool NumberParser::tryParseUnsigned64(const std::string& s, UInt64& value, char
 }
 
 
+bool NumberParser::tryParseUnsigned64(const char* s, std::size_t length, UInt64& value, char thSep)
+{
+	return strToInt(s, s + length, value, NUM_BASE_DEC, thSep);
+}
+
+
 UInt64 NumberParser::parseHex64(const std::string& s)
 {
 	UInt64 result;
@@ -188,7 +212,13 @@ double NumberParser::parseFloat(const std::string& s, char decSep, char thSep)
 
 bool NumberParser::tryParseFloat(const std::string& s, double& value, char decSep, char thSep)
 {
-	return strToDouble(s.c_str(), value, decSep, thSep);
+	return strToDouble(s.data(), s.size(), value, decSep, thSep);
+}
+
+
+bool NumberParser::tryParseFloat(const char* s, std::size_t length, double& value, char decSep, char thSep)
+{
+	return strToDouble(s, length, value, decSep, thSep);
 }
 
 
@@ -34,6 +34,8 @@ poco_static_assert(POCO_MAX_FLT_STRING_LEN == double_conversion::kMaxSignificant
 #include "lucid/String.h"
 #include <memory>
 #include <cctype>
+#include <cfloat>
+#include <cstring>
 
 
 namespace {
@@ -157,6 +159,130 @@ void insertThousandSep(std::string& str, char thSep, char decSep = '.')
 }
 
 
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+	#define POCO_STRTOD_FAST_PATH 1
+#endif
+
+
+inline bool isDigit(char c)
+{
+	return static_cast<unsigned char>(c - '0') < 10;
+}
+
+
+inline bool isSpace(char c)
+{
+	return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+
+bool strToDoubleFast(const char* it, const char* end, char decSep, double& result)
+	/// Converts a plain decimal number with at most 19 significant digits
+	/// and a small exponent, using Clinger's fast path: if both the
+	/// significand and the power of ten are exactly representable, a single
+	/// multiplication or division gives the correctly rounded result.
+	///
+	/// Returns false if the number is not in this form and must be converted
+	/// by the general algorithm.
+{
+#if defined(POCO_STRTOD_FAST_PATH)
+	static const double POWERS_OF_TEN[] =
+	{
+		1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+		1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+		1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	static const Lucid::UInt64 MAX_EXACT = Lucid::UInt64(1) << 53;
+
+	while (it != end && isSpace(*it)) ++it;
+	bool negative = false;
+	if (it != end && (*it == '-' || *it == '+'))
+	{
+		negative = (*it == '-');
+		++it;
+	}
+
+	Lucid::UInt64 significand = 0;
+	int digits = 0;
+	int exponent = 0;
+	const char* begin = it;
+	for (; it != end && isDigit(*it); ++it)
+	{
+		if (significand == 0 && *it == '0') continue;
+		if (++digits > 19) return false;
+		significand = significand*10 + (*it - '0');
+	}
+	bool empty = (it == begin);
+	if (it != end && *it == decSep)
+	{
+		begin = ++it;
+		for (; it != end && isDigit(*it); ++it)
+		{
+			--exponent;
+			if (significand == 0 && *it == '0') continue;
+			if (++digits > 19) return false;
+			significand = significand*10 + (*it - '0');
+		}
+		empty = empty && (it == begin);
+	}
+	if (empty) return false;
+
+	if (it != end && (*it == 'e' || *it == 'E'))
+	{
+		++it;
+		bool negativeExponent = false;
+		if (it != end && (*it == '-' || *it == '+'))
+		{
+			negativeExponent = (*it == '-');
+			++it;
+		}
+		if (it == end || !isDigit(*it)) return false;
+		int e = 0;
+		for (; it != end && isDigit(*it); ++it)
+		{
+			if (e < 10000) e = e*10 + (*it - '0');
+		}
+		exponent += negativeExponent ? -e : e;
+	}
+	while (it != end && isSpace(*it)) ++it;
+	if (it != end) return false;
+
+	double value;
+	if (significand == 0)
+	{
+		value = 0.0;
+	}
+	else if (significand > MAX_EXACT)
+	{
+		return false;
+	}
+	else if (exponent < 0)
+	{
+		if (exponent < -22) return false;
+		value = static_cast<double>(significand)/POWERS_OF_TEN[-exponent];
+	}
+	else if (exponent <= 22)
+	{
+		value = static_cast<double>(significand)*POWERS_OF_TEN[exponent];
+	}
+	else
+	{
+		// a small significand can absorb part of a larger exponent
+		for (; exponent > 22; --exponent)
+		{
+			if (significand > MAX_EXACT/10) return false;
+			significand *= 10;
+		}
+		value = static_cast<double>(significand)*POWERS_OF_TEN[exponent];
+	}
+	result = negative ? -value : value;
+	return true;
+#else
+	return false;
+#endif
+}
+
+
 } // namespace
 
 
@@ -332,11 +458,23 @@ bool strToFloat(const std::string& str, float& result, char decSep, char thSep,
 
 bool strToDouble(const std::string& str, double& result, char decSep, char thSep, const char* inf, const char* nan)
 {
-	if (str.empty()) return false;
+	return strToDouble(str.data(), str.size(), result, decSep, thSep, inf, nan);
+}
+
+
+bool strToDouble(const char* str, std::size_t length, double& result, char decSep, char thSep, const char* inf, const char* nan)
+{
+	if (length == 0) return false;
+
+	// thousand separators that could be part of a
+	// plain number are left to the general conversion
+	bool plainThSep = thSep != decSep && !isDigit(thSep) && thSep != '+' && thSep != '-' && thSep != 'e' && thSep != 'E';
+	if (plainThSep && strToDoubleFast(str, str + length, decSep, result))
+		return true;
 
 	using namespace double_conversion;
 
-	std::string tmp(str);
+	std::string tmp(str, length);
 	trimInPlace(tmp);
 	removeInPlace(tmp, thSep);
 	replaceInPlace(tmp, decSep, '.');
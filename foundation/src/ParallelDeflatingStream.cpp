@@ -0,0 +1,383 @@
+//
+// ParallelDeflatingStream.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  ZLibStream
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "lucid/ParallelDeflatingStream.h"
+#include "lucid/ThreadPool.h"
+#include "lucid/Runnable.h"
+#include "lucid/Event.h"
+#include "lucid/Environment.h"
+#include "lucid/Exception.h"
+
+
+namespace Lucid {
+
+
+class ParallelDeflatingStreamBuf::Block: public Runnable
+	/// A block of data, which is compressed by a thread of the pool
+	/// into a raw deflate stream. All blocks except the last one end
+	/// with a sync flush, so that their output can be concatenated.
+{
+public:
+	Block(const char* data, std::size_t length, const std::string& dictionary, int level, Checksum::Type checksumType, bool last):
+		_input(data, length),
+		_dictionary(dictionary),
+		_size(length),
+		_level(level),
+		_checksumType(checksumType),
+		_last(last),
+		_checksum(0),
+		_done(Event::EVENT_MANUALRESET)
+	{
+	}
+
+	void run()
+	{
+		try
+		{
+			compress();
+		}
+		catch (Exception& exc)
+		{
+			_error = exc.displayText();
+		}
+		catch (std::exception& exc)
+		{
+			_error = exc.what();
+		}
+		_done.set();
+	}
+
+	void wait()
+	{
+		_done.wait();
+	}
+
+	bool tryWait()
+	{
+		return _done.tryWait(0);
+	}
+
+	std::size_t size() const
+	{
+		return _size;
+	}
+
+	const std::string& output() const
+	{
+		return _output;
+	}
+
+	Lucid::UInt32 checksum() const
+	{
+		return _checksum;
+	}
+
+	const std::string& error() const
+	{
+		return _error;
+	}
+
+private:
+	void compress()
+	{
+		Checksum checksum(_checksumType);
+		checksum.update(_input.data(), static_cast<unsigned>(_input.size()));
+		_checksum = checksum.checksum();
+
+		z_stream zstr;
+		zstr.zalloc = Z_NULL;
+		zstr.zfree  = Z_NULL;
+		zstr.opaque = Z_NULL;
+		int rc = deflateInit2(&zstr, _level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+		if (rc != Z_OK) throw IOException(zError(rc));
+		try
+		{
+			if (!_dictionary.empty())
+			{
+				rc = deflateSetDictionary(&zstr, reinterpret_cast<const Bytef*>(_dictionary.data()), static_cast<uInt>(_dictionary.size()));
+				if (rc != Z_OK) throw IOException(zError(rc));
+			}
+			// the sync flush adds an empty stored block of 4 or 5 bytes
+			_output.resize(deflateBound(&zstr, static_cast<uLong>(_input.size())) + 16);
+			zstr.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(_input.data()));
+			zstr.avail_in  = static_cast<uInt>(_input.size());
+			zstr.next_out  = reinterpret_cast<Bytef*>(&_output[0]);
+			zstr.avail_out = static_cast<uInt>(_output.size());
+			for (;;)
+			{
+				rc = deflate(&zstr, _last ? Z_FINISH : Z_SYNC_FLUSH);
+				if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR) throw IOException(zError(rc));
+				if (zstr.avail_out != 0 || rc == Z_STREAM_END) break;
+				std::size_t used = _output.size();
+				_output.resize(2*used);
+				zstr.next_out  = reinterpret_cast<Bytef*>(&_output[used]);
+				zstr.avail_out = static_cast<uInt>(used);
+			}
+			_output.resize(_output.size() - zstr.avail_out);
+		}
+		catch (...)
+		{
+			deflateEnd(&zstr);
+			throw;
+		}
+		deflateEnd(&zstr);
+		std::string().swap(_input);
+		std::string().swap(_dictionary);
+	}
+
+	std::string _input;
+	std::string _dictionary;
+	std::size_t _size;
+	std::string _output;
+	int _level;
+	Checksum::Type _checksumType;
+	bool _last;
+	Lucid::UInt32 _checksum;
+	std::string _error;
+	Event _done;
+};
+
+
+ParallelDeflatingStreamBuf::ParallelDeflatingStreamBuf(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, std::size_t blockSize, ThreadPool& pool, int maxPendingBlocks):
+	BufferedStreamBuf(static_cast<std::streamsize>(blockSize), std::ios::out),
+	_pOstr(&ostr),
+	_pool(pool),
+	_type(type),
+	_level(level),
+	_maxPendingBlocks(maxPendingBlocks > 0 ? maxPendingBlocks : 2*Environment::processorCount()),
+	_checksumType(type == DeflatingStreamBuf::STREAM_GZIP ? Checksum::TYPE_CRC32 : Checksum::TYPE_ADLER32),
+	_checksum(type == DeflatingStreamBuf::STREAM_GZIP ? 0 : 1),
+	_size(0),
+	_headerWritten(false)
+{
+	poco_assert (blockSize > 0);
+
+	if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION)
+		throw InvalidArgumentException("Invalid compression level");
+	if (_maxPendingBlocks < 2) _maxPendingBlocks = 2;
+}
+
+
+ParallelDeflatingStreamBuf::~ParallelDeflatingStreamBuf()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+	}
+	for (auto& pBlock: _blocks)
+	{
+		pBlock->wait();
+	}
+}
+
+
+int ParallelDeflatingStreamBuf::close()
+{
+	if (_pOstr)
+	{
+		std::ostream* pOstr = _pOstr;
+		try
+		{
+			std::streamsize n = pptr() - pbase();
+			startBlock(pbase(), static_cast<std::size_t>(n), true);
+			pbump(static_cast<int>(-n));
+			writeBlocks(0);
+			writeTrailer();
+		}
+		catch (...)
+		{
+			_pOstr = 0;
+			throw;
+		}
+		_pOstr = 0;
+		pOstr->flush();
+	}
+	return 0;
+}
+
+
+int ParallelDeflatingStreamBuf::sync()
+{
+	if (BufferedStreamBuf::sync())
+		return -1;
+
+	if (_pOstr)
+	{
+		writeBlocks(0);
+	}
+	return 0;
+}
+
+
+int ParallelDeflatingStreamBuf::writeToDevice(const char* buffer, std::streamsize length)
+{
+	if (length == 0 || !_pOstr) return 0;
+
+	startBlock(buffer, static_cast<std::size_t>(length), false);
+	writeBlocks(_maxPendingBlocks - 1);
+	return static_cast<int>(length);
+}
+
+
+void ParallelDeflatingStreamBuf::startBlock(const char* buffer, std::size_t length, bool last)
+{
+	SharedPtr<Block> pBlock = new Block(buffer, length, _dictionary, _level, _checksumType, last);
+	_blocks.push_back(pBlock);
+	try
+	{
+		_pool.start(*pBlock);
+	}
+	catch (NoThreadAvailableException&)
+	{
+		pBlock->run();
+	}
+
+	if (length >= DICTIONARY_SIZE)
+	{
+		_dictionary.assign(buffer + length - DICTIONARY_SIZE, DICTIONARY_SIZE);
+	}
+	else
+	{
+		_dictionary.append(buffer, length);
+		if (_dictionary.size() > DICTIONARY_SIZE)
+			_dictionary.erase(0, _dictionary.size() - DICTIONARY_SIZE);
+	}
+}
+
+
+void ParallelDeflatingStreamBuf::writeBlocks(std::size_t maxPending)
+{
+	while (!_blocks.empty())
+	{
+		SharedPtr<Block> pBlock = _blocks.front();
+		if (_blocks.size() > maxPending)
+			pBlock->wait();
+		else if (!pBlock->tryWait())
+			break;
+		_blocks.pop_front();
+
+		if (!pBlock->error().empty()) throw IOException(pBlock->error());
+		if (!_headerWritten) writeHeader();
+		_pOstr->write(pBlock->output().data(), static_cast<std::streamsize>(pBlock->output().size()));
+		if (!_pOstr->good()) throw IOException("Failed writing deflated data to output stream");
+		_checksum = Checksum::combine(_checksumType, _checksum, pBlock->checksum(), pBlock->size());
+		_size += pBlock->size();
+	}
+}
+
+
+void ParallelDeflatingStreamBuf::writeHeader()
+{
+	// The same headers are written by zlib's deflate().
+	int level = _level == Z_DEFAULT_COMPRESSION ? 6 : _level;
+	if (_type == DeflatingStreamBuf::STREAM_GZIP)
+	{
+		char header[10] = {'\x1f', '\x8b', Z_DEFLATED, 0, 0, 0, 0, 0, 0, '\x03'};
+		if (level == Z_BEST_COMPRESSION)
+			header[8] = 2;
+		else if (level < 2)
+			header[8] = 4;
+		_pOstr->write(header, sizeof(header));
+	}
+	else
+	{
+		int flags = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+		unsigned header = (0x78 << 8) | (flags << 6);
+		header += 31 - header % 31;
+		_pOstr->put(static_cast<char>(header >> 8));
+		_pOstr->put(static_cast<char>(header & 0xFF));
+	}
+	if (!_pOstr->good()) throw IOException("Failed writing deflated data to output stream");
+	_headerWritten = true;
+}
+
+
+void ParallelDeflatingStreamBuf::writeTrailer()
+{
+	char trailer[8];
+	if (_type == DeflatingStreamBuf::STREAM_GZIP)
+	{
+		// CRC-32 and input size modulo 2^32, little endian
+		for (int i = 0; i < 4; ++i)
+		{
+			trailer[i]     = static_cast<char>(_checksum >> (8*i));
+			trailer[i + 4] = static_cast<char>(_size >> (8*i));
+		}
+		_pOstr->write(trailer, 8);
+	}
+	else
+	{
+		// Adler-32, big endian
+		for (int i = 0; i < 4; ++i)
+		{
+			trailer[i] = static_cast<char>(_checksum >> (24 - 8*i));
+		}
+		_pOstr->write(trailer, 4);
+	}
+	if (!_pOstr->good()) throw IOException("Failed writing deflated data to output stream");
+}
+
+
+ParallelDeflatingIOS::ParallelDeflatingIOS(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, std::size_t blockSize, ThreadPool& pool, int maxPendingBlocks):
+	_buf(ostr, type, level, blockSize, pool, maxPendingBlocks)
+{
+	poco_ios_init(&_buf);
+}
+
+
+ParallelDeflatingIOS::~ParallelDeflatingIOS()
+{
+}
+
+
+ParallelDeflatingStreamBuf* ParallelDeflatingIOS::rdbuf()
+{
+	return &_buf;
+}
+
+
+ParallelDeflatingOutputStream::ParallelDeflatingOutputStream(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, std::size_t blockSize):
+	std::ostream(&_buf),
+	ParallelDeflatingIOS(ostr, type, level, blockSize, ThreadPool::defaultPool(), 0)
+{
+}
+
+
+ParallelDeflatingOutputStream::ParallelDeflatingOutputStream(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, std::size_t blockSize, ThreadPool& pool, int maxPendingBlocks):
+	std::ostream(&_buf),
+	ParallelDeflatingIOS(ostr, type, level, blockSize, pool, maxPendingBlocks)
+{
+}
+
+
+ParallelDeflatingOutputStream::~ParallelDeflatingOutputStream()
+{
+}
+
+
+int ParallelDeflatingOutputStream::close()
+{
+	return _buf.close();
+}
+
+
+int ParallelDeflatingOutputStream::sync()
+{
+	return _buf.pubsync();
+}
+
+
+} // namespace Lucid
@@ -23,17 +23,135 @@
 #include "lucid/Environment.h"
 #include "lucid/NumberParser.h"
 #include "lucid/StringTokenizer.h"
+#include <atomic>
 
 
 namespace Lucid {
 
 
+namespace
+{
+	struct DateTimeCache
+		/// Caches the broken-down time of the last second formatted
+		/// by the current thread, so that the time zone offset and
+		/// the date and time fields are only computed once per second.
+	{
+		DateTimeCache():
+			second(0),
+			localTime(false),
+			valid(false)
+		{
+		}
+
+		Timestamp::TimeVal second;
+		bool localTime;
+		bool valid;
+		DateTime dateTime;
+	};
+
+	thread_local DateTimeCache dateTimeCache;
+
+	struct PrefixCache
+		/// Caches the text produced by the leading date and time
+		/// fields of a pattern (see PatternFormatter::_prefixActions)
+		/// for the last second formatted by the current thread.
+	{
+		PrefixCache():
+			patternId(0),
+			second(0),
+			localTime(false)
+		{
+		}
+
+		UInt64 patternId;
+		Timestamp::TimeVal second;
+		bool localTime;
+		std::string prefix;
+	};
+
+	thread_local PrefixCache prefixCache;
+
+	std::atomic<UInt64> nextPatternId(1);
+
+	Timestamp::TimeVal epochSecond(const Timestamp& timestamp)
+	{
+		Timestamp::TimeVal second = timestamp.epochMicroseconds()/Timestamp::resolution();
+		if (timestamp.epochMicroseconds() < 0 && second*Timestamp::resolution() != timestamp.epochMicroseconds()) --second;
+		return second;
+	}
+
+	const DateTime& cachedDateTime(const Timestamp& timestamp, bool localTime)
+	{
+		Timestamp::TimeVal second = epochSecond(timestamp);
+		DateTimeCache& cache = dateTimeCache;
+		if (!cache.valid || cache.second != second || cache.localTime != localTime)
+		{
+			Timestamp::TimeVal adjusted = second*Timestamp::resolution();
+			if (localTime)
+			{
+				adjusted += Timezone::utcOffset()*Timestamp::resolution();
+				adjusted += Timezone::dst()*Timestamp::resolution();
+			}
+			cache.dateTime = Timestamp(adjusted);
+			cache.second = second;
+			cache.localTime = localTime;
+			cache.valid = true;
+		}
+		return cache.dateTime;
+	}
+
+	bool isSecondField(char key)
+		/// Returns true if the field given by key only changes
+		/// once per second. %L is included, as it does not
+		/// output anything.
+	{
+		switch (key)
+		{
+		case 'w': case 'W': case 'b': case 'B': case 'd': case 'e': case 'f':
+		case 'm': case 'n': case 'o': case 'y': case 'Y': case 'H': case 'h':
+		case 'a': case 'A': case 'M': case 'S': case 'L':
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void appendSecondField(std::string& text, char key, const DateTime& dateTime)
+	{
+		switch (key)
+		{
+		case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
+		case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
+		case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
+		case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
+		case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
+		case 'e': NumberFormatter::append(text, dateTime.day()); break;
+		case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
+		case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
+		case 'n': NumberFormatter::append(text, dateTime.month()); break;
+		case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
+		case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
+		case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
+		case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
+		case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
+		case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
+		case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
+		case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
+		case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
+		}
+	}
+}
+
+
 const std::string PatternFormatter::PROP_PATTERN = "pattern";
 const std::string PatternFormatter::PROP_TIMES   = "times";
 const std::string PatternFormatter::PROP_PRIORITY_NAMES = "priorityNames";
 
 
 PatternFormatter::PatternFormatter():
+	_prefixActions(0),
+	_prefixLocalTime(false),
+	_patternId(0),
 	_localTime(false)
 {
 	parsePriorityNames();
@@ -41,6 +159,9 @@ PatternFormatter::PatternFormatter():
 
 
 PatternFormatter::PatternFormatter(const std::string& format):
+	_prefixActions(0),
+	_prefixLocalTime(false),
+	_patternId(0),
 	_localTime(false),
 	_pattern(format)
 {
@@ -56,16 +177,49 @@ PatternFormatter::~PatternFormatter()
 
 void PatternFormatter::format(const Message& msg, std::string& text)
 {
-	Timestamp timestamp = msg.getTime();
+	const Timestamp& timestamp = msg.getTime();
+	int fraction = static_cast<int>(timestamp.epochMicroseconds() % Timestamp::resolution());
+	if (fraction < 0) fraction += static_cast<int>(Timestamp::resolution());
+	int millisecond = fraction/1000;
+	int microsecond = fraction%1000;
 	bool localTime = _localTime;
-	if (localTime)
+	DateTime dateTime = cachedDateTime(timestamp, localTime);
+	std::vector<PatternAction>::const_iterator it = _patternActions.begin();
+	if (_prefixActions > 0)
 	{
-		timestamp += Timezone::utcOffset()*Timestamp::resolution();
-		timestamp += Timezone::dst()*Timestamp::resolution();
+		PrefixCache& cache = prefixCache;
+		Timestamp::TimeVal second = epochSecond(timestamp);
+		if (cache.patternId != _patternId || cache.second != second || cache.localTime != localTime)
+		{
+			cache.prefix.clear();
+			bool prefixLocalTime = localTime;
+			const DateTime* pDateTime = &dateTime;
+			for (std::size_t i = 0; i < _prefixActions; ++i)
+			{
+				const PatternAction& pa = _patternActions[i];
+				cache.prefix.append(pa.prepend);
+				if (pa.key == 'L' && !prefixLocalTime)
+				{
+					prefixLocalTime = true;
+					pDateTime = &cachedDateTime(timestamp, true);
+				}
+				else appendSecondField(cache.prefix, pa.key, *pDateTime);
+			}
+			cache.patternId = _patternId;
+			cache.second = second;
+			cache.localTime = localTime;
+		}
+		text.append(cache.prefix);
+		it += _prefixActions;
+		if (_prefixLocalTime && !localTime)
+		{
+			localTime = true;
+			dateTime = cachedDateTime(timestamp, localTime);
+		}
 	}
-	DateTime dateTime = timestamp;
-	for (auto& pa:_patternActions)
+	for (; it != _patternActions.end(); ++it)
 	{
+		const PatternAction& pa = *it;
 		text.append(pa.prepend);
 		switch (pa.key)
 		{
@@ -80,27 +234,9 @@ void PatternFormatter::format(const Message& msg, std::string& text)
 		case 'N': text.append(Environment::nodeName()); break;
 		case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
 		case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
-		case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
-		case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
-		case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
-		case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
-		case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
-		case 'e': NumberFormatter::append(text, dateTime.day()); break;
-		case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
-		case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
-		case 'n': NumberFormatter::append(text, dateTime.month()); break;
-		case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
-		case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
-		case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
-		case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
-		case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
-		case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
-		case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
-		case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
-		case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
-		case 'i': NumberFormatter::append0(text, dateTime.millisecond(), 3); break;
-		case 'c': NumberFormatter::append(text, dateTime.millisecond()/100); break;
-		case 'F': NumberFormatter::append0(text, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
+		case 'i': NumberFormatter::append0(text, millisecond, 3); break;
+		case 'c': NumberFormatter::append(text, millisecond/100); break;
+		case 'F': NumberFormatter::append0(text, millisecond*1000 + microsecond, 6); break;
 		case 'z': text.append(DateTimeFormatter::tzdISO(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
 		case 'Z': text.append(DateTimeFormatter::tzdRFC(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
 		case 'E': NumberFormatter::append(text, msg.getTime().epochTime()); break;
@@ -125,11 +261,12 @@ void PatternFormatter::format(const Message& msg, std::string& text)
 			if (!localTime)
 			{
 				localTime = true;
-				timestamp += Timezone::utcOffset()*Timestamp::resolution();
-				timestamp += Timezone::dst()*Timestamp::resolution();
-				dateTime = timestamp;
+				dateTime = cachedDateTime(timestamp, localTime);
 			}
 			break;
+		default:
+			appendSecondField(text, pa.key, dateTime);
+			break;
 		}
 	}
 }
@@ -191,6 +328,15 @@ void PatternFormatter::parsePattern()
 	{
 		_patternActions.push_back(endAct);
 	}
+
+	_prefixActions = 0;
+	_prefixLocalTime = false;
+	while (_prefixActions < _patternActions.size() && isSecondField(_patternActions[_prefixActions].key))
+	{
+		if (_patternActions[_prefixActions].key == 'L') _prefixLocalTime = true;
+		++_prefixActions;
+	}
+	_patternId = nextPatternId++;
 }
 
 	
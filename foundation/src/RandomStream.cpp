@@ -21,6 +21,10 @@
 #elif defined(POCO_OS_FAMILY_UNIX)
 #include <fcntl.h>
 #include <unistd.h>
+#include <cerrno>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
 #endif
 #include <ctime>
 
@@ -50,11 +54,25 @@ int RandomBuf::readFromDevice(char* buffer, std::streamsize length)
 	n = static_cast<int>(length);
 #else
 	#if defined(POCO_OS_FAMILY_UNIX)
-	int fd = open("/dev/urandom", O_RDONLY, 0);
-	if (fd >= 0) 
+	#if defined(SYS_getrandom)
+	// getrandom() needs no file descriptor and
+	// blocks only until the kernel pool is initialized
+	long rc;
+	do
 	{
-		n = read(fd, buffer, length);
-		close(fd);
+		rc = syscall(SYS_getrandom, buffer, static_cast<std::size_t>(length), 0);
+	}
+	while (rc < 0 && errno == EINTR);
+	if (rc > 0) n = static_cast<int>(rc);
+	#endif
+	if (n <= 0)
+	{
+		int fd = open("/dev/urandom", O_RDONLY, 0);
+		if (fd >= 0) 
+		{
+			n = read(fd, buffer, length);
+			close(fd);
+		}
 	}
 	#endif
 	if (n <= 0)
@@ -16,7 +16,12 @@
 
 
 #include "lucid/SHA1Engine.h"
+#include "lucid/CPUFeatures.h"
 #include <cstring>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define POCO_SHA1_X86 1
+	#include <immintrin.h>
+#endif
 
 
 #ifdef POCO_ARCH_LITTLE_ENDIAN
@@ -29,6 +34,114 @@
 namespace Lucid {
 
 
+#if defined(POCO_SHA1_X86)
+
+
+namespace
+{
+	#define SHA1_ROUNDS(e, eNext, m, f) \
+		e = _mm_sha1nexte_epu32(e, m); \
+		eNext = abcd; \
+		abcd = _mm_sha1rnds4_epu32(abcd, e, f)
+
+	#define SHA1_SCHEDULE(m, mPrev, mNext, mPrev2) \
+		mNext  = _mm_sha1msg2_epu32(mNext, m); \
+		mPrev  = _mm_sha1msg1_epu32(mPrev, m); \
+		mPrev2 = _mm_xor_si128(mPrev2, m)
+
+
+	__attribute__((target("sha,sse4.1")))
+	void transformSHANI(UInt32 digest[5], const unsigned char* data, std::size_t blocks)
+		/// Processes complete blocks with the SHA-NI instructions.
+		/// Each group of four rounds consumes one of four message
+		/// vectors m0-m3, while the message schedule for the
+		/// following groups is computed in the others.
+	{
+		const __m128i mask = _mm_set_epi64x(0x0001020304050607LL, 0x08090A0B0C0D0E0FLL);
+
+		__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digest)), 0x1B);
+		__m128i e0 = _mm_set_epi32(static_cast<int>(digest[4]), 0, 0, 0);
+		__m128i e1;
+
+		for (; blocks > 0; --blocks, data += 64)
+		{
+			const __m128i abcdSave = abcd;
+			const __m128i e0Save = e0;
+
+			__m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), mask);
+			__m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), mask);
+			__m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), mask);
+			__m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), mask);
+
+			// rounds 0-15
+			e0 = _mm_add_epi32(e0, m0);
+			e1 = abcd;
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+			SHA1_ROUNDS(e1, e0, m1, 0);
+			m0 = _mm_sha1msg1_epu32(m0, m1);
+			SHA1_ROUNDS(e0, e1, m2, 0);
+			m1 = _mm_sha1msg1_epu32(m1, m2);
+			m0 = _mm_xor_si128(m0, m2);
+			SHA1_ROUNDS(e1, e0, m3, 0);
+			SHA1_SCHEDULE(m3, m2, m0, m1);
+
+			// rounds 16-31
+			SHA1_ROUNDS(e0, e1, m0, 0);
+			SHA1_SCHEDULE(m0, m3, m1, m2);
+			SHA1_ROUNDS(e1, e0, m1, 1);
+			SHA1_SCHEDULE(m1, m0, m2, m3);
+			SHA1_ROUNDS(e0, e1, m2, 1);
+			SHA1_SCHEDULE(m2, m1, m3, m0);
+			SHA1_ROUNDS(e1, e0, m3, 1);
+			SHA1_SCHEDULE(m3, m2, m0, m1);
+
+			// rounds 32-47
+			SHA1_ROUNDS(e0, e1, m0, 1);
+			SHA1_SCHEDULE(m0, m3, m1, m2);
+			SHA1_ROUNDS(e1, e0, m1, 1);
+			SHA1_SCHEDULE(m1, m0, m2, m3);
+			SHA1_ROUNDS(e0, e1, m2, 2);
+			SHA1_SCHEDULE(m2, m1, m3, m0);
+			SHA1_ROUNDS(e1, e0, m3, 2);
+			SHA1_SCHEDULE(m3, m2, m0, m1);
+
+			// rounds 48-63
+			SHA1_ROUNDS(e0, e1, m0, 2);
+			SHA1_SCHEDULE(m0, m3, m1, m2);
+			SHA1_ROUNDS(e1, e0, m1, 2);
+			SHA1_SCHEDULE(m1, m0, m2, m3);
+			SHA1_ROUNDS(e0, e1, m2, 2);
+			SHA1_SCHEDULE(m2, m1, m3, m0);
+			SHA1_ROUNDS(e1, e0, m3, 3);
+			SHA1_SCHEDULE(m3, m2, m0, m1);
+
+			// rounds 64-79
+			SHA1_ROUNDS(e0, e1, m0, 3);
+			SHA1_SCHEDULE(m0, m3, m1, m2);
+			SHA1_ROUNDS(e1, e0, m1, 3);
+			m2 = _mm_sha1msg2_epu32(m2, m1);
+			m3 = _mm_xor_si128(m3, m1);
+			SHA1_ROUNDS(e0, e1, m2, 3);
+			m3 = _mm_sha1msg2_epu32(m3, m2);
+			SHA1_ROUNDS(e1, e0, m3, 3);
+
+			e0 = _mm_sha1nexte_epu32(e0, e0Save);
+			abcd = _mm_add_epi32(abcd, abcdSave);
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(digest), _mm_shuffle_epi32(abcd, 0x1B));
+		digest[4] = static_cast<UInt32>(_mm_extract_epi32(e0, 3));
+	}
+
+
+	#undef SHA1_ROUNDS
+	#undef SHA1_SCHEDULE
+}
+
+
+#endif // POCO_SHA1_X86
+
+
 SHA1Engine::SHA1Engine()
 {
 	_digest.reserve(16);
@@ -66,17 +179,52 @@ void SHA1Engine::updateImpl(const void* buffer_, std::size_t count)
 	_context.countLo += ((UInt32) count << 3);
 	_context.countHi += ((UInt32 ) count >> 29);
 
-	/* Process data in BLOCK_SIZE chunks */
-	while (count-- > 0)
+	/* Complete a partial block first */
+	if (_context.slop > 0)
 	{
-		db[_context.slop++] = *(buffer++);
-		if (_context.slop == BLOCK_SIZE)
-		{ 
-			/* transform this one block */
-			SHA1_BYTE_REVERSE(_context.data, BLOCK_SIZE);
-			transform();
-			_context.slop = 0 ;	/* no slop left */
-		}
+		std::size_t n = BLOCK_SIZE - _context.slop;
+		if (n > count) n = count;
+		std::memcpy(db + _context.slop, buffer, n);
+		_context.slop += static_cast<UInt32>(n);
+		buffer += n;
+		count  -= n;
+		if (_context.slop < BLOCK_SIZE) return;
+
+		SHA1_BYTE_REVERSE(_context.data, BLOCK_SIZE);
+		transform();
+		_context.slop = 0;
+	}
+
+	/* Process complete blocks directly from the buffer */
+	if (count >= BLOCK_SIZE)
+	{
+		std::size_t blocks = count/BLOCK_SIZE;
+		transformBlocks(buffer, blocks);
+		buffer += blocks*BLOCK_SIZE;
+		count  -= blocks*BLOCK_SIZE;
+	}
+
+	/* Save the rest for later */
+	std::memcpy(db, buffer, count);
+	_context.slop = static_cast<UInt32>(count);
+}
+
+
+void SHA1Engine::transformBlocks(const UInt8* data, std::size_t blocks)
+{
+#if defined(POCO_SHA1_X86)
+	static const bool shaNI = CPUFeatures::hasSHA();
+	if (shaNI)
+	{
+		transformSHANI(_context.digest, data, blocks);
+		return;
+	}
+#endif
+	for (; blocks > 0; --blocks, data += BLOCK_SIZE)
+	{
+		std::memcpy(_context.data, data, BLOCK_SIZE);
+		SHA1_BYTE_REVERSE(_context.data, BLOCK_SIZE);
+		transform();
 	}
 }
 
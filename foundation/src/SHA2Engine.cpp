@@ -21,7 +21,12 @@
 
 
 #include "lucid/SHA2Engine.h"
+#include "lucid/CPUFeatures.h"
 #include <string.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define POCO_SHA2_X86 1
+	#include <immintrin.h>
+#endif
 
 
 namespace Lucid {
@@ -268,6 +273,274 @@ void _sha512_process(HASHCONTEXT* pContext, const unsigned char data[128])
 }
 
 
+#if defined(POCO_SHA2_X86)
+
+
+namespace
+{
+	#define SHA256_ROUNDS(m, k) \
+		msg = _mm_add_epi32(m, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K32 + k))); \
+		state1 = _mm_sha256rnds2_epu32(state1, state0, msg); \
+		state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E))
+
+	#define SHA256_SCHEDULE(m, mPrev, mNext) \
+		mNext = _mm_sha256msg2_epu32(_mm_add_epi32(mNext, _mm_alignr_epi8(m, mPrev, 4)), m); \
+		mPrev = _mm_sha256msg1_epu32(mPrev, m)
+
+
+	__attribute__((target("sha,sse4.1")))
+	void sha256ProcessSHANI(Lucid::UInt32 state[8], const unsigned char* data, std::size_t blocks)
+		/// Processes complete blocks with the SHA-NI instructions.
+		/// The instructions expect the state as ABEF and CDGH.
+	{
+		const __m128i mask = _mm_set_epi64x(0x0C0D0E0F08090A0BLL, 0x0405060700010203LL);
+
+		__m128i tmp    = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+		__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+		__m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+		state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+		__m128i msg;
+
+		for (; blocks > 0; --blocks, data += 64)
+		{
+			const __m128i state0Save = state0;
+			const __m128i state1Save = state1;
+
+			__m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), mask);
+			__m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), mask);
+			__m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), mask);
+			__m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), mask);
+
+			SHA256_ROUNDS(m0, 0);
+			SHA256_ROUNDS(m1, 4);
+			m0 = _mm_sha256msg1_epu32(m0, m1);
+			SHA256_ROUNDS(m2, 8);
+			m1 = _mm_sha256msg1_epu32(m1, m2);
+			SHA256_ROUNDS(m3, 12);
+			SHA256_SCHEDULE(m3, m2, m0);
+			SHA256_ROUNDS(m0, 16);
+			SHA256_SCHEDULE(m0, m3, m1);
+			SHA256_ROUNDS(m1, 20);
+			SHA256_SCHEDULE(m1, m0, m2);
+			SHA256_ROUNDS(m2, 24);
+			SHA256_SCHEDULE(m2, m1, m3);
+			SHA256_ROUNDS(m3, 28);
+			SHA256_SCHEDULE(m3, m2, m0);
+			SHA256_ROUNDS(m0, 32);
+			SHA256_SCHEDULE(m0, m3, m1);
+			SHA256_ROUNDS(m1, 36);
+			SHA256_SCHEDULE(m1, m0, m2);
+			SHA256_ROUNDS(m2, 40);
+			SHA256_SCHEDULE(m2, m1, m3);
+			SHA256_ROUNDS(m3, 44);
+			SHA256_SCHEDULE(m3, m2, m0);
+			SHA256_ROUNDS(m0, 48);
+			SHA256_SCHEDULE(m0, m3, m1);
+			SHA256_ROUNDS(m1, 52);
+			m2 = _mm_sha256msg2_epu32(_mm_add_epi32(m2, _mm_alignr_epi8(m1, m0, 4)), m1);
+			SHA256_ROUNDS(m2, 56);
+			m3 = _mm_sha256msg2_epu32(_mm_add_epi32(m3, _mm_alignr_epi8(m2, m1, 4)), m2);
+			SHA256_ROUNDS(m3, 60);
+
+			state0 = _mm_add_epi32(state0, state0Save);
+			state1 = _mm_add_epi32(state1, state1Save);
+		}
+
+		tmp    = _mm_shuffle_epi32(state0, 0x1B);
+		state1 = _mm_shuffle_epi32(state1, 0xB1);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(tmp, state1, 0xF0));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(state1, tmp, 8));
+	}
+
+
+	#undef SHA256_ROUNDS
+	#undef SHA256_SCHEDULE
+
+
+	__attribute__((target("avx2")))
+	inline __m256i rotr(__m256i x, int n)
+	{
+		return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+	}
+
+
+	__attribute__((target("avx2")))
+	inline void transpose(__m256i r[8])
+		/// Transposes an 8x8 matrix of 32-bit words.
+	{
+		const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+		const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+		const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+		const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+		const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+		const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+		const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+		const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+		const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+		const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+		const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+		const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+		const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+		const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+		const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+		const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+		r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+		r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+		r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+		r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+		r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+		r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+		r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+		r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+	}
+
+
+	__attribute__((target("avx2")))
+	void sha256ProcessX8(__m256i state[8], const unsigned char* const blocks[8], __m256i active)
+		/// Processes one block of each of eight independent messages,
+		/// with each message in one 32-bit lane. Lanes that are not
+		/// active keep their state.
+	{
+		const __m256i swap = _mm256_setr_epi8(
+			3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+			3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+		__m256i W[64];
+		for (int half = 0; half < 2; half++)
+		{
+			for (int i = 0; i < 8; i++)
+			{
+				W[8*half + i] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[i] + 32*half)), swap);
+			}
+			transpose(W + 8*half);
+		}
+		for (int t = 16; t < 64; t++)
+		{
+			const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr(W[t - 15], 7), rotr(W[t - 15], 18)), _mm256_srli_epi32(W[t - 15], 3));
+			const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr(W[t - 2], 17), rotr(W[t - 2], 19)), _mm256_srli_epi32(W[t - 2], 10));
+			W[t] = _mm256_add_epi32(_mm256_add_epi32(W[t - 16], s0), _mm256_add_epi32(W[t - 7], s1));
+		}
+
+		__m256i a = state[0], b = state[1], c = state[2], d = state[3];
+		__m256i e = state[4], f = state[5], g = state[6], h = state[7];
+		for (int t = 0; t < 64; t++)
+		{
+			const __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(rotr(e, 6), rotr(e, 11)), rotr(e, 25));
+			const __m256i ch = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+			const __m256i temp1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, S1), _mm256_add_epi32(ch, W[t])), _mm256_set1_epi32(static_cast<int>(K32[t])));
+			const __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(rotr(a, 2), rotr(a, 13)), rotr(a, 22));
+			const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+			h = g;
+			g = f;
+			f = e;
+			e = _mm256_add_epi32(d, temp1);
+			d = c;
+			c = b;
+			b = a;
+			a = _mm256_add_epi32(temp1, _mm256_add_epi32(S0, maj));
+		}
+
+		state[0] = _mm256_add_epi32(state[0], _mm256_and_si256(a, active));
+		state[1] = _mm256_add_epi32(state[1], _mm256_and_si256(b, active));
+		state[2] = _mm256_add_epi32(state[2], _mm256_and_si256(c, active));
+		state[3] = _mm256_add_epi32(state[3], _mm256_and_si256(d, active));
+		state[4] = _mm256_add_epi32(state[4], _mm256_and_si256(e, active));
+		state[5] = _mm256_add_epi32(state[5], _mm256_and_si256(f, active));
+		state[6] = _mm256_add_epi32(state[6], _mm256_and_si256(g, active));
+		state[7] = _mm256_add_epi32(state[7], _mm256_and_si256(h, active));
+	}
+
+
+	__attribute__((target("avx2")))
+	void sha256DigestX8(const Lucid::UInt32 iv[8], std::size_t count, const void* const data[], const std::size_t lengths[], unsigned char hashes[][32])
+		/// Computes the SHA-256 state of up to eight messages at once.
+		/// The final one or two blocks of each message, which contain
+		/// the padding, are built in a local buffer.
+	{
+		static const unsigned char zero[64] = {0};
+
+		unsigned char tails[8][128];
+		std::size_t fullBlocks[8];
+		std::size_t totalBlocks[8];
+		std::size_t maxBlocks = 0;
+		int counts[8];
+		for (std::size_t i = 0; i < 8; i++)
+		{
+			std::size_t length = i < count ? lengths[i] : 0;
+			std::size_t rest = length % 64;
+			fullBlocks[i]  = length/64;
+			totalBlocks[i] = i < count ? fullBlocks[i] + (rest < 56 ? 1 : 2) : 0;
+			if (totalBlocks[i] > maxBlocks) maxBlocks = totalBlocks[i];
+			counts[i] = static_cast<int>(totalBlocks[i]);
+
+			memset(tails[i], 0, sizeof(tails[i]));
+			if (i < count)
+			{
+				memcpy(tails[i], static_cast<const unsigned char*>(data[i]) + 64*fullBlocks[i], rest);
+				tails[i][rest] = 0x80;
+				std::size_t end = 64*(totalBlocks[i] - fullBlocks[i]);
+				Lucid::UInt64 bits = static_cast<Lucid::UInt64>(length) << 3;
+				for (int k = 0; k < 8; k++)
+				{
+					tails[i][end - 1 - k] = static_cast<unsigned char>(bits >> (8*k));
+				}
+			}
+		}
+
+		__m256i state[8];
+		for (int k = 0; k < 8; k++) state[k] = _mm256_set1_epi32(static_cast<int>(iv[k]));
+
+		const __m256i remaining = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(counts));
+		const unsigned char* blocks[8];
+		for (std::size_t n = 0; n < maxBlocks; n++)
+		{
+			for (std::size_t i = 0; i < 8; i++)
+			{
+				if (n < fullBlocks[i])
+					blocks[i] = static_cast<const unsigned char*>(data[i]) + 64*n;
+				else if (n < totalBlocks[i])
+					blocks[i] = tails[i] + 64*(n - fullBlocks[i]);
+				else
+					blocks[i] = zero;
+			}
+			const __m256i active = _mm256_cmpgt_epi32(remaining, _mm256_set1_epi32(static_cast<int>(n)));
+			sha256ProcessX8(state, blocks, active);
+		}
+
+		transpose(state);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			Lucid::UInt32 words[8];
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(words), state[i]);
+			for (int k = 0; k < 8; k++)
+			{
+				PUT_UINT32(words[k], hashes[i], 4*k);
+			}
+		}
+	}
+}
+
+
+#endif // POCO_SHA2_X86
+
+
+static void _sha256_process_blocks(HASHCONTEXT* pContext, const unsigned char* data, std::size_t blocks)
+{
+#if defined(POCO_SHA2_X86)
+	static const bool shaNI = CPUFeatures::hasSHA();
+	if (shaNI)
+	{
+		sha256ProcessSHANI(pContext->state.state32, data, blocks);
+		return;
+	}
+#endif
+	for (; blocks > 0; --blocks, data += 64)
+	{
+		_sha256_process(pContext, data);
+	}
+}
+
+
 void SHA2Engine::updateImpl(const void* buffer_, std::size_t count)
 {
 	if (_context == NULL || buffer_ == NULL || count == 0) return;
@@ -305,16 +578,17 @@ void SHA2Engine::updateImpl(const void* buffer_, std::size_t count)
 		if (left && count >= fill)
 		{
 			memcpy((void *)(pContext->buffer + left), data, fill);
-			_sha256_process(pContext, pContext->buffer);
+			_sha256_process_blocks(pContext, pContext->buffer, 1);
 			data += fill;
 			count -= fill;
 			left = 0;
 		}
-		while (count >= 64)
+		if (count >= 64)
 		{
-			_sha256_process(pContext, data);
-			data += 64;
-			count -= 64;
+			std::size_t blocks = count/64;
+			_sha256_process_blocks(pContext, data, blocks);
+			data += 64*blocks;
+			count -= 64*blocks;
 		}
 	}
 	if (count > 0) memcpy((void *)(pContext->buffer + left), data, count);
@@ -329,8 +603,10 @@ std::size_t SHA2Engine::digestLength() const
 
 void SHA2Engine::reset()
 {
-	if (_context != NULL) free(_context);
-	_context = calloc(1, sizeof(HASHCONTEXT));
+	if (_context == NULL)
+		_context = calloc(1, sizeof(HASHCONTEXT));
+	else
+		memset(_context, 0, sizeof(HASHCONTEXT));
 	HASHCONTEXT* pContext = (HASHCONTEXT*)_context;
 	pContext->size = _algorithm;
 	if (_algorithm == SHA_224)
@@ -380,6 +656,38 @@ void SHA2Engine::reset()
 }
 
 
+void SHA2Engine::digestBatch(ALGORITHM algorithm, std::size_t count, const void* const data[], const std::size_t lengths[], DigestEngine::Digest digests[])
+{
+	poco_assert (count == 0 || (data && lengths && digests));
+
+	SHA2Engine engine(algorithm);
+#if defined(POCO_SHA2_X86)
+	static const bool multiBuffer = CPUFeatures::hasAVX2() && !CPUFeatures::hasSHA();
+	if (multiBuffer && algorithm <= SHA_256)
+	{
+		const UInt32* iv = ((HASHCONTEXT*)engine._context)->state.state32;
+		const std::size_t length = engine.digestLength();
+		for (std::size_t i = 0; i < count; i += 8)
+		{
+			unsigned char hashes[8][32];
+			std::size_t n = count - i < 8 ? count - i : 8;
+			sha256DigestX8(iv, n, data + i, lengths + i, hashes);
+			for (std::size_t k = 0; k < n; k++)
+			{
+				digests[i + k].assign(hashes[k], hashes[k] + length);
+			}
+		}
+		return;
+	}
+#endif
+	for (std::size_t i = 0; i < count; i++)
+	{
+		engine.update(data[i], lengths[i]);
+		digests[i] = engine.digest();
+	}
+}
+
+
 const DigestEngine::Digest& SHA2Engine::digest()
 {
 	_digest.clear();
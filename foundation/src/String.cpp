@@ -13,11 +13,157 @@
 
 
 #include "lucid/String.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POCO_STRING_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 
 namespace Lucid {
 
 
+namespace
+{
+#if defined(POCO_STRING_SSE2)
+	inline __m128i maskRange(__m128i v, char first, char last)
+		/// Returns 0xFF for every byte in the range [first, last],
+		/// which must be ASCII.
+	{
+		return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(first - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8(last + 1)));
+	}
+
+
+	inline __m128i toLower16(__m128i v)
+	{
+		return _mm_or_si128(v, _mm_and_si128(maskRange(v, 'A', 'Z'), _mm_set1_epi8(0x20)));
+	}
+
+
+	inline __m128i toUpper16(__m128i v)
+	{
+		return _mm_andnot_si128(_mm_and_si128(maskRange(v, 'a', 'z'), _mm_set1_epi8(0x20)), v);
+	}
+
+
+	inline int firstBit(int mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+#endif // POCO_STRING_SSE2
+
+
+	inline UInt64 toLower8(UInt64 w)
+		/// Converts the upper-case ASCII characters in the
+		/// eight bytes of w to lower-case.
+	{
+		const UInt64 high = 0x8080808080808080ULL;
+		const UInt64 low7 = w & ~high;
+		const UInt64 geA  = low7 + 0x3F3F3F3F3F3F3F3FULL; // 0x80 - 'A'
+		const UInt64 gtZ  = low7 + 0x2525252525252525ULL; // 0x80 - 'Z' - 1
+		return w | (((geA & ~gtZ & ~w) & high) >> 2);
+	}
+}
+
+
+void toUpperInPlace(char* str, std::size_t length)
+{
+	std::size_t i = 0;
+#if defined(POCO_STRING_SSE2)
+	for (; length - i >= 16; i += 16)
+	{
+		__m128i* p = reinterpret_cast<__m128i*>(str + i);
+		_mm_storeu_si128(p, toUpper16(_mm_loadu_si128(p)));
+	}
+#endif
+	for (; i < length; i++) str[i] = static_cast<char>(Ascii::toUpper(str[i]));
+}
+
+
+void toLowerInPlace(char* str, std::size_t length)
+{
+	std::size_t i = 0;
+#if defined(POCO_STRING_SSE2)
+	for (; length - i >= 16; i += 16)
+	{
+		__m128i* p = reinterpret_cast<__m128i*>(str + i);
+		_mm_storeu_si128(p, toLower16(_mm_loadu_si128(p)));
+	}
+#endif
+	for (; i < length; i++) str[i] = static_cast<char>(Ascii::toLower(str[i]));
+}
+
+
+std::string toUpper(const StringView& str)
+{
+	std::string result(str.data(), str.size());
+	toUpperInPlace(result);
+	return result;
+}
+
+
+std::string toLower(const StringView& str)
+{
+	std::string result(str.data(), str.size());
+	toLowerInPlace(result);
+	return result;
+}
+
+
+int icompare(const StringView& str1, const StringView& str2)
+{
+	const char* p1 = str1.data();
+	const char* p2 = str2.data();
+	std::size_t n = str1.size() < str2.size() ? str1.size() : str2.size();
+	std::size_t i = 0;
+#if defined(POCO_STRING_SSE2)
+	// Skip equal blocks; the first difference is evaluated below.
+	for (; n - i >= 16; i += 16)
+	{
+		__m128i a = toLower16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p1 + i)));
+		__m128i b = toLower16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p2 + i)));
+		int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+		if (mask != 0xFFFF)
+		{
+			i += firstBit(~mask);
+			break;
+		}
+	}
+#endif
+	for (; n - i >= 8; i += 8)
+	{
+		UInt64 a;
+		UInt64 b;
+		std::memcpy(&a, p1 + i, sizeof(a));
+		std::memcpy(&b, p2 + i, sizeof(b));
+		if (a != b && toLower8(a) != toLower8(b)) break;
+	}
+	for (; i < n; i++)
+	{
+		if (p1[i] == p2[i]) continue;
+		char c1 = static_cast<char>(Ascii::toLower(p1[i]));
+		char c2 = static_cast<char>(Ascii::toLower(p2[i]));
+		if (c1 < c2)
+			return -1;
+		else if (c1 > c2)
+			return 1;
+	}
+
+	if (str1.size() == n)
+		return str2.size() == n ? 0 : -1;
+	else
+		return 1;
+}
+
+
 #if defined(POCO_NO_TEMPLATE_ICOMPARE)
 
 
@@ -48,7 +194,7 @@ int icompare(const std::string& str, std::string::size_type pos, std::string::si
 
 int icompare(const std::string& str1, const std::string& str2)
 {
-	return icompare(str1, 0, str1.size(), str2.begin(), str2.end());
+	return icompare(StringView(str1), StringView(str2));
 }
 
 
@@ -13,7 +13,7 @@
 
 
 #include "lucid/StringTokenizer.h"
-#include "lucid/Ascii.h"
+#include "lucid/StringViewTokenizer.h"
 #include <algorithm>
 
 
@@ -22,37 +22,11 @@ namespace Lucid {
 
 StringTokenizer::StringTokenizer(const std::string& str, const std::string& separators, int options)
 {
-	std::string::const_iterator it = str.begin();
-	std::string::const_iterator end = str.end();
-	std::string token;
-	bool doTrim = ((options & TOK_TRIM) != 0);
-	bool ignoreEmpty = ((options & TOK_IGNORE_EMPTY) != 0);
-	bool lastToken = false;
-
-	for (; it != end; ++it)
+	StringViewTokenizer tokenizer(str, separators, options);
+	StringView token;
+	while (tokenizer.next(token))
 	{
-		if (separators.find(*it) != std::string::npos) 
-		{
-			if (doTrim) trim(token);
-			if (!token.empty() || !ignoreEmpty) _tokens.push_back(token);
-			if (!ignoreEmpty) lastToken = true;
-			token.clear();
-		}
-		else
-		{
-			token += *it;
-			lastToken = false;
-		}
-	}
-
-	if (!token.empty())
-	{
-		if (doTrim) trim(token);
-		if (!token.empty() || !ignoreEmpty) _tokens.push_back(token);
-	}
-	else if (lastToken) 
-	{
-		_tokens.push_back(std::string());
+		_tokens.push_back(token.toString());
 	}
 }
 
@@ -62,30 +36,6 @@ StringTokenizer::~StringTokenizer()
 }
 
 
-void StringTokenizer::trim(std::string& token)
-{
-	std::string::size_type front = 0;
-	std::string::size_type back = 0;
-	std::string::size_type length = token.length();
-	std::string::const_iterator tIt = token.begin();
-	std::string::const_iterator tEnd = token.end();
-	for (; tIt != tEnd; ++tIt, ++front)
-	{
-		if (!Ascii::isSpace(*tIt)) break;
-	}
-	if (tIt != tEnd)
-	{
-		std::string::const_reverse_iterator tRit = token.rbegin();
-		std::string::const_reverse_iterator tRend = token.rend();
-		for (; tRit != tRend; ++tRit, ++back)
-		{
-			if (!Ascii::isSpace(*tRit)) break;
-		}
-	}
-	token = token.substr(front, length - back - front);
-}
-
-
 std::size_t StringTokenizer::count(const std::string& token) const
 {
 	std::size_t result = 0;
@@ -15,6 +15,8 @@
 #include "lucid/TextConverter.h"
 #include "lucid/TextIterator.h"
 #include "lucid/TextEncoding.h"
+#include "lucid/UTF8String.h"
+#include <cstring>
 
 
 namespace {
@@ -22,6 +24,25 @@ namespace {
 	{
 		return ch;
 	}
+
+
+	bool isASCIICompatible(const Lucid::TextEncoding& encoding)
+		/// Returns true if every ASCII character is represented
+		/// by the corresponding single byte.
+	{
+		const Lucid::TextEncoding::CharacterMap& map = encoding.characterMap();
+		for (int i = 0; i < 0x80; i++)
+		{
+			if (map[i] != i) return false;
+		}
+		return true;
+	}
+
+
+	bool isUTF8(const Lucid::TextEncoding& encoding)
+	{
+		return std::strcmp(encoding.canonicalName(), "UTF-8") == 0;
+	}
 }
 
 
@@ -31,7 +52,10 @@ namespace Lucid {
 TextConverter::TextConverter(const TextEncoding& inEncoding, const TextEncoding& outEncoding, int defaultChar):
 	_inEncoding(inEncoding),
 	_outEncoding(outEncoding),
-	_defaultChar(defaultChar)
+	_defaultChar(defaultChar),
+	_asciiCompatible(isASCIICompatible(inEncoding) && isASCIICompatible(outEncoding)),
+	_utf8In(isUTF8(inEncoding)),
+	_utf8Out(isUTF8(outEncoding))
 {
 }
 
@@ -43,6 +67,19 @@ TextConverter::~TextConverter()
 
 int TextConverter::convert(const std::string& source, std::string& destination, Transform trans)
 {
+	// TextIterator and the buffer-based conversion only differ in the
+	// handling of malformed sequences, so valid UTF-8 can take the
+	// buffer-based path, which has the fast paths.
+	if (trans == nullTransform && _utf8In && _asciiCompatible && UTF8::isValid(source))
+	{
+		if (_utf8Out)
+		{
+			destination.append(source);
+			return 0;
+		}
+		return convert(source.data(), (int) source.size(), destination, trans);
+	}
+
 	int errors = 0;
 	TextIterator it(source, _inEncoding);
 	TextIterator end(source);
@@ -71,9 +108,24 @@ int TextConverter::convert(const void* source, int length, std::string& destinat
 	const unsigned char* it  = (const unsigned char*) source;
 	const unsigned char* end = (const unsigned char*) source + length;
 	unsigned char buffer[TextEncoding::MAX_SEQUENCE_LENGTH];
-	
+
+	const bool fastASCII = trans == nullTransform && _asciiCompatible;
+	if (fastASCII && _utf8In && _utf8Out && length > 0 && UTF8::isValid((const char*) source, length))
+	{
+		destination.append((const char*) source, length);
+		return 0;
+	}
+
 	while (it < end)
 	{
+		if (fastASCII)
+		{
+			std::size_t ascii = UTF8::asciiPrefix((const char*) it, end - it);
+			destination.append((const char*) it, ascii);
+			it += ascii;
+			if (it == end) break;
+		}
+
 		int n = _inEncoding.queryConvert(it, 1);
 		int uc;
 		int read = 1;
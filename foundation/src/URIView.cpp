@@ -0,0 +1,347 @@
+//
+// URIView.cpp
+//
+// Library: Foundation
+// Package: URI
+// Module:  URIView
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "lucid/URIView.h"
+#include "lucid/Exception.h"
+#include "lucid/NumberParser.h"
+
+
+namespace Lucid {
+
+
+namespace
+{
+	inline bool isSpecial(char c)
+		/// Returns true for the characters that decoding
+		/// must look at.
+	{
+		return c == '%' || c == '+' || c == '?';
+	}
+
+	void decodeImpl(const StringView& str, std::string& decodedStr, bool plusAsSpace, bool inQuery)
+	{
+		decodedStr.reserve(decodedStr.size() + str.size());
+		const char* it  = str.begin();
+		const char* end = str.end();
+		while (it != end)
+		{
+			const char* run = it;
+			while (it != end && !isSpecial(*it)) ++it;
+			decodedStr.append(run, it - run);
+			if (it == end) break;
+
+			char c = *it++;
+			if (c == '?') inQuery = true;
+			// spaces may be encoded as plus signs in the query
+			if (inQuery && plusAsSpace && c == '+') c = ' ';
+			else if (c == '%')
+			{
+				if (it == end) throw URISyntaxException("URI encoding: no hex digit following percent sign", str.toString());
+				char hi = *it++;
+				if (it == end) throw URISyntaxException("URI encoding: two hex digits must follow percent sign", str.toString());
+				char lo = *it++;
+				if (hi >= '0' && hi <= '9')
+					c = hi - '0';
+				else if (hi >= 'A' && hi <= 'F')
+					c = hi - 'A' + 10;
+				else if (hi >= 'a' && hi <= 'f')
+					c = hi - 'a' + 10;
+				else throw URISyntaxException("URI encoding: not a hex digit");
+				c *= 16;
+				if (lo >= '0' && lo <= '9')
+					c += lo - '0';
+				else if (lo >= 'A' && lo <= 'F')
+					c += lo - 'A' + 10;
+				else if (lo >= 'a' && lo <= 'f')
+					c += lo - 'a' + 10;
+				else throw URISyntaxException("URI encoding: not a hex digit");
+			}
+			decodedStr += c;
+		}
+	}
+
+	inline bool needsDecoding(const StringView& str)
+	{
+		for (char c: str)
+		{
+			if (c == '%' || c == '+') return true;
+		}
+		return false;
+	}
+}
+
+
+//
+// URIView::QueryParameterTokenizer
+//
+
+
+bool URIView::QueryParameterTokenizer::next(StringView& name, StringView& value)
+{
+	const char* begin = _query.data();
+	const char* end   = begin + _query.size();
+	const char* it    = begin + _pos;
+	if (it == end) return false;
+
+	const char* nameBegin = it;
+	while (it != end && *it != '=' && *it != '&') ++it;
+	name = StringView(nameBegin, it - nameBegin);
+	if (it != end && *it == '=')
+	{
+		const char* valueBegin = ++it;
+		while (it != end && *it != '&') ++it;
+		value = StringView(valueBegin, it - valueBegin);
+	}
+	else value = StringView();
+	if (it != end && *it == '&') ++it;
+	_pos = it - begin;
+	return true;
+}
+
+
+//
+// URIView
+//
+
+
+URIView::URIView():
+	_port(0)
+{
+}
+
+
+URIView::URIView(const StringView& uri):
+	_port(0)
+{
+	parse(uri);
+}
+
+
+URIView& URIView::operator = (const StringView& uri)
+{
+	clear();
+	parse(uri);
+	return *this;
+}
+
+
+void URIView::clear()
+{
+	_uri       = StringView();
+	_scheme    = StringView();
+	_authority = StringView();
+	_userInfo  = StringView();
+	_host      = StringView();
+	_port      = 0;
+	_path      = StringView();
+	_query     = StringView();
+	_fragment  = StringView();
+	_pathEtc   = StringView();
+}
+
+
+URI URIView::toURI() const
+{
+	return URI(_uri.toString());
+}
+
+
+unsigned short URIView::getPort() const
+{
+	if (_port == 0)
+	{
+		URI uri;
+		uri.setScheme(_scheme.toString());
+		return uri.getPort();
+	}
+	else return _port;
+}
+
+
+std::string URIView::getPath() const
+{
+	std::string path;
+	decode(_path, path);
+	return path;
+}
+
+
+bool URIView::getQueryParameter(const StringView& name, std::string& value) const
+{
+	QueryParameterTokenizer tok(_query);
+	StringView rawName;
+	StringView rawValue;
+	std::string decodedName;
+	while (tok.next(rawName, rawValue))
+	{
+		bool match;
+		if (needsDecoding(rawName))
+		{
+			decodedName.clear();
+			decodeQueryParameter(rawName, decodedName);
+			match = StringView(decodedName) == name;
+		}
+		else match = rawName == name;
+		if (match)
+		{
+			std::string decodedValue;
+			decodeQueryParameter(rawValue, decodedValue);
+			value.swap(decodedValue);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+std::string URIView::getFragment() const
+{
+	std::string fragment;
+	decode(_fragment, fragment);
+	return fragment;
+}
+
+
+bool URIView::empty() const
+{
+	return _scheme.empty() && _host.empty() && _path.empty() && _query.empty() && _fragment.empty();
+}
+
+
+void URIView::decode(const StringView& str, std::string& decodedStr, bool plusAsSpace)
+{
+	decodeImpl(str, decodedStr, plusAsSpace, false);
+}
+
+
+void URIView::decodeQueryParameter(const StringView& str, std::string& decodedStr)
+{
+	decodeImpl(str, decodedStr, true, true);
+}
+
+
+void URIView::parse(const StringView& uri)
+{
+	_uri = uri;
+	const char* begin = uri.begin();
+	const char* it    = begin;
+	const char* end   = uri.end();
+	if (it == end) return;
+	if (*it != '/' && *it != '.' && *it != '?' && *it != '#')
+	{
+		while (it != end && *it != ':' && *it != '?' && *it != '#' && *it != '/') ++it;
+		if (it != end && *it == ':')
+		{
+			const char* schemeEnd = it++;
+			if (it == end) throw URISyntaxException("URI scheme must be followed by authority or path", uri.toString());
+			_scheme = StringView(begin, schemeEnd - begin);
+			if (*it == '/')
+			{
+				++it;
+				if (it != end && *it == '/')
+				{
+					++it;
+					parseAuthority(it, end);
+				}
+				else --it;
+			}
+			parsePathEtc(it, end);
+		}
+		else
+		{
+			it = begin;
+			parsePathEtc(it, end);
+		}
+	}
+	else parsePathEtc(it, end);
+}
+
+
+void URIView::parseAuthority(const char*& it, const char* end)
+{
+	const char* begin = it;
+	const char* part  = it;
+	while (it != end && *it != '/' && *it != '?' && *it != '#')
+	{
+		if (*it == '@')
+		{
+			_userInfo = StringView(part, it - part);
+			part = it + 1;
+		}
+		++it;
+	}
+	_authority = StringView(begin, it - begin);
+	parseHostAndPort(part, it);
+}
+
+
+void URIView::parseHostAndPort(const char* it, const char* end)
+{
+	if (it == end) return;
+	if (*it == '[')
+	{
+		// IPv6 address
+		const char* host = ++it;
+		while (it != end && *it != ']') ++it;
+		if (it == end) throw URISyntaxException("unterminated IPv6 address");
+		_host = StringView(host, it - host);
+		++it;
+	}
+	else
+	{
+		const char* host = it;
+		while (it != end && *it != ':') ++it;
+		_host = StringView(host, it - host);
+	}
+	if (it != end && *it == ':')
+	{
+		++it;
+		if (it != end)
+		{
+			std::string port(it, end);
+			int nport = 0;
+			if (NumberParser::tryParse(port, nport) && nport > 0 && nport < 65536)
+				_port = (unsigned short) nport;
+			else
+				throw URISyntaxException("bad or invalid port number", port);
+		}
+	}
+}
+
+
+void URIView::parsePathEtc(const char*& it, const char* end)
+{
+	_pathEtc = StringView(it, end - it);
+	if (it == end) return;
+	if (*it != '?' && *it != '#')
+	{
+		const char* path = it;
+		while (it != end && *it != '?' && *it != '#') ++it;
+		_path = StringView(path, it - path);
+	}
+	if (it != end && *it == '?')
+	{
+		const char* query = ++it;
+		while (it != end && *it != '#') ++it;
+		_query = StringView(query, it - query);
+	}
+	if (it != end && *it == '#')
+	{
+		++it;
+		_fragment = StringView(it, end - it);
+		it = end;
+	}
+}
+
+
+} // namespace Lucid
@@ -13,6 +13,7 @@
 
 
 #include "lucid/UTF8String.h"
+#include "lucid/CPUFeatures.h"
 #include "lucid/Unicode.h"
 #include "lucid/TextIterator.h"
 #include "lucid/TextConverter.h"
@@ -20,6 +21,11 @@
 #include "lucid/NumberFormatter.h"
 #include "lucid/Ascii.h"
 #include <algorithm>
+#include <cstring>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define POCO_UTF8_X86 1
+	#include <immintrin.h>
+#endif
 
 
 namespace Lucid {
@@ -28,6 +34,207 @@ namespace Lucid {
 namespace
 {
 	static UTF8Encoding utf8;
+
+
+	std::size_t asciiPrefixScalar(const unsigned char* p, std::size_t length, std::size_t done)
+	{
+		while (length - done >= 8)
+		{
+			UInt64 w;
+			std::memcpy(&w, p + done, sizeof(w));
+			if (w & 0x8080808080808080ULL) break;
+			done += 8;
+		}
+		while (done < length && p[done] < 0x80) ++done;
+		return done;
+	}
+
+
+	bool isValidScalar(const unsigned char* p, std::size_t length)
+	{
+		const unsigned char* end = p + length;
+		while (p != end)
+		{
+			p += asciiPrefixScalar(p, end - p, 0);
+			if (p == end) break;
+			unsigned char c = *p;
+			int seqLength = c >= 0xF0 ? 4 : (c >= 0xE0 ? 3 : (c >= 0xC0 ? 2 : 1));
+			if (end - p < seqLength || !UTF8Encoding::isLegal(p, seqLength)) return false;
+			p += seqLength;
+		}
+		return true;
+	}
+
+
+#if defined(POCO_UTF8_X86)
+
+
+	__attribute__((target("ssse3")))
+	std::size_t asciiPrefixSSSE3(const unsigned char* p, std::size_t length)
+	{
+		std::size_t done = 0;
+		for (; length - done >= 16; done += 16)
+		{
+			int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + done)));
+			if (mask) return done + __builtin_ctz(mask);
+		}
+		return asciiPrefixScalar(p, length, done);
+	}
+
+
+	// Error flags for the validation algorithm described in
+	// John Keiser, Daniel Lemire, "Validating UTF-8 In Less Than
+	// One Instruction Per Byte", Software: Practice and Experience 51(5), 2021.
+	// Every pair of adjacent bytes is classified by three table lookups
+	// (high nibble of the first byte, low nibble of the first byte, high
+	// nibble of the second byte); the pair is invalid if a flag is set in
+	// all three results.
+	enum
+	{
+		TOO_SHORT      = 1 << 0, // 11______ 0_______, 11______ 11______
+		TOO_LONG       = 1 << 1, // 0_______ 10______
+		OVERLONG_3     = 1 << 2, // 11100000 100_____
+		TOO_LARGE      = 1 << 3, // 11110100 1001____, 11110100 101_____, 11110101+ 10______
+		SURROGATE      = 1 << 4, // 11101101 101_____
+		OVERLONG_2     = 1 << 5, // 1100000_ 10______
+		TOO_LARGE_1000 = 1 << 6, // 11110101+ 1000____
+		OVERLONG_4     = 1 << 6, // 11110000 1000____
+		TWO_CONTS      = 1 << 7, // 10______ 10______
+		CARRY          = TOO_SHORT | TOO_LONG | TWO_CONTS
+	};
+
+
+	inline char toChar(int flags)
+	{
+		return static_cast<char>(flags);
+	}
+
+
+	__attribute__((target("ssse3")))
+	bool isValidSSSE3(const unsigned char* p, std::size_t length)
+	{
+		const __m128i byte1High = _mm_setr_epi8(
+			toChar(TOO_LONG), toChar(TOO_LONG), toChar(TOO_LONG), toChar(TOO_LONG),
+			toChar(TOO_LONG), toChar(TOO_LONG), toChar(TOO_LONG), toChar(TOO_LONG),
+			toChar(TWO_CONTS), toChar(TWO_CONTS), toChar(TWO_CONTS), toChar(TWO_CONTS),
+			toChar(TOO_SHORT | OVERLONG_2),
+			toChar(TOO_SHORT),
+			toChar(TOO_SHORT | OVERLONG_3 | SURROGATE),
+			toChar(TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4));
+		const __m128i byte1Low = _mm_setr_epi8(
+			toChar(CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4),
+			toChar(CARRY | OVERLONG_2),
+			toChar(CARRY),
+			toChar(CARRY),
+			toChar(CARRY | TOO_LARGE),
+			toChar(CARRY | TOO_LARGE | TOO_LARGE_1000),
+			toChar(CARRY | TOO_LARGE | TOO_LARGE_1000),
+			toChar(CARRY | TOO_LARGE | TOO_LARGE_1000),
+			toChar(CARRY | TOO_LARGE | TOO_LARGE_1000),
+			toChar(CARRY | TOO_LARGE | TOO_LARGE_1000),
+			toChar(CARRY | TOO_LARGE | TOO_LARGE_1000),
+			toChar(CARRY | TOO_LARGE | TOO_LARGE_1000),
+			toChar(CARRY | TOO_LARGE | TOO_LARGE_1000),
+			toChar(CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE),
+			toChar(CARRY | TOO_LARGE | TOO_LARGE_1000),
+			toChar(CARRY | TOO_LARGE | TOO_LARGE_1000));
+		const __m128i byte2High = _mm_setr_epi8(
+			toChar(TOO_SHORT), toChar(TOO_SHORT), toChar(TOO_SHORT), toChar(TOO_SHORT),
+			toChar(TOO_SHORT), toChar(TOO_SHORT), toChar(TOO_SHORT), toChar(TOO_SHORT),
+			toChar(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4),
+			toChar(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE),
+			toChar(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+			toChar(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+			toChar(TOO_SHORT), toChar(TOO_SHORT), toChar(TOO_SHORT), toChar(TOO_SHORT));
+		// A block is incomplete if one of its last three bytes starts
+		// a sequence that does not fit into the block.
+		const __m128i maxValue = _mm_setr_epi8(
+			toChar(0xFF), toChar(0xFF), toChar(0xFF), toChar(0xFF), toChar(0xFF), toChar(0xFF), toChar(0xFF), toChar(0xFF),
+			toChar(0xFF), toChar(0xFF), toChar(0xFF), toChar(0xFF), toChar(0xFF), toChar(0xF0 - 1), toChar(0xE0 - 1), toChar(0xC0 - 1));
+		const __m128i nibble = _mm_set1_epi8(0x0F);
+
+		__m128i prev = _mm_setzero_si128();
+		__m128i incomplete = _mm_setzero_si128();
+		__m128i error = _mm_setzero_si128();
+		std::size_t done = 0;
+		for (;;)
+		{
+			// The input is followed by a zero-padded block, so that a
+			// truncated sequence at the end is detected as TOO_SHORT.
+			const bool last = length - done < 16;
+			__m128i in;
+			if (last)
+			{
+				unsigned char tail[16] = {0};
+				if (length > done) std::memcpy(tail, p + done, length - done);
+				in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tail));
+			}
+			else in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + done));
+
+			if (_mm_movemask_epi8(in) == 0)
+			{
+				error = _mm_or_si128(error, incomplete);
+				incomplete = _mm_setzero_si128();
+			}
+			else
+			{
+				const __m128i prev1 = _mm_alignr_epi8(in, prev, 15);
+				const __m128i special = _mm_and_si128(
+					_mm_and_si128(
+						_mm_shuffle_epi8(byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+						_mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, nibble))),
+					_mm_shuffle_epi8(byte2High, _mm_and_si128(_mm_srli_epi16(in, 4), nibble)));
+				// The second continuation byte of a three or four byte
+				// sequence, and the third of a four byte sequence, must
+				// be flagged TWO_CONTS.
+				const __m128i third  = _mm_subs_epu8(_mm_alignr_epi8(in, prev, 14), _mm_set1_epi8(toChar(0xE0 - 0x80)));
+				const __m128i fourth = _mm_subs_epu8(_mm_alignr_epi8(in, prev, 13), _mm_set1_epi8(toChar(0xF0 - 0x80)));
+				const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(toChar(0x80)));
+				error = _mm_or_si128(error, _mm_xor_si128(must23, special));
+				incomplete = _mm_subs_epu8(in, maxValue);
+			}
+			prev = in;
+			if (last) break;
+			done += 16;
+		}
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+	}
+
+
+#endif // POCO_UTF8_X86
+
+
+	inline bool isPlain(unsigned char c)
+		/// Returns true if UTF8::escape() copies c unchanged.
+	{
+		return c >= 0x20 && c < 0x7F && c != '\\' && c != '"' && c != '/';
+	}
+
+
+	std::size_t plainPrefix(const char* data, std::size_t length)
+		/// Returns the length of the longest prefix of data
+		/// that UTF8::escape() copies unchanged.
+	{
+		std::size_t done = 0;
+#if defined(__SSE2__)
+		const __m128i space = _mm_set1_epi8(0x20);
+		const __m128i del   = _mm_set1_epi8(0x7F);
+		const __m128i bslash = _mm_set1_epi8('\\');
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i slash = _mm_set1_epi8('/');
+		for (; length - done >= 16; done += 16)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + done));
+			// Signed comparison: bytes >= 0x80 are negative and less than 0x20.
+			__m128i m = _mm_or_si128(_mm_cmplt_epi8(v, space), _mm_cmpeq_epi8(v, del));
+			m = _mm_or_si128(m, _mm_or_si128(_mm_cmpeq_epi8(v, bslash), _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, slash))));
+			int mask = _mm_movemask_epi8(m);
+			if (mask) return done + __builtin_ctz(mask);
+		}
+#endif
+		while (done < length && isPlain(static_cast<unsigned char>(data[done]))) ++done;
+		return done;
+	}
 }
 
 
@@ -172,6 +379,32 @@ void UTF8::removeBOM(std::string& str)
 }
 
 
+bool UTF8::isValid(const char* data, std::size_t length)
+{
+	poco_assert (data || length == 0);
+
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+#if defined(POCO_UTF8_X86)
+	static const bool ssse3 = CPUFeatures::hasSSSE3();
+	if (ssse3) return isValidSSSE3(p, length);
+#endif
+	return isValidScalar(p, length);
+}
+
+
+std::size_t UTF8::asciiPrefix(const char* data, std::size_t length)
+{
+	poco_assert (data || length == 0);
+
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+#if defined(POCO_UTF8_X86)
+	static const bool ssse3 = CPUFeatures::hasSSSE3();
+	if (ssse3) return asciiPrefixSSSE3(p, length);
+#endif
+	return asciiPrefixScalar(p, length, 0);
+}
+
+
 std::string UTF8::escape(const std::string &s, bool strictJSON)
 {
 	return escape(s.begin(), s.end(), strictJSON);
@@ -186,11 +419,20 @@ std::string UTF8::escape(const std::string::const_iterator& begin, const std::st
 	};
 
 	std::string result;
+	result.reserve(end - begin);
 
 	std::string::const_iterator it = begin;
 
 	while(it != end)
 	{
+		std::size_t plain = plainPrefix(&*it, end - it);
+		// In malformed input, a stray continuation byte is combined with
+		// the preceding character, so that character is left to the loop.
+		if (plain > 0 && it + plain != end && (it[plain] & 0xC0) == 0x80) --plain;
+		result.append(it, it + plain);
+		it += plain;
+		if (it == end) break;
+
 		Lucid::UInt32 ch = 0;
 		unsigned int sz = 0;
 
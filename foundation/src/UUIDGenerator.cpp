@@ -19,12 +19,193 @@
 #include "lucid/MD5Engine.h"
 #include "lucid/SHA1Engine.h"
 #include "lucid/SingletonHolder.h"
+#include "lucid/Exception.h"
 #include <cstring>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <pthread.h>
+#endif
 
 
 namespace Lucid {
 
 
+namespace
+{
+#if defined(POCO_OS_FAMILY_UNIX)
+	UInt32 forkGeneration = 0;
+		/// Incremented in the child process after fork(), so that
+		/// the child does not repeat the parent's random numbers.
+
+	void onFork()
+	{
+		++forkGeneration;
+	}
+
+	bool registerForkHandler()
+	{
+		return pthread_atfork(0, 0, onFork) == 0;
+	}
+#endif
+
+
+	class ThreadRandom
+		/// A per-thread cryptographically secure random number generator,
+		/// using ChaCha20 with fast key erasure: each refill produces
+		/// a block of keystream, the first 32 bytes of which replace the
+		/// key, so that earlier output can't be reconstructed from the
+		/// current state. The key is seeded from RandomInputStream, and
+		/// reseeded periodically and after fork().
+		///
+		/// The class has no constructor, so that a thread_local instance
+		/// is zero-initialized without any per-thread setup code.
+	{
+	public:
+		void read(unsigned char* buffer, std::size_t length)
+		{
+#if defined(POCO_OS_FAMILY_UNIX)
+			if (_generation != forkGeneration)
+			{
+				_generation = forkGeneration;
+				_available  = 0;
+				_refills    = 0;
+			}
+#endif
+			while (length > 0)
+			{
+				if (_available == 0) refill();
+				std::size_t n = _available;
+				if (n > length) n = length;
+				unsigned char* p = _buffer + BUFFER_SIZE - _available;
+				std::memcpy(buffer, p, n);
+				std::memset(p, 0, n);
+				_available -= static_cast<UInt32>(n);
+				buffer     += n;
+				length     -= n;
+			}
+		}
+
+		void nextTimeOrdered(UInt64 millis, UInt64& outMillis, UInt32& outCounter)
+			/// Returns the timestamp and counter for the next time-ordered
+			/// UUID. Within a millisecond, the counter starts at a random
+			/// value below 2048 and is incremented. If it runs out, the
+			/// timestamp is advanced by one millisecond.
+		{
+			if (millis > _lastMillis)
+			{
+				unsigned char r[2];
+				read(r, sizeof(r));
+				_lastMillis = millis;
+				_counter = ((UInt32(r[0]) << 8) | r[1]) & 0x07FF;
+			}
+			else if (++_counter > 0x0FFF)
+			{
+				++_lastMillis;
+				_counter = 0;
+			}
+			outMillis  = _lastMillis;
+			outCounter = _counter;
+		}
+
+	private:
+		enum
+		{
+			BLOCK_SIZE     = 64,
+			BLOCKS         = 8,
+			BUFFER_SIZE    = BLOCK_SIZE*BLOCKS,
+			KEY_SIZE       = 32,
+			RESEED_REFILLS = 2048
+		};
+
+		static UInt32 rotl(UInt32 v, int n)
+		{
+			return (v << n) | (v >> (32 - n));
+		}
+
+		static void quarterRound(UInt32 x[16], int a, int b, int c, int d)
+		{
+			x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 16);
+			x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 12);
+			x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 8);
+			x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 7);
+		}
+
+		void refill()
+		{
+			if (_refills == 0)
+			{
+#if defined(POCO_OS_FAMILY_UNIX)
+				static const bool forkHandler = registerForkHandler();
+				(void) forkHandler;
+#endif
+				unsigned char seed[KEY_SIZE];
+				RandomInputStream ris;
+				ris.read(reinterpret_cast<char*>(seed), sizeof(seed));
+				for (int i = 0; i < 8; i++)
+				{
+					_key[i] ^= UInt32(seed[4*i]) | (UInt32(seed[4*i + 1]) << 8) | (UInt32(seed[4*i + 2]) << 16) | (UInt32(seed[4*i + 3]) << 24);
+				}
+				std::memset(seed, 0, sizeof(seed));
+				_refills = RESEED_REFILLS;
+			}
+			--_refills;
+
+			for (UInt32 block = 0; block < BLOCKS; block++)
+			{
+				UInt32 input[16] =
+				{
+					0x61707865, 0x3320646E, 0x79622D32, 0x6B206574,
+					_key[0], _key[1], _key[2], _key[3],
+					_key[4], _key[5], _key[6], _key[7],
+					block, 0, 0, 0
+				};
+				UInt32 x[16];
+				std::memcpy(x, input, sizeof(x));
+				for (int i = 0; i < 10; i++)
+				{
+					quarterRound(x, 0, 4,  8, 12);
+					quarterRound(x, 1, 5,  9, 13);
+					quarterRound(x, 2, 6, 10, 14);
+					quarterRound(x, 3, 7, 11, 15);
+					quarterRound(x, 0, 5, 10, 15);
+					quarterRound(x, 1, 6, 11, 12);
+					quarterRound(x, 2, 7,  8, 13);
+					quarterRound(x, 3, 4,  9, 14);
+				}
+				unsigned char* out = _buffer + BLOCK_SIZE*block;
+				for (int i = 0; i < 16; i++)
+				{
+					UInt32 v = x[i] + input[i];
+					out[4*i]     = static_cast<unsigned char>(v);
+					out[4*i + 1] = static_cast<unsigned char>(v >> 8);
+					out[4*i + 2] = static_cast<unsigned char>(v >> 16);
+					out[4*i + 3] = static_cast<unsigned char>(v >> 24);
+				}
+			}
+
+			for (int i = 0; i < 8; i++)
+			{
+				_key[i] = UInt32(_buffer[4*i]) | (UInt32(_buffer[4*i + 1]) << 8) | (UInt32(_buffer[4*i + 2]) << 16) | (UInt32(_buffer[4*i + 3]) << 24);
+			}
+			std::memset(_buffer, 0, KEY_SIZE);
+			_available = BUFFER_SIZE - KEY_SIZE;
+		}
+
+		UInt32 _key[8];
+		unsigned char _buffer[BUFFER_SIZE];
+		UInt32 _available;
+		UInt32 _refills;
+		UInt64 _lastMillis;
+		UInt32 _counter;
+#if defined(POCO_OS_FAMILY_UNIX)
+		UInt32 _generation;
+#endif
+	};
+
+
+	thread_local ThreadRandom threadRandom;
+}
+
+
 UUIDGenerator::UUIDGenerator(): _ticks(0), _haveNode(false)
 {
 }
@@ -93,10 +274,70 @@ UUID UUIDGenerator::createFromName(const UUID& nsid, const std::string& name, Di
 
 UUID UUIDGenerator::createRandom()
 {
-	char buffer[16];
-	RandomInputStream ris;
-	ris.read(buffer, sizeof(buffer));
-	return UUID(buffer, UUID::UUID_RANDOM);
+	unsigned char buffer[16];
+	threadRandom.read(buffer, sizeof(buffer));
+	return UUID(reinterpret_cast<const char*>(buffer), UUID::UUID_RANDOM);
+}
+
+
+UUID UUIDGenerator::createTimeOrdered()
+{
+	UInt64 millis;
+	UInt32 counter;
+	threadRandom.nextTimeOrdered(static_cast<UInt64>(Timestamp().epochMicroseconds()/1000), millis, counter);
+
+	unsigned char buffer[16];
+	buffer[0] = static_cast<unsigned char>(millis >> 40);
+	buffer[1] = static_cast<unsigned char>(millis >> 32);
+	buffer[2] = static_cast<unsigned char>(millis >> 24);
+	buffer[3] = static_cast<unsigned char>(millis >> 16);
+	buffer[4] = static_cast<unsigned char>(millis >> 8);
+	buffer[5] = static_cast<unsigned char>(millis);
+	buffer[6] = static_cast<unsigned char>(counter >> 8);
+	buffer[7] = static_cast<unsigned char>(counter);
+	threadRandom.read(buffer + 8, 8);
+	return UUID(reinterpret_cast<const char*>(buffer), UUID::UUID_TIME_ORDERED);
+}
+
+
+void UUIDGenerator::createMany(UUID uuids[], std::size_t count, UUID::Version version)
+{
+	poco_assert (uuids || count == 0);
+
+	switch (version)
+	{
+	case UUID::UUID_RANDOM:
+		{
+			unsigned char buffer[16*16];
+			while (count > 0)
+			{
+				std::size_t n = count < 16 ? count : 16;
+				threadRandom.read(buffer, 16*n);
+				for (std::size_t i = 0; i < n; i++)
+				{
+					*uuids++ = UUID(reinterpret_cast<const char*>(buffer + 16*i), UUID::UUID_RANDOM);
+				}
+				count -= n;
+			}
+		}
+		break;
+	case UUID::UUID_TIME_ORDERED:
+		for (; count > 0; --count) *uuids++ = createTimeOrdered();
+		break;
+	case UUID::UUID_TIME_BASED:
+		for (; count > 0; --count) *uuids++ = create();
+		break;
+	default:
+		throw InvalidArgumentException("Unsupported UUID version for createMany()");
+	}
+}
+
+
+std::vector<UUID> UUIDGenerator::createMany(std::size_t count, UUID::Version version)
+{
+	std::vector<UUID> uuids(count);
+	if (count > 0) createMany(&uuids[0], count, version);
+	return uuids;
 }
 
 
@@ -18,131 +18,338 @@
 #include "lucid/UTF8Encoding.h"
 #include "lucid/UTF16Encoding.h"
 #include "lucid/UTF32Encoding.h"
+#include "lucid/UTF8String.h"
 #include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POCO_UNICODECONVERTER_SSE2
+#endif
 
 
 namespace Lucid {
 
 
-void UnicodeConverter::convert(const std::string& utf8String, UTF32String& utf32String)
+namespace
 {
-	utf32String.clear();
-	UTF8Encoding utf8Encoding;
-	TextIterator it(utf8String, utf8Encoding);
-	TextIterator end(utf8String);
+	inline UTF16Char* put(UInt32 c, UTF16Char* out)
+	{
+		if (c <= 0xFFFF)
+		{
+			*out++ = static_cast<UTF16Char>(c);
+		}
+		else
+		{
+			c -= 0x10000;
+			*out++ = static_cast<UTF16Char>(((c >> 10) & 0x3FF) | 0xD800);
+			*out++ = static_cast<UTF16Char>((c & 0x3FF) | 0xDC00);
+		}
+		return out;
+	}
+
 
-	while (it != end)
+	inline UTF32Char* put(UInt32 c, UTF32Char* out)
 	{
-		int cc = *it++;
-		utf32String += (UTF32Char) cc;
+		*out++ = static_cast<UTF32Char>(c);
+		return out;
 	}
-}
 
 
-void UnicodeConverter::convert(const char* utf8String, std::size_t length, UTF32String& utf32String)
-{
-	if (!utf8String || !length)
+	template <typename C>
+	C* widenASCII(const unsigned char* in, std::size_t length, C* out)
 	{
-		utf32String.clear();
-		return;
+		for (std::size_t i = 0; i < length; i++) out[i] = static_cast<C>(in[i]);
+		return out + length;
 	}
 
-	convert(std::string(utf8String, utf8String + length), utf32String);
-}
 
+#if defined(POCO_UNICODECONVERTER_SSE2)
 
-void UnicodeConverter::convert(const char* utf8String, UTF32String& utf32String)
-{
-	if (!utf8String || !std::strlen(utf8String))
+
+	template <>
+	UTF16Char* widenASCII<UTF16Char>(const unsigned char* in, std::size_t length, UTF16Char* out)
 	{
-		utf32String.clear();
-		return;
+		const __m128i zero = _mm_setzero_si128();
+		std::size_t i = 0;
+		for (; length - i >= 16; i += 16)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi8(v, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpackhi_epi8(v, zero));
+		}
+		for (; i < length; i++) out[i] = in[i];
+		return out + length;
 	}
 
-	convert(utf8String, std::strlen(utf8String), utf32String);
-}
 
+#endif // POCO_UNICODECONVERTER_SSE2
 
-void UnicodeConverter::convert(const std::string& utf8String, UTF16String& utf16String)
-{
-	utf16String.clear();
-	UTF8Encoding utf8Encoding;
-	TextIterator it(utf8String, utf8Encoding);
-	TextIterator end(utf8String);
-	while (it != end) 
+
+	template <typename C>
+	std::size_t decodeUTF8(const char* utf8String, std::size_t length, C* out)
+		/// Decodes well-formed UTF-8 (see UTF8::isValid()) and
+		/// returns the number of code units written, which is
+		/// at most length.
 	{
-		int cc = *it++;
-		if (cc <= 0xffff)
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(utf8String);
+		const unsigned char* end = p + length;
+		C* begin = out;
+		while (p != end)
 		{
-			utf16String += (UTF16Char) cc;
+			std::size_t n = UTF8::asciiPrefix(reinterpret_cast<const char*>(p), end - p);
+			out = widenASCII(p, n, out);
+			p += n;
+			while (p != end && *p >= 0x80)
+			{
+				UInt32 c = *p;
+				if (c < 0xE0)
+				{
+					c = ((c & 0x1F) << 6) | (p[1] & 0x3F);
+					p += 2;
+				}
+				else if (c < 0xF0)
+				{
+					c = ((c & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+					p += 3;
+				}
+				else
+				{
+					c = ((c & 0x07) << 18) | ((p[1] & 0x3F) << 12) | ((p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+					p += 4;
+				}
+				out = put(c, out);
+			}
+		}
+		return out - begin;
+	}
+
+
+	inline char* encodeUTF8(UInt32 c, char* out)
+		/// Encodes a code point up to U+10FFFF.
+	{
+		if (c < 0x80)
+		{
+			*out++ = static_cast<char>(c);
+		}
+		else if (c < 0x800)
+		{
+			*out++ = static_cast<char>(0xC0 | (c >> 6));
+			*out++ = static_cast<char>(0x80 | (c & 0x3F));
+		}
+		else if (c < 0x10000)
+		{
+			*out++ = static_cast<char>(0xE0 | (c >> 12));
+			*out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+			*out++ = static_cast<char>(0x80 | (c & 0x3F));
 		}
 		else
 		{
-			cc -= 0x10000;
-			utf16String += (UTF16Char) ((cc >> 10) & 0x3ff) | 0xd800;
-			utf16String += (UTF16Char) (cc & 0x3ff) | 0xdc00;
+			*out++ = static_cast<char>(0xF0 | (c >> 18));
+			*out++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+			*out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+			*out++ = static_cast<char>(0x80 | (c & 0x3F));
 		}
+		return out;
 	}
-}
 
 
-void UnicodeConverter::convert(const char* utf8String,  std::size_t length, UTF16String& utf16String)
-{
-	if (!utf8String || !length)
+	std::size_t encodeUTF16(const UTF16Char* in, std::size_t length, char* out, std::size_t& written)
+		/// Converts UTF-16 to UTF-8, stopping at the first unpaired
+		/// surrogate. Returns the number of code units consumed. The
+		/// output buffer must have room for 3*length characters.
+	{
+		char* begin = out;
+		std::size_t i = 0;
+		while (i < length)
+		{
+#if defined(POCO_UNICODECONVERTER_SSE2)
+			const __m128i mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+			const __m128i zero = _mm_setzero_si128();
+			while (length - i >= 16)
+			{
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));
+				const __m128i high = _mm_and_si128(_mm_or_si128(a, b), mask);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF) break;
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(a, b));
+				out += 16;
+				i += 16;
+			}
+			if (i == length) break;
+#endif
+			UInt32 c = static_cast<UInt16>(in[i]);
+			if (c >= 0xD800 && c < 0xE000)
+			{
+				if (c >= 0xDC00 || i + 1 == length) break;
+				UInt32 c2 = static_cast<UInt16>(in[i + 1]);
+				if (c2 < 0xDC00 || c2 >= 0xE000) break;
+				c = ((c & 0x3FF) << 10) + (c2 & 0x3FF) + 0x10000;
+				++i;
+			}
+			out = encodeUTF8(c, out);
+			++i;
+		}
+		written = out - begin;
+		return i;
+	}
+
+
+	std::size_t encodeUTF32(const UTF32Char* in, std::size_t length, char* out, std::size_t& written)
+		/// Converts UTF-32 to UTF-8, stopping at the first surrogate or
+		/// value that is not a code point. Returns the number of code
+		/// units consumed. The output buffer must have room for 4*length
+		/// characters.
 	{
-		utf16String.clear();
-		return;
+		char* begin = out;
+		std::size_t i = 0;
+		for (; i < length; i++)
+		{
+			UInt32 c = static_cast<UInt32>(in[i]);
+			if ((c >= 0xD800 && c < 0xE000) || c > 0x10FFFF) break;
+			out = encodeUTF8(c, out);
+		}
+		written = out - begin;
+		return i;
 	}
 
-	convert(std::string(utf8String, utf8String + length), utf16String);
-}
 
+	void convertInvalid(const std::string& utf8String, UTF32String& utf32String)
+	{
+		UTF8Encoding utf8Encoding;
+		TextIterator it(utf8String, utf8Encoding);
+		TextIterator end(utf8String);
 
-void UnicodeConverter::convert(const char* utf8String, UTF16String& utf16String)
-{
-	if (!utf8String || !std::strlen(utf8String))
+		while (it != end)
+		{
+			int cc = *it++;
+			utf32String += (UTF32Char) cc;
+		}
+	}
+
+
+	void convertInvalid(const std::string& utf8String, UTF16String& utf16String)
 	{
-		utf16String.clear();
-		return;
+		UTF8Encoding utf8Encoding;
+		TextIterator it(utf8String, utf8Encoding);
+		TextIterator end(utf8String);
+		while (it != end) 
+		{
+			int cc = *it++;
+			if (cc <= 0xffff)
+			{
+				utf16String += (UTF16Char) cc;
+			}
+			else
+			{
+				cc -= 0x10000;
+				utf16String += (UTF16Char) ((cc >> 10) & 0x3ff) | 0xd800;
+				utf16String += (UTF16Char) (cc & 0x3ff) | 0xdc00;
+			}
+		}
 	}
 
-	convert(std::string(utf8String), utf16String);
+
+	template <typename S>
+	void convertUTF8(const char* utf8String, std::size_t length, S& utfString)
+	{
+		utfString.clear();
+		if (!utf8String || !length) return;
+
+		if (UTF8::isValid(utf8String, length))
+		{
+			utfString.resize(length);
+			utfString.resize(decodeUTF8(utf8String, length, &utfString[0]));
+		}
+		else convertInvalid(std::string(utf8String, length), utfString);
+	}
+}
+
+
+void UnicodeConverter::convert(const std::string& utf8String, UTF32String& utf32String)
+{
+	convertUTF8(utf8String.data(), utf8String.size(), utf32String);
+}
+
+
+void UnicodeConverter::convert(const char* utf8String, std::size_t length, UTF32String& utf32String)
+{
+	convertUTF8(utf8String, length, utf32String);
+}
+
+
+void UnicodeConverter::convert(const char* utf8String, UTF32String& utf32String)
+{
+	convertUTF8(utf8String, utf8String ? std::strlen(utf8String) : 0, utf32String);
+}
+
+
+void UnicodeConverter::convert(const std::string& utf8String, UTF16String& utf16String)
+{
+	convertUTF8(utf8String.data(), utf8String.size(), utf16String);
+}
+
+
+void UnicodeConverter::convert(const char* utf8String,  std::size_t length, UTF16String& utf16String)
+{
+	convertUTF8(utf8String, length, utf16String);
+}
+
+
+void UnicodeConverter::convert(const char* utf8String, UTF16String& utf16String)
+{
+	convertUTF8(utf8String, utf8String ? std::strlen(utf8String) : 0, utf16String);
 }
 
 
 void UnicodeConverter::convert(const UTF16String& utf16String, std::string& utf8String)
 {
-	utf8String.clear();
-	UTF8Encoding utf8Encoding;
-	UTF16Encoding utf16Encoding;
-	TextConverter converter(utf16Encoding, utf8Encoding);
-	converter.convert(utf16String.data(), (int) utf16String.length() * sizeof(UTF16Char), utf8String);
+	convert(utf16String.data(), utf16String.length(), utf8String);
 }
 
 
 void UnicodeConverter::convert(const UTF32String& utf32String, std::string& utf8String)
 {
-	utf8String.clear();
-	UTF8Encoding utf8Encoding;
-	UTF32Encoding utf32Encoding;
-	TextConverter converter(utf32Encoding, utf8Encoding);
-	converter.convert(utf32String.data(), (int) utf32String.length() * sizeof(UTF32Char), utf8String);
+	convert(utf32String.data(), utf32String.length(), utf8String);
 }
 
 
 void UnicodeConverter::convert(const UTF16Char* utf16String,  std::size_t length, std::string& utf8String)
 {
 	utf8String.clear();
-	UTF8Encoding utf8Encoding;
-	UTF16Encoding utf16Encoding;
-	TextConverter converter(utf16Encoding, utf8Encoding);
-	converter.convert(utf16String, (int) length * sizeof(UTF16Char), utf8String);
+	if (!length) return;
+
+	// Well-formed input is converted directly. From the first unpaired
+	// surrogate on, the TextConverter takes over to handle it exactly
+	// as before.
+	std::size_t written;
+	utf8String.resize(3*length);
+	std::size_t done = encodeUTF16(utf16String, length, &utf8String[0], written);
+	utf8String.resize(written);
+	if (done < length)
+	{
+		UTF8Encoding utf8Encoding;
+		UTF16Encoding utf16Encoding;
+		TextConverter converter(utf16Encoding, utf8Encoding);
+		converter.convert(utf16String + done, (int) (length - done) * sizeof(UTF16Char), utf8String);
+	}
 }
 
 
 void UnicodeConverter::convert(const UTF32Char* utf32String,  std::size_t length, std::string& utf8String)
 {
-	toUTF8(UTF32String(utf32String, length), utf8String);
+	utf8String.clear();
+	if (!length) return;
+
+	std::size_t written;
+	utf8String.resize(4*length);
+	std::size_t done = encodeUTF32(utf32String, length, &utf8String[0], written);
+	utf8String.resize(written);
+	if (done < length)
+	{
+		UTF8Encoding utf8Encoding;
+		UTF32Encoding utf32Encoding;
+		TextConverter converter(utf32Encoding, utf8Encoding);
+		converter.convert(utf32String + done, (int) (length - done) * sizeof(UTF32Char), utf8String);
+	}
 }
 
 
@@ -104,6 +104,10 @@ public:
 	dynamic::Var parse(std::istream& in);
 		/// Parses JSON from an input stream.
 
+	dynamic::Var parse(const char* json, std::size_t size);
+		/// Parses JSON from the given buffer, e.g. a memory
+		/// mapped file, without copying it first.
+
 	void setHandler(const Handler::Ptr& pHandler);
 		/// Set the Handler.
 
@@ -197,6 +201,12 @@ inline dynamic::Var Parser::parse(std::istream& in)
 }
 
 
+inline dynamic::Var Parser::parse(const char* json, std::size_t size)
+{
+	return parseImpl(json, size);
+}
+
+
 } } // namespace Lucid::JSON
 
 
@@ -81,6 +81,9 @@ protected:
 	dynamic::Var parseImpl(std::istream& in);
 		/// Parses JSON from an input stream.
 
+	dynamic::Var parseImpl(const char* json, std::size_t size);
+		/// Parses JSON from a buffer.
+
 	void setHandlerImpl(const Handler::Ptr& pHandler);
 		/// Set the Handler.
 
@@ -100,7 +103,7 @@ private:
 	void handleArray();
 	void handleObject();
 	void handle();
-	void handle(const std::string& json);
+	void handle(const char* json, std::size_t size);
 	void stripComments(std::string& json);
 	bool checkError();
 
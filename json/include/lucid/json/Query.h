@@ -21,6 +21,7 @@
 #include "lucid/JSON/JSON.h"
 #include "lucid/JSON/Object.h"
 #include "lucid/JSON/Array.h"
+#include "lucid/JSON/QueryPath.h"
 
 
 namespace Lucid {
@@ -85,6 +86,22 @@ public:
 		/// the name of the first child. When the value can't be found
 		/// an empty value is returned.
 
+	Object::Ptr findObject(const QueryPath& path) const;
+		/// Search for an object, using a compiled path.
+		/// See findObject(const std::string&).
+
+	Array::Ptr findArray(const QueryPath& path) const;
+		/// Search for an array, using a compiled path.
+		/// See findArray(const std::string&).
+
+	dynamic::Var find(const QueryPath& path) const;
+		/// Searches a value, using a compiled path.
+		///
+		/// Paths that are searched repeatedly should be
+		/// compiled once into a QueryPath and searched with
+		/// this method, as parsing the path is usually more
+		/// expensive than the search itself.
+
 	template<typename T>
 	T findValue(const std::string& path, const T& def) const
 		/// Searches for a value will convert it to the given type.
@@ -0,0 +1,104 @@
+//
+// QueryPath.h
+//
+// Library: JSON
+// Package: JSON
+// Module:  QueryPath
+//
+// Definition of the QueryPath class.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef JSON_QueryPath_INCLUDED
+#define JSON_QueryPath_INCLUDED
+
+
+#include "lucid/JSON/JSON.h"
+#include "lucid/dynamic/Var.h"
+#include <vector>
+
+
+namespace Lucid {
+namespace JSON {
+
+
+class JSON_API QueryPath
+	/// A compiled path expression, as used by Query.
+	///
+	/// A path like "person.children[0].name" is split into its
+	/// member names and array indexes once, when the QueryPath is
+	/// created, instead of on every search. A QueryPath can be
+	/// evaluated against any number of JSON values, which makes it
+	/// suitable for paths that are used repeatedly, e.g. by Template:
+	///
+	///     QueryPath path("person.children[0].name");
+	///     Query query(data);
+	///     Var name = query.find(path);
+	///
+	/// The result of a search with a QueryPath is the same as the
+	/// result of a search with the path string.
+{
+public:
+	QueryPath();
+		/// Creates an empty QueryPath, which
+		/// evaluates to the searched value itself.
+
+	explicit QueryPath(const std::string& path);
+		/// Compiles the given path expression.
+
+	~QueryPath();
+		/// Destroys the QueryPath.
+
+	const std::string& toString() const;
+		/// Returns the path expression the QueryPath
+		/// has been compiled from.
+
+	bool empty() const;
+		/// Returns true if the path has no member
+		/// names or array indexes.
+
+	dynamic::Var find(const dynamic::Var& source) const;
+		/// Evaluates the path against the given JSON Object, Array,
+		/// or pointer thereof and returns the value found, or an
+		/// empty value if the value can't be found.
+
+private:
+	struct Step
+		/// A member name, followed by zero or more array indexes.
+		/// Either may be empty.
+	{
+		std::string name;
+		std::vector<unsigned> indexes;
+		std::string invalidIndex;
+			/// An index that is too large to be parsed. Searching the
+			/// step fails with a SyntaxException, as Query does.
+	};
+
+	std::string _path;
+	std::vector<Step> _steps;
+};
+
+
+//
+// inlines
+//
+inline const std::string& QueryPath::toString() const
+{
+	return _path;
+}
+
+
+inline bool QueryPath::empty() const
+{
+	return _steps.empty();
+}
+
+
+} } // namespace Lucid::JSON
+
+
+#endif // JSON_QueryPath_INCLUDED
@@ -112,6 +112,22 @@ public:
 
 	void render(const dynamic::Var& data, std::ostream& out) const;
 		/// Renders the template and send the output to the stream.
+		///
+		/// The output is rendered into a buffer first, and written
+		/// to the stream with a single write.
+
+	void render(const dynamic::Var& data, std::string& out) const;
+		/// Renders the template and appends the output to out.
+		///
+		/// Clearing and reusing the same string for subsequent
+		/// renders avoids reallocating the buffer. The buffer can be
+		/// sent with HTTPServerResponse::sendBuffer(), which writes
+		/// the response header and the buffer with a single call:
+		///
+		///     std::string& buffer = ...;
+		///     buffer.clear();
+		///     tpl->render(data, buffer);
+		///     response.sendBuffer(buffer.data(), buffer.size());
 
 private:
 	std::string readText(std::istream& in);
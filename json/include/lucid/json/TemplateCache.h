@@ -23,8 +23,11 @@
 #include "lucid/Path.h"
 #include "lucid/SharedPtr.h"
 #include "lucid/Logger.h"
+#include "lucid/Mutex.h"
+#include "lucid/DirectoryWatcher.h"
 #include <vector>
 #include <map>
+#include <set>
 
 
 namespace Lucid {
@@ -37,6 +40,18 @@ class JSON_API TemplateCache
 	/// When a template file has changed, the cache
 	/// will remove the old template from the cache
 	/// and load a new one.
+	///
+	/// Changes are detected with a DirectoryWatcher for every
+	/// directory containing a cached template, and for every
+	/// include path, so that looking up a cached template does
+	/// not need to access the file system. Relative paths are
+	/// resolved once, and resolved again after a change in one
+	/// of the watched directories. If a directory cannot be
+	/// watched, or if DirectoryWatcher is not available
+	/// (POCO_NO_INOTIFY), the modification time of the template
+	/// file is checked on every lookup instead.
+	///
+	/// The TemplateCache can be used by multiple threads.
 {
 public:
 	TemplateCache();
@@ -68,25 +83,39 @@ public:
 		/// Sets the logger for the cache.
 
 private:
+	struct Entry
+	{
+		Template::Ptr tpl;
+		std::string   file;
+			/// The absolute path of the template file.
+		std::string   directory;
+			/// The watched directory containing the template,
+			/// or empty if the template file must be checked.
+	};
+
 	void setup();
-	Path resolvePath(const Path& path) const;
+	Path resolvePath(const Path& path);
+	Template::Ptr loadTemplate(const Path& templatePath);
+	bool watchDirectory(const std::string& directory);
+#ifndef POCO_NO_INOTIFY
+	void onDirectoryChanged(const void* pSender, const DirectoryWatcher::DirectoryChangeList& changes);
+#endif
 
 	static TemplateCache*                _pInstance;
 	std::vector<Path>                    _includePaths;
-	std::map<std::string, Template::Ptr> _cache;
+	std::map<std::string, Entry>         _cache;
+	std::map<std::string, Path>          _resolvedPaths;
+#ifndef POCO_NO_INOTIFY
+	std::map<std::string, SharedPtr<DirectoryWatcher>> _watchers;
+#endif
 	Logger*                              _pLogger;
+	FastMutex                            _mutex;
 };
 
 
 //
 // inlines
 //
-inline void TemplateCache::addPath(const Path& path)
-{
-	_includePaths.push_back(path);
-}
-
-
 inline TemplateCache* TemplateCache::instance()
 {
 	return _pInstance;
@@ -21,6 +21,7 @@
 #include "lucid/StreamCopier.h"
 #undef min
 #undef max
+#include <algorithm>
 #include <limits>
 #include <clocale>
 #include <istream>
@@ -51,14 +52,15 @@ ParserImpl::~ParserImpl()
 }
 
 
-void ParserImpl::handle(const std::string& json)
+void ParserImpl::handle(const char* json, std::size_t size)
 {
-	if (!_allowNullByte && json.find("\\u0000") != json.npos)
+	static const char nullByte[] = "\\u0000";
+	if (!_allowNullByte && std::search(json, json + size, nullByte, nullByte + sizeof(nullByte) - 1) != json + size)
 		throw JSONException("Null bytes in strings not allowed.");
 
 	try
 	{
-		json_open_buffer(_pJSON, json.data(), json.size());
+		json_open_buffer(_pJSON, json, size);
 		checkError();
 		//////////////////////////////////
 		// Underlying parser is capable of parsing multiple consecutive JSONs;
@@ -82,27 +84,33 @@ void ParserImpl::handle(const std::string& json)
 
 
 dynamic::Var ParserImpl::parseImpl(const std::string& json)
+{
+	return parseImpl(json.data(), json.size());
+}
+
+
+dynamic::Var ParserImpl::parseImpl(std::istream& in)
+{
+	std::string json;
+	StreamCopier::copyToString(in, json);
+	return parseImpl(json);
+}
+
+
+dynamic::Var ParserImpl::parseImpl(const char* json, std::size_t size)
 {
 	if (_allowComments)
 	{
-		std::string str = json;
+		std::string str(json, size);
 		stripComments(str);
-		handle(str);
+		handle(str.data(), str.size());
 	}
-	else handle(json);
+	else handle(json, size);
 
 	return asVarImpl();
 }
 
 
-dynamic::Var ParserImpl::parseImpl(std::istream& in)
-{
-	std::ostringstream os;
-	StreamCopier::copyStream(in, os);
-	return parseImpl(os.str());
-}
-
-
 void ParserImpl::stripComments(std::string& json)
 {
 	if (_allowComments)
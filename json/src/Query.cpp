@@ -13,10 +13,6 @@
 
 
 #include "lucid/JSON/Query.h"
-#include "lucid/StringTokenizer.h"
-#include "lucid/RegularExpression.h"
-#include "lucid/NumberParser.h"
-#include <sstream>
 
 
 using Lucid::dynamic::Var;
@@ -98,74 +94,41 @@ Array& Query::findArray(const std::string& path, Array& arr) const
 }
 
 
+Object::Ptr Query::findObject(const QueryPath& path) const
+{
+	Var result = find(path);
+
+	if (result.type() == typeid(Object::Ptr))
+		return result.extract<Object::Ptr>();
+	else if (result.type() == typeid(Object))
+		return new Object(result.extract<Object>());
+
+	return 0;
+}
+
+
+Array::Ptr Query::findArray(const QueryPath& path) const
+{
+	Var result = find(path);
+
+	if (result.type() == typeid(Array::Ptr))
+		return result.extract<Array::Ptr>();
+	else if (result.type() == typeid(Array))
+		return new Array(result.extract<Array>());
+
+	return 0;
+}
+
+
 Var Query::find(const std::string& path) const
 {
-	Var result = _source;
-	StringTokenizer tokenizer(path, ".");
-	for (const auto& token: tokenizer)
-	{
-		if (!result.isEmpty())
-		{
-			std::vector<int> indexes;
-			RegularExpression::MatchVec matches;
-			int firstOffset = -1;
-			int offset = 0;
-			RegularExpression regex("\\[([0-9]+)\\]");
-			while (regex.match(token, offset, matches) > 0)
-			{
-				if (firstOffset == -1)
-				{
-					firstOffset = static_cast<int>(matches[0].offset);
-				}
-				std::string num(token, matches[1].offset, matches[1].length);
-				indexes.push_back(NumberParser::parse(num));
-				offset = static_cast<int>(matches[0].offset + matches[0].length);
-			}
-
-			std::string name(token);
-			if (firstOffset != -1)
-			{
-				name = name.substr(0, firstOffset);
-			}
-
-			if (name.length() > 0)
-			{
-				if (result.type() == typeid(Object::Ptr))
-				{
-					Object::Ptr o = result.extract<Object::Ptr>();
-					result = o->get(name);
-				}
-				else if (result.type() == typeid(Object))
-				{
-					Object o = result.extract<Object>();
-					result = o.get(name);
-				}
-				else
-					result.empty();
-
-			}
-
-			if (!result.isEmpty() && !indexes.empty())
-			{
-				for (auto i: indexes)
-				{
-					if (result.type() == typeid(Array::Ptr))
-					{
-						Array::Ptr array = result.extract<Array::Ptr>();
-						result = array->get(i);
-						if (result.isEmpty()) break;
-					}
-					else if (result.type() == typeid(Array))
-					{
-						Array array = result.extract<Array>();
-						result = array.get(i);
-						if (result.isEmpty()) break;
-					}
-				}
-			}
-		}
-	}
-	return result;
+	return QueryPath(path).find(_source);
+}
+
+
+Var Query::find(const QueryPath& path) const
+{
+	return path.find(_source);
 }
 
 
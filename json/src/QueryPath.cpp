@@ -0,0 +1,133 @@
+//
+// QueryPath.cpp
+//
+// Library: JSON
+// Package: JSON
+// Module:  QueryPath
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "lucid/JSON/QueryPath.h"
+#include "lucid/JSON/Object.h"
+#include "lucid/JSON/Array.h"
+#include "lucid/StringTokenizer.h"
+#include "lucid/NumberParser.h"
+#include "lucid/Ascii.h"
+#include <climits>
+
+
+using Lucid::dynamic::Var;
+
+
+namespace Lucid {
+namespace JSON {
+
+
+namespace
+{
+	bool matchIndex(const std::string& token, std::string::size_type pos, std::string::size_type& digits, std::string::size_type& end)
+		/// Returns true if an index ("[" followed by one or
+		/// more digits and "]") starts at pos.
+	{
+		if (token[pos] != '[') return false;
+		std::string::size_type it = pos + 1;
+		while (it < token.size() && Ascii::isDigit(token[it])) ++it;
+		if (it == pos + 1 || it == token.size() || token[it] != ']') return false;
+		digits = pos + 1;
+		end = it;
+		return true;
+	}
+}
+
+
+QueryPath::QueryPath()
+{
+}
+
+
+QueryPath::QueryPath(const std::string& path):
+	_path(path)
+{
+	StringTokenizer tokenizer(path, ".");
+	for (const auto& token: tokenizer)
+	{
+		Step step;
+		std::string::size_type firstOffset = std::string::npos;
+		std::string::size_type pos = 0;
+		while (pos < token.size())
+		{
+			std::string::size_type digits;
+			std::string::size_type end;
+			if (matchIndex(token, pos, digits, end))
+			{
+				if (firstOffset == std::string::npos) firstOffset = pos;
+				std::string num(token, digits, end - digits);
+				unsigned index;
+				if (step.invalidIndex.empty() && NumberParser::tryParseUnsigned(num, index) && index <= static_cast<unsigned>(INT_MAX))
+					step.indexes.push_back(index);
+				else if (step.invalidIndex.empty())
+					step.invalidIndex = num;
+				pos = end + 1;
+			}
+			else ++pos;
+		}
+		step.name.assign(token, 0, firstOffset);
+		if (!step.name.empty() || !step.indexes.empty() || !step.invalidIndex.empty())
+		{
+			_steps.push_back(step);
+		}
+	}
+}
+
+
+QueryPath::~QueryPath()
+{
+}
+
+
+Var QueryPath::find(const Var& source) const
+{
+	Var result = source;
+	for (const auto& step: _steps)
+	{
+		if (result.isEmpty()) break;
+
+		if (!step.invalidIndex.empty())
+		{
+			NumberParser::parse(step.invalidIndex);
+		}
+
+		if (!step.name.empty())
+		{
+			if (result.type() == typeid(Object::Ptr))
+				result = result.extract<Object::Ptr>()->get(step.name);
+			else if (result.type() == typeid(Object))
+				result = result.extract<Object>().get(step.name);
+			else
+				result.empty();
+		}
+
+		if (!result.isEmpty())
+		{
+			for (auto i: step.indexes)
+			{
+				if (result.type() == typeid(Array::Ptr))
+					result = result.extract<Array::Ptr>()->get(i);
+				else if (result.type() == typeid(Array))
+					result = result.extract<Array>().get(i);
+				else
+					continue;
+
+				if (result.isEmpty()) break;
+			}
+		}
+	}
+	return result;
+}
+
+
+} } // namespace Lucid::JSON
@@ -15,6 +15,7 @@
 #include "lucid/JSON/Template.h"
 #include "lucid/JSON/TemplateCache.h"
 #include "lucid/JSON/Query.h"
+#include "lucid/JSON/QueryPath.h"
 #include "lucid/File.h"
 #include "lucid/FileStream.h"
 
@@ -40,7 +41,8 @@ public:
 	{
 	}
 
-	virtual void render(const Var& data, std::ostream& out) const = 0;
+	virtual void render(const Var& data, std::string& out) const = 0;
+		/// Appends the rendered part to out.
 
 	typedef std::vector<SharedPtr<Part>> VectorParts;
 };
@@ -61,9 +63,9 @@ public:
 	{
 	}
 
-	void render(const Var& data, std::ostream& out) const
+	void render(const Var& data, std::string& out) const
 	{
-		out << _content;
+		out += _content;
 	}
 
 	void setContent(const std::string& content)
@@ -97,7 +99,7 @@ public:
 		_parts.push_back(part);
 	}
 
-	void render(const Var& data, std::ostream& out) const
+	void render(const Var& data, std::string& out) const
 	{
 		for (const auto& p: _parts)
 		{
@@ -121,26 +123,26 @@ public:
 	{
 	}
 
-	void render(const Var& data, std::ostream& out) const
+	void render(const Var& data, std::string& out) const
 	{
 		Query query(data);
 		Var value = query.find(_query);
 
 		if (!value.isEmpty())
 		{
-			out << value.convert<std::string>();
+			out += value.convert<std::string>();
 		}
 	}
 
 private:
-	std::string _query;
+	QueryPath _query;
 };
 
 
 class LogicQuery
 {
 public:
-	LogicQuery(const std::string& query): _queryString(query)
+	LogicQuery(const std::string& query): _query(query)
 	{
 	}
 
@@ -153,7 +155,7 @@ public:
 		bool logic = false;
 
 		Query query(data);
-		Var value = query.find(_queryString);
+		Var value = query.find(_query);
 
 		if (!value.isEmpty()) // When empty, logic will be false
 		{
@@ -177,7 +179,7 @@ public:
 	}
 
 protected:
-	std::string _queryString;
+	QueryPath _query;
 };
 
 
@@ -195,7 +197,7 @@ public:
 	virtual bool apply(const Var& data) const
 	{
 		Query query(data);
-		Var value = query.find(_queryString);
+		Var value = query.find(_query);
 
 		return !value.isEmpty();
 	}
@@ -243,7 +245,7 @@ public:
 		_queries.push_back(new LogicElseQuery());
 	}
 
-	void render(const Var& data, std::ostream& out) const
+	void render(const Var& data, std::string& out) const
 	{
 		int count = 0;
 		for (auto it = _queries.begin(); it != _queries.end(); ++it, ++count)
@@ -272,7 +274,7 @@ public:
 	{
 	}
 
-	void render(const Var& data, std::ostream& out) const
+	void render(const Var& data, std::string& out) const
 	{
 		Query query(data);
 
@@ -295,7 +297,7 @@ public:
 
 private:
 	std::string _name;
-	std::string _query;
+	QueryPath _query;
 };
 
 
@@ -326,7 +328,7 @@ public:
 	{
 	}
 
-	void render(const Var& data, std::ostream& out) const
+	void render(const Var& data, std::string& out) const
 	{
 		TemplateCache* cache = TemplateCache::instance();
 		if (cache == 0)
@@ -693,6 +695,14 @@ std::string Template::readString(std::istream& in)
 
 
 void Template::render(const Var& data, std::ostream& out) const
+{
+	std::string buffer;
+	render(data, buffer);
+	out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+
+void Template::render(const Var& data, std::string& out) const
 {
 	_parts->render(data, out);
 }
@@ -14,6 +14,7 @@
 
 #include "lucid/File.h"
 #include "lucid/JSON/TemplateCache.h"
+#include "lucid/Delegate.h"
 
 
 namespace Lucid {
@@ -31,6 +32,21 @@ TemplateCache::TemplateCache(): _pLogger(0)
 
 TemplateCache::~TemplateCache()
 {
+#ifndef POCO_NO_INOTIFY
+	std::map<std::string, SharedPtr<DirectoryWatcher>> watchers;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		_watchers.swap(watchers);
+	}
+	for (auto& w: watchers)
+	{
+		w.second->itemsChanged -= Lucid::delegate(this, &TemplateCache::onDirectoryChanged);
+	}
+	// The mutex must not be held here, as destroying a DirectoryWatcher
+	// waits for a notification that may be waiting for the mutex.
+	watchers.clear();
+#endif
 	_pInstance = 0;
 }
 
@@ -42,8 +58,19 @@ void TemplateCache::setup()
 }
 
 
+void TemplateCache::addPath(const Path& path)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	_includePaths.push_back(path);
+	_resolvedPaths.clear();
+}
+
+
 Template::Ptr TemplateCache::getTemplate(const Path& path)
 {
+	FastMutex::ScopedLock lock(_mutex);
+
 	if (_pLogger)
 	{
 		poco_trace_f1(*_pLogger, "Trying to load %s", path.toString());
@@ -56,14 +83,13 @@ Template::Ptr TemplateCache::getTemplate(const Path& path)
 	{
 		poco_trace_f1(*_pLogger, "Path resolved to %s", templatePathname);
 	}
-	
-	File templateFile(templatePathname);
 
 	Template::Ptr tpl;
 
-	std::map<std::string, Template::Ptr>::iterator it = _cache.find(templatePathname);
+	std::map<std::string, Entry>::iterator it = _cache.find(templatePathname);
 	if (it == _cache.end())
 	{
+		File templateFile(templatePathname);
 		if (templateFile.exists())
 		{
 			if (_pLogger)
@@ -71,20 +97,7 @@ Template::Ptr TemplateCache::getTemplate(const Path& path)
 				poco_information_f1(*_pLogger, "Loading template %s", templatePath.toString());
 			}
 
-			tpl = new Template(templatePath);
-
-			try
-			{
-				tpl->parse();
-				_cache[templatePathname] = tpl;
-			}
-			catch (JSONTemplateException& jte)
-			{
-				if (_pLogger)
-				{
-					poco_error_f2(*_pLogger, "Template %s contains an error: %s", templatePath.toString(), jte.message());
-				}
-			}
+			tpl = loadTemplate(templatePath);
 		}
 		else
 		{
@@ -97,28 +110,51 @@ Template::Ptr TemplateCache::getTemplate(const Path& path)
 	}
 	else
 	{
-		tpl = it->second;
-		if (tpl->parseTime() < templateFile.getLastModified())
+		tpl = it->second.tpl;
+
+		// Changes to templates in watched directories remove them
+		// from the cache, so only unwatched templates must be checked.
+		if (it->second.directory.empty() && tpl->parseTime() < File(templatePathname).getLastModified())
 		{
 			if (_pLogger)
 			{
 				poco_information_f1(*_pLogger, "Reloading template %s", templatePath.toString());
 			}
 
-			tpl = new Template(templatePath);
+			tpl = loadTemplate(templatePath);
+		}
+	}
 
-			try
-			{
-				tpl->parse();
-				_cache[templatePathname] = tpl;
-			}
-			catch (JSONTemplateException& jte)
-			{
-				if (_pLogger)
-				{
-					poco_error_f2(*_pLogger, "Template %s contains an error: %s", templatePath.toString(), jte.message());
-				}
-			}
+	return tpl;
+}
+
+
+Template::Ptr TemplateCache::loadTemplate(const Path& templatePath)
+{
+	Template::Ptr tpl = new Template(templatePath);
+
+	// Start watching before parsing, so that changes
+	// made while the template is parsed are not missed.
+	Path filePath(templatePath);
+	filePath.makeAbsolute();
+	Path directoryPath(filePath);
+	directoryPath.makeParent();
+	std::string directory = directoryPath.toString();
+	bool watched = watchDirectory(directory);
+
+	try
+	{
+		tpl->parse();
+		Entry& entry = _cache[templatePath.toString()];
+		entry.tpl = tpl;
+		entry.file = filePath.toString();
+		entry.directory = watched ? directory : std::string();
+	}
+	catch (JSONTemplateException& jte)
+	{
+		if (_pLogger)
+		{
+			poco_error_f2(*_pLogger, "Template %s contains an error: %s", templatePath.toString(), jte.message());
 		}
 	}
 
@@ -126,15 +162,29 @@ Template::Ptr TemplateCache::getTemplate(const Path& path)
 }
 
 
-Path TemplateCache::resolvePath(const Path& path) const
+Path TemplateCache::resolvePath(const Path& path)
 {
 	if (path.isAbsolute())
 		return path;
 
+	std::string pathname = path.toString();
+	std::map<std::string, Path>::const_iterator it = _resolvedPaths.find(pathname);
+	if (it != _resolvedPaths.end())
+		return it->second;
+
+	// The resolved path can be kept as long as no file is added to
+	// or removed from the directories searched, which is only known
+	// if all of them are watched.
+	bool watched = true;
 	for (const auto& p: _includePaths)
 	{
 		Path templatePath(p, path);
 
+		Path directoryPath(templatePath);
+		directoryPath.makeAbsolute();
+		directoryPath.makeParent();
+		watched = watchDirectory(directoryPath.toString()) && watched;
+
 		File templateFile(templatePath);
 		if (templateFile.exists())
 		{
@@ -142,6 +192,10 @@ Path TemplateCache::resolvePath(const Path& path) const
 			{
 				poco_trace_f2(*_pLogger, "%s template file resolved to %s", path.toString(), templatePath.toString());
 			}
+			if (watched)
+			{
+				_resolvedPaths[pathname] = templatePath;
+			}
 			return templatePath;
 		}
 		if (_pLogger)
@@ -154,4 +208,85 @@ Path TemplateCache::resolvePath(const Path& path) const
 }
 
 
+bool TemplateCache::watchDirectory(const std::string& directory)
+{
+#ifndef POCO_NO_INOTIFY
+	if (_watchers.find(directory) != _watchers.end())
+		return true;
+
+	try
+	{
+		SharedPtr<DirectoryWatcher> pWatcher = new DirectoryWatcher(directory);
+		pWatcher->itemsChanged += Lucid::delegate(this, &TemplateCache::onDirectoryChanged);
+		_watchers[directory] = pWatcher;
+		return true;
+	}
+	catch (Exception& exc)
+	{
+		if (_pLogger)
+		{
+			poco_debug_f2(*_pLogger, "Cannot watch directory %s: %s", directory, exc.displayText());
+		}
+	}
+#endif
+	return false;
+}
+
+
+#ifndef POCO_NO_INOTIFY
+
+
+void TemplateCache::onDirectoryChanged(const void* /*pSender*/, const DirectoryWatcher::DirectoryChangeList& changes)
+{
+	std::set<std::string> changed;
+	bool added = false;
+	for (const auto& change: changes)
+	{
+		Path path(change.item.path());
+		path.makeAbsolute();
+		changed.insert(path.toString());
+		if (change.event != DirectoryWatcher::DW_ITEM_MODIFIED) added = true;
+	}
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	std::map<std::string, Entry>::iterator it = _cache.begin();
+	while (it != _cache.end())
+	{
+		if (!it->second.directory.empty() && changed.count(it->second.file))
+			_cache.erase(it++);
+		else
+			++it;
+	}
+
+	// A relative path may resolve to a different file if a file
+	// has been added to or removed from one of the include paths.
+	if (added)
+	{
+		std::map<std::string, Path>::iterator itr = _resolvedPaths.begin();
+		while (itr != _resolvedPaths.end())
+		{
+			bool affected = false;
+			for (const auto& p: _includePaths)
+			{
+				Path candidate(p, itr->first);
+				candidate.makeAbsolute();
+				if (changed.count(candidate.toString()))
+				{
+					affected = true;
+					break;
+				}
+			}
+			if (affected)
+				_resolvedPaths.erase(itr++);
+			else
+				++itr;
+		}
+	}
+}
+
+
+#endif // POCO_NO_INOTIFY
+
+
 } } // Lucid::JSON
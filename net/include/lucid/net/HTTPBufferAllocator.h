@@ -29,6 +29,9 @@ namespace Net {
 
 class Net_API HTTPBufferAllocator
 	/// A BufferAllocator for HTTP streams.
+	///
+	/// Buffers of BUFFER_SIZE bytes are taken from a memory pool,
+	/// buffers of other sizes are allocated with new.
 {
 public:
 	static char* allocate(std::streamsize size);
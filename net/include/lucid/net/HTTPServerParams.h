@@ -43,6 +43,8 @@ public:
 		///   - keepAlive:            true
 		///   - maxKeepAliveRequests: 0
 		///   - keepAliveTimeout:     10 seconds
+		///   - coarseClock:          false
+		///   - bufferSize:           4096 bytes
 
 	void setServerName(const std::string& serverName);
 		/// Sets the name and port (name:port) that the server uses to identify itself.
@@ -95,6 +97,26 @@ public:
 		/// during a persistent connection, or 0 if
 		/// unlimited connections are allowed.
 
+	void setCoarseClock(bool coarseClock);
+		/// Enables (coarseClock == true) or disables (coarseClock == false)
+		/// the use of CoarseClock for the Date header of responses.
+		///
+		/// If enabled, the Date header is taken from a per-thread
+		/// string that is only reformatted once per second, instead
+		/// of formatting the current time for every request.
+
+	bool getCoarseClock() const;
+		/// Returns true iff the Date header of responses is taken
+		/// from CoarseClock.
+
+	void setBufferSize(std::streamsize bufferSize);
+		/// Sets the size of the receive buffer and of the stream
+		/// buffers of HTTP connections. See HTTPSession::setBufferSize().
+
+	std::streamsize getBufferSize() const;
+		/// Returns the size of the receive buffer and of the stream
+		/// buffers of HTTP connections.
+
 protected:
 	virtual ~HTTPServerParams();
 		/// Destroys the HTTPServerParams.
@@ -106,6 +128,8 @@ private:
 	bool           _keepAlive;
 	int            _maxKeepAliveRequests;
 	Lucid::Timespan _keepAliveTimeout;
+	bool           _coarseClock;
+	std::streamsize _bufferSize;
 };
 
 
@@ -148,6 +172,18 @@ inline const Lucid::Timespan& HTTPServerParams::getKeepAliveTimeout() const
 }
 
 
+inline bool HTTPServerParams::getCoarseClock() const
+{
+	return _coarseClock;
+}
+
+
+inline std::streamsize HTTPServerParams::getBufferSize() const
+{
+	return _bufferSize;
+}
+
+
 } } // namespace Lucid::Net
 
 
@@ -83,9 +83,10 @@ public:
 		/// The Content-Length header of the response is set
 		/// to length and chunked transfer encoding is disabled.
 		///
-		/// If both the HTTP message header and body (from the
-		/// given buffer) fit into one single network packet, the 
-		/// complete response can be sent in one network packet.
+		/// The HTTP message header and body (from the given buffer)
+		/// are sent with a single scatter/gather write, so that
+		/// the complete response can be sent in one network packet
+		/// if it fits.
 		///
 		/// Must not be called after send(), sendFile()  
 		/// or redirect() has been called.
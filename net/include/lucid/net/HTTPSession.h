@@ -54,6 +54,19 @@ public:
 
 	void setTimeout(const Lucid::Timespan& timeout);
 		/// Sets the timeout for the HTTP session.
+
+	void setBufferSize(std::streamsize size);
+		/// Sets the size of the session's receive buffer, and of
+		/// the buffers of HTTP streams subsequently created for
+		/// the session. The default is HTTPBufferAllocator::BUFFER_SIZE
+		/// (4096 bytes).
+		///
+		/// Larger buffers reduce the number of system calls for
+		/// transferring large request or response bodies. A new receive
+		/// buffer is allocated when the current one has been consumed.
+
+	std::streamsize getBufferSize() const;
+		/// Returns the buffer size for the HTTP session.
 		
 	void setTimeout(const Lucid::Timespan& connectionTimeout, const Lucid::Timespan& sendTimeout, const Lucid::Timespan& receiveTimeout);
 		/// Sets different timeouts for the HTTP session.
@@ -152,6 +165,10 @@ protected:
 	virtual int write(const char* buffer, std::streamsize length);
 		/// Writes data to the socket.
 
+	int writeBuffers(const SocketBufVec& buffers);
+		/// Writes the data in all buffers to the socket,
+		/// using a single scatter/gather write if possible.
+
 	int receive(char* buffer, int length);
 		/// Reads up to length bytes.
 		
@@ -192,6 +209,8 @@ private:
 	char*            _pBuffer;
 	char*            _pCurrent;
 	char*            _pEnd;
+	std::streamsize  _bufferSize;
+	std::streamsize  _allocatedSize;
 	bool             _keepAlive;
 	Lucid::Timespan   _connectionTimeout;
 	Lucid::Timespan   _receiveTimeout;
@@ -203,6 +222,7 @@ private:
 	friend class HTTPHeaderStreamBuf;
 	friend class HTTPFixedLengthStreamBuf;
 	friend class HTTPChunkedStreamBuf;
+	friend class HTTPServerResponseImpl;
 };
 
 
@@ -221,6 +241,12 @@ inline Lucid::Timespan HTTPSession::getTimeout() const
 }
 
 
+inline std::streamsize HTTPSession::getBufferSize() const
+{
+	return _bufferSize;
+}
+
+
 inline StreamSocket& HTTPSession::socket()
 {
 	return _socket;
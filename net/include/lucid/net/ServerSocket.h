@@ -21,6 +21,7 @@
 #include "lucid/Net/Net.h"
 #include "lucid/Net/Socket.h"
 #include "lucid/Net/StreamSocket.h"
+#include <vector>
 
 
 namespace Lucid {
@@ -217,6 +218,22 @@ public:
 		/// Returns a new TCP socket for the connection
 		/// with the client.
 
+	int acceptConnections(std::vector<StreamSocket>& sockets, int maxConnections);
+		/// Gets up to maxConnections completed connections from
+		/// the socket's completed connection queue, appends them
+		/// to sockets, and returns the number of accepted connections.
+		///
+		/// This is meant to drain the completed connection queue
+		/// of a non-blocking socket after it has become readable.
+		/// Returns as soon as the queue is empty. If the socket is
+		/// blocking, waits for and accepts only one connection.
+		///
+		/// If an error occurs after at least one connection has
+		/// been accepted, the accepted connections are returned,
+		/// and the error is reported by the next call.
+		///
+		/// The accepted sockets are always in blocking mode.
+
 protected:
 	ServerSocket(SocketImpl* pImpl, bool);
 		/// The bool argument is to resolve an ambiguity with
@@ -58,6 +58,18 @@ public:
 		///
 		/// The client socket's address is returned in clientAddr.
 
+	SocketImpl* tryAcceptConnection(SocketAddress& clientAddr);
+		/// Gets the next completed connection from the
+		/// socket's completed connection queue, like
+		/// acceptConnection().
+		///
+		/// If the socket is non-blocking and the queue is
+		/// empty, returns null instead of throwing an exception.
+		///
+		/// The returned socket is always in blocking mode,
+		/// even on platforms where accepted sockets inherit
+		/// the non-blocking mode of the listening socket.
+
 	virtual void connect(const SocketAddress& address);
 		/// Initializes the socket and establishes a connection to
 		/// the TCP server at the given address.
@@ -511,6 +523,8 @@ private:
 	SocketImpl(const SocketImpl&);
 	SocketImpl& operator = (const SocketImpl&);
 
+	poco_socket_t acceptSocket(SocketAddress& clientAddr);
+
 	poco_socket_t  _sockfd;
 	Lucid::Timespan _recvTimeout;
 	Lucid::Timespan _sndTimeout;
@@ -34,10 +34,22 @@ class StreamSocketImpl;
 
 class Net_API SocketStreamBuf: public Lucid::BufferedBidirectionalStreamBuf
 	/// This is the streambuf class used for reading from and writing to a socket.
+	///
+	/// Reads and writes of at least the buffer size bypass the buffer.
+	/// Such reads receive data from the socket directly into the caller's
+	/// memory. Such writes are sent together with any data still in the
+	/// buffer, using a single scatter/gather write.
 {
 public:
-	SocketStreamBuf(const Socket& socket);
-		/// Creates a SocketStreamBuf with the given socket.
+	enum
+	{
+		STREAM_BUFFER_SIZE = 8192
+			/// The default size of the read and write buffers.
+	};
+
+	SocketStreamBuf(const Socket& socket, std::streamsize bufferSize = STREAM_BUFFER_SIZE);
+		/// Creates a SocketStreamBuf with the given socket, using
+		/// read and write buffers of the given size.
 		///
 		/// The socket's SocketImpl must be a StreamSocketImpl,
 		/// otherwise an InvalidArgumentException is thrown.
@@ -47,18 +59,19 @@ public:
 		
 	StreamSocketImpl* socketImpl() const;
 		/// Returns the internal SocketImpl.
+
+	std::streamsize bufferSize() const;
+		/// Returns the size of the read and write buffers.
 	
 protected:
 	int readFromDevice(char* buffer, std::streamsize length);
 	int writeToDevice(const char* buffer, std::streamsize length);
+	std::streamsize xsgetn(char* buffer, std::streamsize length);
+	std::streamsize xsputn(const char* buffer, std::streamsize length);
 
 private:
-	enum 
-	{
-		STREAM_BUFFER_SIZE = 1024
-	};
-
 	StreamSocketImpl* _pImpl;
+	std::streamsize   _bufferSize;
 };
 
 
@@ -70,8 +83,8 @@ class Net_API SocketIOS: public virtual std::ios
 	/// order of the stream buffer and base classes.
 {
 public:
-	SocketIOS(const Socket& socket);
-		/// Creates the SocketIOS with the given socket.
+	SocketIOS(const Socket& socket, std::streamsize bufferSize = SocketStreamBuf::STREAM_BUFFER_SIZE);
+		/// Creates the SocketIOS with the given socket and buffer size.
 		///
 		/// The socket's SocketImpl must be a StreamSocketImpl,
 		/// otherwise an InvalidArgumentException is thrown.
@@ -105,6 +118,13 @@ public:
 		/// The socket's SocketImpl must be a StreamSocketImpl,
 		/// otherwise an InvalidArgumentException is thrown.
 
+	SocketOutputStream(const Socket& socket, std::streamsize bufferSize);
+		/// Creates the SocketOutputStream with the given socket,
+		/// using a buffer of the given size.
+		///
+		/// The socket's SocketImpl must be a StreamSocketImpl,
+		/// otherwise an InvalidArgumentException is thrown.
+
 	~SocketOutputStream();
 		/// Destroys the SocketOutputStream.
 		///
@@ -131,6 +151,13 @@ public:
 		/// The socket's SocketImpl must be a StreamSocketImpl,
 		/// otherwise an InvalidArgumentException is thrown.
 
+	SocketInputStream(const Socket& socket, std::streamsize bufferSize);
+		/// Creates the SocketInputStream with the given socket,
+		/// using a buffer of the given size.
+		///
+		/// The socket's SocketImpl must be a StreamSocketImpl,
+		/// otherwise an InvalidArgumentException is thrown.
+
 	~SocketInputStream();
 		/// Destroys the SocketInputStream.
 };
@@ -155,6 +182,13 @@ public:
 		/// The socket's SocketImpl must be a StreamSocketImpl,
 		/// otherwise an InvalidArgumentException is thrown.
 
+	SocketStream(const Socket& socket, std::streamsize bufferSize);
+		/// Creates the SocketStream with the given socket,
+		/// using read and write buffers of the given size.
+		///
+		/// The socket's SocketImpl must be a StreamSocketImpl,
+		/// otherwise an InvalidArgumentException is thrown.
+
 	~SocketStream();
 		/// Destroys the SocketStream.
 		///
@@ -171,6 +205,12 @@ inline StreamSocketImpl* SocketStreamBuf::socketImpl() const
 }
 
 
+inline std::streamsize SocketStreamBuf::bufferSize() const
+{
+	return _bufferSize;
+}
+
+
 } } // namespace Lucid::Net
 
 
@@ -48,6 +48,17 @@ public:
 		/// Returns the number of bytes sent. The return value may also be
 		/// negative to denote some special condition.
 
+	virtual int sendBytes(const SocketBufVec& buffers, int flags = 0);
+		/// Sends the contents of all buffers with a single
+		/// scatter/gather write, if possible. Ensures that all data
+		/// is sent if the socket is blocking. In case of a non-blocking
+		/// socket, sends as many bytes as possible.
+		///
+		/// Returns the number of bytes sent. The return value may also be
+		/// negative to denote some special condition.
+
+	using SocketImpl::sendBytes;
+
 protected:
 	virtual ~StreamSocketImpl();
 };
@@ -27,6 +27,8 @@
 #include "lucid/Runnable.h"
 #include "lucid/Thread.h"
 #include "lucid/ThreadPool.h"
+#include <memory>
+#include <vector>
 
 
 namespace Lucid {
@@ -60,6 +62,15 @@ public:
 		/// This can be used to handle certain socket connections in
 		/// a special way, outside the TCPServer framework.
 
+	virtual int priority(const StreamSocket& socket);
+		/// Returns the priority class of the given StreamSocket
+		/// connection, which has been accepted by accept().
+		///
+		/// Queued connections with a lower priority value are
+		/// handled before connections with a higher value.
+		///
+		/// The default implementation returns 0.
+
 protected:
 	virtual ~TCPServerConnectionFilter();
 };
@@ -98,7 +109,17 @@ class Net_API TCPServer: public Lucid::Runnable
 	///
 	/// TCPServer uses a separate thread to accept incoming connections.
 	/// Thus, the call to start() returns immediately, and the server
-	/// continues to run in the background.
+	/// continues to run in the background. Whenever the server socket
+	/// becomes readable, all pending connections (up to a limit) are
+	/// accepted and passed to the TCPServerDispatcher at once. For this,
+	/// the server socket is put into non-blocking mode while the server
+	/// is running.
+	///
+	/// Under high connection rates, more than one acceptor thread can
+	/// be used (see TCPServerParams::setAcceptorThreads()). Each additional
+	/// acceptor thread accepts connections on its own server socket,
+	/// bound to the same address with SO_REUSEPORT, so that the kernel
+	/// distributes incoming connections across the acceptor threads.
 	///
 	/// To stop the server from accepting new connections, call stop().
 	///
@@ -189,6 +210,19 @@ public:
 	int refusedConnections() const;
 		/// Returns the number of refused connections.
 
+	int shedConnections() const;
+		/// Returns the number of connections that have been shed
+		/// because they spent too much time in the queue.
+		///
+		/// See TCPServerParams::setQueueTarget().
+
+	void getQueueWaitHistogram(std::vector<int>& histogram) const;
+		/// Stores the histogram of the times connections have
+		/// spent in the queue in histogram.
+		///
+		/// See TCPServerDispatcher::getQueueWaitHistogram()
+		/// for a description of the histogram.
+
 	const ServerSocket& socket() const;
 		/// Returns the underlying server socket.
 
@@ -218,15 +252,23 @@ protected:
 	static std::string threadName(const ServerSocket& socket);
 		/// Returns a thread name for the server thread.
 
+	void acceptConnections(ServerSocket& socket);
+		/// Accepts connections on the given server socket
+		/// and passes them to the TCPServerDispatcher, until
+		/// the stop() method is called.
+
 private:
 	TCPServer();
 	TCPServer(const TCPServer&);
 	TCPServer& operator = (const TCPServer&);
+
+	class Acceptor;
 	
 	ServerSocket _socket;
 	TCPServerDispatcher* _pDispatcher;
 	TCPServerConnectionFilter::Ptr _pConnectionFilter;
 	Lucid::Thread _thread;
+	std::vector<std::unique_ptr<Acceptor>> _acceptors;
 	bool _stopped;
 };
 
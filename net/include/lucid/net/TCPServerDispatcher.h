@@ -23,9 +23,11 @@
 #include "lucid/Net/TCPServerConnectionFactory.h"
 #include "lucid/Net/TCPServerParams.h"
 #include "lucid/Runnable.h"
-#include "lucid/NotificationQueue.h"
+#include "lucid/PriorityNotificationQueue.h"
+#include "lucid/Clock.h"
 #include "lucid/ThreadPool.h"
 #include "lucid/Mutex.h"
+#include <vector>
 
 
 namespace Lucid {
@@ -35,8 +37,21 @@ namespace Net {
 class Net_API TCPServerDispatcher: public Lucid::Runnable
 	/// A helper class for TCPServer that dispatches
 	/// connections to server connection threads.
+	///
+	/// Connections are queued by priority, and connections
+	/// with the same priority are handled in the order they
+	/// have been queued. For every handled connection, the time
+	/// it has spent in the queue is recorded in a histogram.
+	/// Optionally, connections are shed when the time spent in
+	/// the queue exceeds a target (see TCPServerParams::setQueueTarget()).
 {
 public:
+	enum
+	{
+		QUEUE_WAIT_BUCKETS = 32
+			/// The number of buckets in the queue wait histogram.
+	};
+
 	TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactory, Lucid::ThreadPool& threadPool, TCPServerParams::Ptr pParams);
 		/// Creates the TCPServerDispatcher.
 		///
@@ -55,8 +70,14 @@ public:
 	void run();
 		/// Runs the dispatcher.
 		
-	void enqueue(const StreamSocket& socket);
-		/// Queues the given socket connection.
+	void enqueue(const StreamSocket& socket, int priority = 0);
+		/// Queues the given socket connection with the given priority.
+		/// Connections with a lower priority value are handled first.
+
+	void enqueue(const std::vector<StreamSocket>& sockets, const std::vector<int>& priorities);
+		/// Queues the given socket connections with the given
+		/// priorities, taking the dispatcher's lock only once.
+		/// Both vectors must have the same size.
 
 	void stop();
 		/// Stops the dispatcher.
@@ -82,6 +103,22 @@ public:
 	int refusedConnections() const;
 		/// Returns the number of refused connections.
 
+	int shedConnections() const;
+		/// Returns the number of connections that have been
+		/// shed because they spent too much time in the queue.
+
+	void getQueueWaitHistogram(std::vector<int>& histogram) const;
+		/// Stores the histogram of the times connections taken
+		/// from the queue (including shed ones) have spent in the
+		/// queue in histogram, which is resized to QUEUE_WAIT_BUCKETS
+		/// elements.
+		///
+		/// The first element counts connections that have been
+		/// waiting for less than one microsecond. Element i counts
+		/// connections that have been waiting for at least 2^(i - 1)
+		/// and less than 2^i microseconds. The last element also
+		/// counts all longer waits.
+
 	const TCPServerParams& params() const;
 		/// Returns a const reference to the TCPServerParam object.
 
@@ -95,11 +132,18 @@ protected:
 	void endConnection();
 		/// Updates the performance counters.
 
+	bool admitConnection(const Lucid::Clock& queued);
+		/// Records the time a connection, which has been queued
+		/// at the given time, has spent in the queue, and returns
+		/// false if the connection must be shed.
+
 private:
 	TCPServerDispatcher();
 	TCPServerDispatcher(const TCPServerDispatcher&);
 	TCPServerDispatcher& operator = (const TCPServerDispatcher&);
 
+	void enqueueImpl(const StreamSocket& socket, int priority, const Lucid::Clock& now);
+
 	int _rc;
 	TCPServerParams::Ptr _pParams;
 	int  _currentThreads;
@@ -107,8 +151,15 @@ private:
 	int  _currentConnections;
 	int  _maxConcurrentConnections;
 	int  _refusedConnections;
+	int  _shedConnections;
+	int  _queueWaitHistogram[QUEUE_WAIT_BUCKETS];
 	bool _stopped;
-	Lucid::NotificationQueue         _queue;
+	bool _aboveTarget;
+	bool _shedding;
+	int  _shedCount;
+	Lucid::Clock _firstAboveTime;
+	Lucid::Clock _shedNext;
+	Lucid::PriorityNotificationQueue _queue;
 	TCPServerConnectionFactory::Ptr _pConnectionFactory;
 	Lucid::ThreadPool&               _threadPool;
 	mutable Lucid::FastMutex         _mutex;
@@ -45,6 +45,9 @@ public:
 		///   - threadIdleTime:       10 seconds
 		///   - maxThreads:           0
 		///   - maxQueued:            64
+		///   - acceptorThreads:      1
+		///   - queueTarget:          0 (no load shedding)
+		///   - queueInterval:        100 milliseconds
 
 	void setThreadIdleTime(const Lucid::Timespan& idleTime);
 		/// Sets the maximum idle time for a thread before
@@ -92,6 +95,49 @@ public:
 		/// Returns the priority of TCP server threads
 		/// created by TCPServer. 
 
+	void setAcceptorThreads(int count);
+		/// Sets the number of threads accepting connections.
+		/// Must be greater than 0.
+		///
+		/// If more than one acceptor thread is specified, the
+		/// TCPServer binds additional server sockets to the
+		/// address of its server socket, using SO_REUSEPORT,
+		/// and each acceptor thread accepts connections on its
+		/// own socket. This requires that the server socket has
+		/// been bound with reusePort set to true.
+		///
+		/// The default number is 1.
+
+	int getAcceptorThreads() const;
+		/// Returns the number of threads accepting connections.
+
+	void setQueueTarget(const Lucid::Timespan& target);
+		/// Sets the target queueing delay for adaptive load shedding,
+		/// or 0 to disable load shedding.
+		///
+		/// If enabled, the TCPServerDispatcher sheds (closes without
+		/// handling) connections taken from its queue, once the time
+		/// the connections have spent in the queue has stayed above
+		/// the target for at least the queue interval. As long as this
+		/// is the case, the interval between shed connections gets
+		/// shorter, following the CoDel (controlled delay) algorithm.
+		///
+		/// A typical target is 5 to 10 percent of the queue interval.
+		/// The default is 0.
+
+	const Lucid::Timespan& getQueueTarget() const;
+		/// Returns the target queueing delay for load shedding.
+
+	void setQueueInterval(const Lucid::Timespan& interval);
+		/// Sets the interval for adaptive load shedding. This should
+		/// be about the time a connection needs to be handled.
+		/// Must be greater than 0.
+		///
+		/// The default is 100 milliseconds.
+
+	const Lucid::Timespan& getQueueInterval() const;
+		/// Returns the interval for load shedding.
+
 protected:
 	virtual ~TCPServerParams();
 		/// Destroys the TCPServerParams.
@@ -101,6 +147,9 @@ private:
 	int _maxThreads;
 	int _maxQueued;
 	Lucid::Thread::Priority _threadPriority;
+	int _acceptorThreads;
+	Lucid::Timespan _queueTarget;
+	Lucid::Timespan _queueInterval;
 };
 
 
@@ -131,6 +180,24 @@ inline Lucid::Thread::Priority TCPServerParams::getThreadPriority() const
 }
 
 
+inline int TCPServerParams::getAcceptorThreads() const
+{
+	return _acceptorThreads;
+}
+
+
+inline const Lucid::Timespan& TCPServerParams::getQueueTarget() const
+{
+	return _queueTarget;
+}
+
+
+inline const Lucid::Timespan& TCPServerParams::getQueueInterval() const
+{
+	return _queueInterval;
+}
+
+
 } } // namespace Lucid::Net
 
 
@@ -27,17 +27,21 @@ MemoryPool HTTPBufferAllocator::_pool(HTTPBufferAllocator::BUFFER_SIZE, 16);
 
 char* HTTPBufferAllocator::allocate(std::streamsize size)
 {
-	poco_assert_dbg (size == BUFFER_SIZE);
+	poco_assert_dbg (size > 0);
 
-	return reinterpret_cast<char*>(_pool.get());
+	if (size == BUFFER_SIZE)
+		return reinterpret_cast<char*>(_pool.get());
+	else
+		return new char[static_cast<std::size_t>(size)];
 }
 
 
 void HTTPBufferAllocator::deallocate(char* ptr, std::streamsize size)
 {
-	poco_assert_dbg (size == BUFFER_SIZE);
-
-	_pool.release(ptr);
+	if (size == BUFFER_SIZE)
+		_pool.release(ptr);
+	else
+		delete [] ptr;
 }
 
 
@@ -33,7 +33,7 @@ namespace Net {
 
 
 HTTPChunkedStreamBuf::HTTPChunkedStreamBuf(HTTPSession& session, openmode mode):
-	HTTPBasicStreamBuf(HTTPBufferAllocator::BUFFER_SIZE, mode),
+	HTTPBasicStreamBuf(session.getBufferSize(), mode),
 	_session(session),
 	_mode(mode),
 	_chunk(0)
@@ -95,9 +95,12 @@ int HTTPChunkedStreamBuf::writeToDevice(const char* buffer, std::streamsize leng
 	_chunkBuffer.clear();
 	NumberFormatter::appendHex(_chunkBuffer, length);
 	_chunkBuffer.append("\r\n", 2);
-	_chunkBuffer.append(buffer, static_cast<std::string::size_type>(length));
-	_chunkBuffer.append("\r\n", 2);
-	_session.write(_chunkBuffer.data(), static_cast<std::streamsize>(_chunkBuffer.size()));
+	SocketBufVec buffers;
+	buffers.reserve(3);
+	buffers.push_back(Socket::makeBuffer(&_chunkBuffer[0], _chunkBuffer.size()));
+	buffers.push_back(Socket::makeBuffer(const_cast<char*>(buffer), static_cast<std::size_t>(length)));
+	buffers.push_back(Socket::makeBuffer(const_cast<char*>("\r\n"), 2));
+	_session.writeBuffers(buffers);
 	return static_cast<int>(length);
 }
 
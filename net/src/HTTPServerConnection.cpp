@@ -21,6 +21,7 @@
 #include "lucid/Net/NetException.h"
 #include "lucid/NumberFormatter.h"
 #include "lucid/Timestamp.h"
+#include "lucid/CoarseClock.h"
 #include "lucid/Delegate.h"
 #include <memory>
 
@@ -68,8 +69,15 @@ void HTTPServerConnection::run()
 				HTTPServerResponseImpl response(session);
 				HTTPServerRequestImpl request(response, session, _pParams);
 
-				Lucid::Timestamp now;
-				response.setDate(now);
+				if (_pParams->getCoarseClock())
+				{
+					response.set(HTTPResponse::DATE, Lucid::CoarseClock::httpDate());
+				}
+				else
+				{
+					Lucid::Timestamp now;
+					response.setDate(now);
+				}
 				response.setVersion(request.getVersion());
 				response.setKeepAlive(_pParams->getKeepAlive() && request.getKeepAlive() && session.canKeepAlive());
 				if (!server.empty())
@@ -13,6 +13,7 @@
 
 
 #include "lucid/Net/HTTPServerParams.h"
+#include "lucid/Net/HTTPBufferAllocator.h"
 
 
 namespace Lucid {
@@ -23,7 +24,9 @@ HTTPServerParams::HTTPServerParams():
 	_timeout(60000000),
 	_keepAlive(true),
 	_maxKeepAliveRequests(0),
-	_keepAliveTimeout(15000000)
+	_keepAliveTimeout(15000000),
+	_coarseClock(false),
+	_bufferSize(HTTPBufferAllocator::BUFFER_SIZE)
 {
 }
 
@@ -68,6 +71,20 @@ void HTTPServerParams::setMaxKeepAliveRequests(int maxKeepAliveRequests)
 	poco_assert (maxKeepAliveRequests >= 0);
 	_maxKeepAliveRequests = maxKeepAliveRequests;
 }
+
+
+void HTTPServerParams::setCoarseClock(bool coarseClock)
+{
+	_coarseClock = coarseClock;
+}
+
+
+void HTTPServerParams::setBufferSize(std::streamsize bufferSize)
+{
+	poco_assert (bufferSize > 0);
+
+	_bufferSize = bufferSize;
+}
 	
 
 } } // namespace Lucid::Net
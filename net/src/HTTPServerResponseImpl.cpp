@@ -28,6 +28,7 @@
 #include "lucid/FileStream.h"
 #include "lucid/DateTimeFormatter.h"
 #include "lucid/DateTimeFormat.h"
+#include <sstream>
 
 
 using Lucid::File;
@@ -142,12 +143,19 @@ void HTTPServerResponseImpl::sendBuffer(const void* pBuffer, std::size_t length)
 	setContentLength(static_cast<int>(length));
 	setChunkedTransferEncoding(false);
 	
-	_pStream = new HTTPHeaderOutputStream(_session);
-	write(*_pStream);
-	if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD)
+	std::ostringstream header;
+	write(header);
+	std::string headerStr(header.str());
+
+	// send header and body with a single (gathering) write
+	SocketBufVec buffers;
+	buffers.push_back(Socket::makeBuffer(const_cast<char*>(headerStr.data()), headerStr.size()));
+	if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD && length > 0)
 	{
-		_pStream->write(static_cast<const char*>(pBuffer), static_cast<std::streamsize>(length));
+		buffers.push_back(Socket::makeBuffer(const_cast<void*>(pBuffer), length));
 	}
+	_pStream = new HTTPHeaderOutputStream(_session);
+	_session.writeBuffers(buffers);
 }
 
 
@@ -15,7 +15,9 @@
 #include "lucid/Net/HTTPSession.h"
 #include "lucid/Net/HTTPBufferAllocator.h"
 #include "lucid/Net/NetException.h"
+#include "lucid/Net/StreamSocketImpl.h"
 #include <cstring>
+#include <typeinfo>
 
 
 using Lucid::TimeoutException;
@@ -29,6 +31,8 @@ HTTPSession::HTTPSession():
 	_pBuffer(0),
 	_pCurrent(0),
 	_pEnd(0),
+	_bufferSize(HTTPBufferAllocator::BUFFER_SIZE),
+	_allocatedSize(0),
 	_keepAlive(false),
 	_connectionTimeout(HTTP_DEFAULT_CONNECTION_TIMEOUT),
 	_receiveTimeout(HTTP_DEFAULT_TIMEOUT),
@@ -43,6 +47,8 @@ HTTPSession::HTTPSession(const StreamSocket& socket):
 	_pBuffer(0),
 	_pCurrent(0),
 	_pEnd(0),
+	_bufferSize(HTTPBufferAllocator::BUFFER_SIZE),
+	_allocatedSize(0),
 	_keepAlive(false),
 	_connectionTimeout(HTTP_DEFAULT_CONNECTION_TIMEOUT),
 	_receiveTimeout(HTTP_DEFAULT_TIMEOUT),
@@ -57,6 +63,8 @@ HTTPSession::HTTPSession(const StreamSocket& socket, bool keepAlive):
 	_pBuffer(0),
 	_pCurrent(0),
 	_pEnd(0),
+	_bufferSize(HTTPBufferAllocator::BUFFER_SIZE),
+	_allocatedSize(0),
 	_keepAlive(keepAlive),
 	_connectionTimeout(HTTP_DEFAULT_CONNECTION_TIMEOUT),
 	_receiveTimeout(HTTP_DEFAULT_TIMEOUT),
@@ -70,7 +78,7 @@ HTTPSession::~HTTPSession()
 {
 	try
 	{
-		if (_pBuffer) HTTPBufferAllocator::deallocate(_pBuffer, HTTPBufferAllocator::BUFFER_SIZE);
+		if (_pBuffer) HTTPBufferAllocator::deallocate(_pBuffer, _allocatedSize);
 	}
 	catch (...)
 	{
@@ -99,6 +107,14 @@ void HTTPSession::setTimeout(const Lucid::Timespan& timeout)
 }
 
 
+void HTTPSession::setBufferSize(std::streamsize size)
+{
+	poco_assert (size > 0);
+
+	_bufferSize = size;
+}
+
+
 void HTTPSession::setTimeout(const Lucid::Timespan& connectionTimeout, const Lucid::Timespan& sendTimeout, const Lucid::Timespan& receiveTimeout)
 {
 	 _connectionTimeout = connectionTimeout;
@@ -159,6 +175,36 @@ int HTTPSession::write(const char* buffer, std::streamsize length)
 }
 
 
+int HTTPSession::writeBuffers(const SocketBufVec& buffers)
+{
+	try
+	{
+		// Subclasses of StreamSocketImpl may only override the
+		// single-buffer sendBytes(), so the vector overload, which
+		// writes directly to the socket, is only used for a plain
+		// StreamSocketImpl.
+		if (typeid(*_socket.impl()) == typeid(StreamSocketImpl))
+			return _socket.sendBytes(buffers);
+
+		int sent = 0;
+		for (const auto& buf: buffers)
+		{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+			sent += _socket.sendBytes(buf.buf, static_cast<int>(buf.len));
+#else
+			sent += _socket.sendBytes(buf.iov_base, static_cast<int>(buf.iov_len));
+#endif
+		}
+		return sent;
+	}
+	catch (Lucid::Exception& exc)
+	{
+		setException(exc);
+		throw;
+	}
+}
+
+
 int HTTPSession::receive(char* buffer, int length)
 {
 	try
@@ -175,12 +221,18 @@ int HTTPSession::receive(char* buffer, int length)
 
 void HTTPSession::refill()
 {
+	if (_pBuffer && _allocatedSize != _bufferSize)
+	{
+		HTTPBufferAllocator::deallocate(_pBuffer, _allocatedSize);
+		_pBuffer = 0;
+	}
 	if (!_pBuffer)
 	{
-		_pBuffer = HTTPBufferAllocator::allocate(HTTPBufferAllocator::BUFFER_SIZE);
+		_pBuffer = HTTPBufferAllocator::allocate(_bufferSize);
+		_allocatedSize = _bufferSize;
 	}
 	_pCurrent = _pEnd = _pBuffer;
-	int n = receive(_pBuffer, HTTPBufferAllocator::BUFFER_SIZE);
+	int n = receive(_pBuffer, static_cast<int>(_allocatedSize));
 	_pEnd += n;
 }
 
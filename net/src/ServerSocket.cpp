@@ -155,4 +155,29 @@ StreamSocket ServerSocket::acceptConnection()
 }
 
 
+int ServerSocket::acceptConnections(std::vector<StreamSocket>& sockets, int maxConnections)
+{
+	SocketAddress clientAddr;
+	int n = 0;
+	while (n < maxConnections)
+	{
+		SocketImpl* pImpl;
+		try
+		{
+			pImpl = impl()->tryAcceptConnection(clientAddr);
+		}
+		catch (...)
+		{
+			if (n == 0) throw;
+			break;
+		}
+		if (!pImpl) break;
+		sockets.push_back(StreamSocket(pImpl));
+		++n;
+		if (impl()->getBlocking()) break;
+	}
+	return n;
+}
+
+
 } } // namespace Lucid::Net
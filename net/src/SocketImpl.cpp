@@ -24,16 +24,21 @@
 #ifndef POCO_HAVE_FD_POLL
 #define POCO_HAVE_FD_POLL 1
 #endif
-#elif defined(POCO_OS_FAMILY_BSD)
+#elif defined(POCO_OS_FAMILY_UNIX)
 #ifndef POCO_HAVE_FD_POLL
 #define POCO_HAVE_FD_POLL 1
 #endif
 #endif
 
 
-#if defined(POCO_HAVE_FD_EPOLL)
-#include <sys/epoll.h>
-#elif defined(POCO_HAVE_FD_POLL)
+#if defined(__linux__) && defined(SOCK_CLOEXEC)
+#ifndef POCO_HAVE_ACCEPT4
+#define POCO_HAVE_ACCEPT4 1
+#endif
+#endif
+
+
+#if defined(POCO_HAVE_FD_POLL)
 #ifndef _WIN32
 #include <poll.h>
 #endif
@@ -101,6 +106,37 @@ SocketImpl::~SocketImpl()
 
 
 SocketImpl* SocketImpl::acceptConnection(SocketAddress& clientAddr)
+{
+	poco_socket_t sd = acceptSocket(clientAddr);
+	if (sd != POCO_INVALID_SOCKET)
+	{
+		return new StreamSocketImpl(sd);
+	}
+	error(); // will throw
+	return 0;
+}
+
+
+SocketImpl* SocketImpl::tryAcceptConnection(SocketAddress& clientAddr)
+{
+	poco_socket_t sd = acceptSocket(clientAddr);
+	if (sd != POCO_INVALID_SOCKET)
+	{
+		StreamSocketImpl* pImpl = new StreamSocketImpl(sd);
+#if !defined(POCO_HAVE_ACCEPT4)
+		if (!_blocking) pImpl->setBlocking(true);
+#endif
+		return pImpl;
+	}
+	int err = lastError();
+	if (!_blocking && (err == POCO_EAGAIN || err == POCO_EWOULDBLOCK))
+		return 0;
+	error(err); // will throw
+	return 0;
+}
+
+
+poco_socket_t SocketImpl::acceptSocket(SocketAddress& clientAddr)
 {
 	if (_sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
 
@@ -110,16 +146,20 @@ SocketImpl* SocketImpl::acceptConnection(SocketAddress& clientAddr)
 	poco_socket_t sd;
 	do
 	{
+#if defined(POCO_HAVE_ACCEPT4)
+		// accepted sockets are always blocking, and must
+		// not be leaked into child processes
+		sd = ::accept4(_sockfd, pSA, &saLen, SOCK_CLOEXEC);
+#else
 		sd = ::accept(_sockfd, pSA, &saLen);
+#endif
 	}
 	while (sd == POCO_INVALID_SOCKET && lastError() == POCO_EINTR);
 	if (sd != POCO_INVALID_SOCKET)
 	{
 		clientAddr = SocketAddress(pSA, saLen);
-		return new StreamSocketImpl(sd);
 	}
-	error(); // will throw
-	return 0;
+	return sd;
 }
 
 
@@ -624,73 +664,33 @@ bool SocketImpl::poll(const Lucid::Timespan& timeout, int mode)
 	poco_socket_t sockfd = _sockfd;
 	if (sockfd == POCO_INVALID_SOCKET) throw InvalidSocketException();
 
-#if defined(POCO_HAVE_FD_EPOLL)
-
-	int epollfd = epoll_create(1);
-	if (epollfd < 0)
-	{
-		error("Can't create epoll queue");
-	}
-
-	struct epoll_event evin;
-	memset(&evin, 0, sizeof(evin));
-
-	if (mode & SELECT_READ)
-		evin.events |= EPOLLIN;
-	if (mode & SELECT_WRITE)
-		evin.events |= EPOLLOUT;
-	if (mode & SELECT_ERROR)
-		evin.events |= EPOLLERR;
-
-	if (epoll_ctl(epollfd, EPOLL_CTL_ADD, sockfd, &evin) < 0)
-	{
-		::close(epollfd);
-		error("Can't insert socket to epoll queue");
-	}
-
-	Lucid::Timespan remainingTime(timeout);
-	int rc;
-	do
-	{
-		struct epoll_event evout;
-		memset(&evout, 0, sizeof(evout));
-
-		Lucid::Timestamp start;
-		rc = epoll_wait(epollfd, &evout, 1, remainingTime.totalMilliseconds());
-		if (rc < 0 && lastError() == POCO_EINTR)
-		{
-			Lucid::Timestamp end;
-			Lucid::Timespan waited = end - start;
-			if (waited < remainingTime)
-				remainingTime -= waited;
-			else
-				remainingTime = 0;
-		}
-	}
-	while (rc < 0 && lastError() == POCO_EINTR);
-
-	::close(epollfd);
-	if (rc < 0) error();
-	return rc > 0;
-
-#elif defined(POCO_HAVE_FD_POLL)
+#if defined(POCO_HAVE_FD_POLL)
 
+	// A single socket is waited for with poll(), which, unlike
+	// epoll, needs no kernel object and only a single system call,
+	// and, unlike select(), is not limited to FD_SETSIZE.
 	pollfd pollBuf;
 
 	memset(&pollBuf, 0, sizeof(pollfd));
 	pollBuf.fd = _sockfd;
 	if (mode & SELECT_READ) pollBuf.events |= POLLIN;
 	if (mode & SELECT_WRITE) pollBuf.events |= POLLOUT;
+#ifndef _WIN32
+	if (mode & SELECT_ERROR) pollBuf.events |= POLLPRI;
+#endif
 
 	Lucid::Timespan remainingTime(timeout);
 	int rc;
 	do
 	{
+		// round up, so that a timeout below one millisecond
+		// does not become a non-blocking poll
+		Lucid::Timespan::TimeDiff ms = (remainingTime.totalMicroseconds() + 999)/1000;
 		Lucid::Timestamp start;
 #ifdef _WIN32
-		rc = WSAPoll(&pollBuf, 1, static_cast<INT>(remainingTime.totalMilliseconds()));
+		rc = WSAPoll(&pollBuf, 1, static_cast<INT>(ms));
 #else
-		rc = ::poll(&pollBuf, 1, remainingTime.totalMilliseconds());
+		rc = ::poll(&pollBuf, 1, static_cast<int>(ms));
 #endif
 		if (rc < 0 && lastError() == POCO_EINTR)
 		{
@@ -750,7 +750,7 @@ bool SocketImpl::poll(const Lucid::Timespan& timeout, int mode)
 	if (rc < 0) error(errorCode);
 	return rc > 0;
 
-#endif // POCO_HAVE_FD_EPOLL
+#endif // POCO_HAVE_FD_POLL
 }
 
 
@@ -15,6 +15,8 @@
 #include "lucid/Net/SocketStream.h"
 #include "lucid/Net/StreamSocketImpl.h"
 #include "lucid/Exception.h"
+#include <cstring>
+#include <typeinfo>
 
 
 using Lucid::BufferedBidirectionalStreamBuf;
@@ -30,10 +32,13 @@ namespace Net {
 //
 
 
-SocketStreamBuf::SocketStreamBuf(const Socket& socket): 
-	BufferedBidirectionalStreamBuf(STREAM_BUFFER_SIZE, std::ios::in | std::ios::out),
-	_pImpl(dynamic_cast<StreamSocketImpl*>(socket.impl()))
+SocketStreamBuf::SocketStreamBuf(const Socket& socket, std::streamsize bufferSize): 
+	BufferedBidirectionalStreamBuf(bufferSize, std::ios::in | std::ios::out),
+	_pImpl(dynamic_cast<StreamSocketImpl*>(socket.impl())),
+	_bufferSize(bufferSize)
 {
+	poco_assert (bufferSize > 4);
+
 	if (_pImpl)
 		_pImpl->duplicate(); 
 	else
@@ -59,13 +64,71 @@ int SocketStreamBuf::writeToDevice(const char* buffer, std::streamsize length)
 }
 
 
+std::streamsize SocketStreamBuf::xsgetn(char* buffer, std::streamsize length)
+{
+	std::streamsize n = 0;
+	while (n < length)
+	{
+		std::streamsize available = egptr() - gptr();
+		if (available > 0)
+		{
+			if (available > length - n) available = length - n;
+			std::memcpy(buffer + n, gptr(), static_cast<std::size_t>(available));
+			gbump(static_cast<int>(available));
+			n += available;
+		}
+		else if (length - n >= _bufferSize && (getMode() & std::ios::in))
+		{
+			// the data in the buffer has been consumed, so no
+			// characters remain available for putback
+			setg(egptr(), egptr(), egptr());
+			int rc = readFromDevice(buffer + n, length - n);
+			if (rc <= 0) break;
+			n += rc;
+		}
+		else if (underflow() == std::char_traits<char>::eof())
+		{
+			break;
+		}
+	}
+	return n;
+}
+
+
+std::streamsize SocketStreamBuf::xsputn(const char* buffer, std::streamsize length)
+{
+	if (length < _bufferSize || !(getMode() & std::ios::out))
+		return BufferedBidirectionalStreamBuf::xsputn(buffer, length);
+
+	if (typeid(*_pImpl) != typeid(StreamSocketImpl))
+	{
+		// Subclasses like WebSocketImpl only override the single-buffer
+		// sendBytes(), so the buffered data and the caller's data must be
+		// sent with separate calls.
+		if (sync() == -1) return 0;
+		int n = writeToDevice(buffer, length);
+		return n < 0 ? 0 : n;
+	}
+
+	std::size_t pending = static_cast<std::size_t>(pptr() - pbase());
+	SocketBufVec buffers;
+	if (pending > 0)
+		buffers.push_back(Socket::makeBuffer(pbase(), pending));
+	buffers.push_back(Socket::makeBuffer(const_cast<char*>(buffer), static_cast<std::size_t>(length)));
+	int n = _pImpl->sendBytes(buffers);
+	if (n < 0 || static_cast<std::size_t>(n) < pending) return 0;
+	pbump(-static_cast<int>(pending));
+	return n - static_cast<std::streamsize>(pending);
+}
+
+
 //
 // SocketIOS
 //
 
 
-SocketIOS::SocketIOS(const Socket& socket):
-	_buf(socket)
+SocketIOS::SocketIOS(const Socket& socket, std::streamsize bufferSize):
+	_buf(socket, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
@@ -114,6 +177,13 @@ SocketOutputStream::SocketOutputStream(const Socket& socket):
 }
 
 
+SocketOutputStream::SocketOutputStream(const Socket& socket, std::streamsize bufferSize):
+	SocketIOS(socket, bufferSize),
+	std::ostream(&_buf)
+{
+}
+
+
 SocketOutputStream::~SocketOutputStream()
 {
 }
@@ -131,6 +201,13 @@ SocketInputStream::SocketInputStream(const Socket& socket):
 }
 
 
+SocketInputStream::SocketInputStream(const Socket& socket, std::streamsize bufferSize):
+	SocketIOS(socket, bufferSize),
+	std::istream(&_buf)
+{
+}
+
+
 SocketInputStream::~SocketInputStream()
 {
 }
@@ -148,6 +225,13 @@ SocketStream::SocketStream(const Socket& socket):
 }
 
 
+SocketStream::SocketStream(const Socket& socket, std::streamsize bufferSize):
+	SocketIOS(socket, bufferSize),
+	std::iostream(&_buf)
+{
+}
+
+
 SocketStream::~SocketStream()
 {
 }
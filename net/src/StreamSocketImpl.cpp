@@ -21,6 +21,40 @@ namespace Lucid {
 namespace Net {
 
 
+namespace
+{
+	inline std::size_t bufferLength(const SocketBuf& buf)
+	{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+		return buf.len;
+#else
+		return buf.iov_len;
+#endif
+	}
+
+	void consumeBuffers(SocketBufVec& buffers, std::size_t n)
+		/// Removes the first n bytes from buffers.
+	{
+		std::size_t i = 0;
+		while (i < buffers.size() && bufferLength(buffers[i]) <= n)
+		{
+			n -= bufferLength(buffers[i++]);
+		}
+		buffers.erase(buffers.begin(), buffers.begin() + i);
+		if (n > 0)
+		{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+			buffers[0].buf += n;
+			buffers[0].len -= static_cast<ULONG>(n);
+#else
+			buffers[0].iov_base = static_cast<char*>(buffers[0].iov_base) + n;
+			buffers[0].iov_len -= n;
+#endif
+		}
+	}
+}
+
+
 StreamSocketImpl::StreamSocketImpl()
 {
 }
@@ -74,4 +108,29 @@ int StreamSocketImpl::sendBytes(const void* buffer, int length, int flags)
 }
 
 
+int StreamSocketImpl::sendBytes(const SocketBufVec& buffers, int flags)
+{
+	int sent = SocketImpl::sendBytes(buffers, flags);
+	if (sent <= 0 || !getBlocking()) return sent;
+
+	std::size_t total = 0;
+	for (const auto& buf: buffers) total += bufferLength(buf);
+	if (static_cast<std::size_t>(sent) < total)
+	{
+		SocketBufVec remaining(buffers);
+		int n = sent;
+		do
+		{
+			consumeBuffers(remaining, n);
+			Lucid::Thread::yield();
+			n = SocketImpl::sendBytes(remaining, flags);
+			poco_assert_dbg (n >= 0);
+			sent += n;
+		}
+		while (static_cast<std::size_t>(sent) < total);
+	}
+	return sent;
+}
+
+
 } } // namespace Lucid::Net
@@ -28,6 +28,14 @@ namespace Lucid {
 namespace Net {
 
 
+namespace
+{
+	const int MAX_ACCEPT_BATCH = 64;
+		/// The maximum number of connections accepted
+		/// per wake-up of an acceptor thread.
+}
+
+
 //
 // TCPServerConnectionFilter
 //
@@ -38,6 +46,50 @@ TCPServerConnectionFilter::~TCPServerConnectionFilter()
 }
 
 
+int TCPServerConnectionFilter::priority(const StreamSocket& socket)
+{
+	return 0;
+}
+
+
+//
+// TCPServer::Acceptor
+//
+
+
+class TCPServer::Acceptor: public Lucid::Runnable
+	/// An additional acceptor thread with its own server socket.
+{
+public:
+	Acceptor(TCPServer& server, const ServerSocket& socket):
+		_server(server),
+		_socket(socket),
+		_thread(threadName(socket))
+	{
+	}
+
+	void start()
+	{
+		_thread.start(*this);
+	}
+
+	void join()
+	{
+		_thread.join();
+	}
+
+	void run()
+	{
+		_server.acceptConnections(_socket);
+	}
+
+private:
+	TCPServer& _server;
+	ServerSocket _socket;
+	Lucid::Thread _thread;
+};
+
+
 //
 // TCPServer
 //
@@ -107,8 +159,41 @@ void TCPServer::start()
 {
 	poco_assert (_stopped);
 
+	int acceptorThreads = params().getAcceptorThreads();
+	if (acceptorThreads > 1)
+	{
+		if (!_socket.getReusePort())
+			throw Lucid::InvalidAccessException("Multiple acceptor threads require a server socket bound with SO_REUSEPORT");
+
+		std::vector<std::unique_ptr<Acceptor>> acceptors;
+		SocketAddress address = _socket.address();
+		for (int i = 1; i < acceptorThreads; ++i)
+		{
+			ServerSocket socket;
+#if defined(POCO_HAVE_IPv6)
+			if (address.family() == SocketAddress::IPv6)
+			{
+				int ipV6Only = 0;
+#if defined(IPV6_V6ONLY)
+				_socket.getOption(IPPROTO_IPV6, IPV6_V6ONLY, ipV6Only);
+#endif
+				socket.bind6(address, true, true, ipV6Only != 0);
+			}
+			else
+#endif
+			socket.bind(address, true, true);
+			socket.listen();
+			acceptors.push_back(std::unique_ptr<Acceptor>(new Acceptor(*this, socket)));
+		}
+		_acceptors.swap(acceptors);
+	}
+
 	_stopped = false;
 	_thread.start(*this);
+	for (auto& pAcceptor: _acceptors)
+	{
+		pAcceptor->start();
+	}
 }
 
 	
@@ -118,6 +203,11 @@ void TCPServer::stop()
 	{
 		_stopped = true;
 		_thread.join();
+		for (auto& pAcceptor: _acceptors)
+		{
+			pAcceptor->join();
+		}
+		_acceptors.clear();
 		_pDispatcher->stop();
 	}
 }
@@ -125,28 +215,67 @@ void TCPServer::stop()
 
 void TCPServer::run()
 {
+	acceptConnections(_socket);
+}
+
+
+void TCPServer::acceptConnections(ServerSocket& socket)
+{
+	bool blocking = socket.getBlocking();
+	socket.setBlocking(false);
+
+	// enable nodelay per default: OSX really needs that
+	bool noDelay = true;
+#if defined(POCO_OS_FAMILY_UNIX)
+	noDelay = socket.address().family() != AddressFamily::UNIX_LOCAL;
+#endif
+
+	std::vector<StreamSocket> sockets;
+	std::vector<int> priorities;
 	while (!_stopped)
 	{
 		Lucid::Timespan timeout(250000);
 		try
 		{
-			if (_socket.poll(timeout, Socket::SELECT_READ))
+			if (socket.poll(timeout, Socket::SELECT_READ))
 			{
 				try
 				{
-					StreamSocket ss = _socket.acceptConnection();
-					
-					if (!_pConnectionFilter || _pConnectionFilter->accept(ss))
+					// drain the queue of completed connections
+					socket.acceptConnections(sockets, MAX_ACCEPT_BATCH);
+					std::size_t n = 0;
+					for (std::size_t i = 0; i < sockets.size(); ++i)
 					{
-						// enable nodelay per default: OSX really needs that
-#if defined(POCO_OS_FAMILY_UNIX)
-						if (ss.address().family() != AddressFamily::UNIX_LOCAL)
-#endif
+						// a failure here only drops this connection, not the rest of the batch
+						StreamSocket& ss = sockets[i];
+						int priority = 0;
+						try
+						{
+							if (_pConnectionFilter && !_pConnectionFilter->accept(ss)) continue;
+							if (noDelay) ss.setNoDelay(true);
+							if (_pConnectionFilter) priority = _pConnectionFilter->priority(ss);
+						}
+						catch (Lucid::Exception& exc)
+						{
+							ErrorHandler::handle(exc);
+							continue;
+						}
+						catch (std::exception& exc)
+						{
+							ErrorHandler::handle(exc);
+							continue;
+						}
+						catch (...)
 						{
-							ss.setNoDelay(true);
+							ErrorHandler::handle();
+							continue;
 						}
-						_pDispatcher->enqueue(ss);
+						priorities.push_back(priority);
+						if (n < i) sockets[n] = ss;
+						++n;
 					}
+					sockets.erase(sockets.begin() + n, sockets.end());
+					if (n > 0) _pDispatcher->enqueue(sockets, priorities);
 				}
 				catch (Lucid::Exception& exc)
 				{
@@ -160,6 +289,8 @@ void TCPServer::run()
 				{
 					ErrorHandler::handle();
 				}
+				sockets.clear();
+				priorities.clear();
 			}
 		}
 		catch (Lucid::Exception& exc)
@@ -170,6 +301,7 @@ void TCPServer::run()
 			Lucid::Thread::sleep(50); 
 		}
 	}
+	socket.setBlocking(blocking);
 }
 
 
@@ -215,6 +347,18 @@ int TCPServer::refusedConnections() const
 }
 
 
+int TCPServer::shedConnections() const
+{
+	return _pDispatcher->shedConnections();
+}
+
+
+void TCPServer::getQueueWaitHistogram(std::vector<int>& histogram) const
+{
+	_pDispatcher->getQueueWaitHistogram(histogram);
+}
+
+
 void TCPServer::setConnectionFilter(const TCPServerConnectionFilter::Ptr& pConnectionFilter)
 {
 	poco_assert (_stopped);
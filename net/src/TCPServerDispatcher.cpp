@@ -17,6 +17,7 @@
 #include "lucid/Notification.h"
 #include "lucid/AutoPtr.h"
 #include <memory>
+#include <cmath>
 
 
 using Lucid::Notification;
@@ -31,8 +32,9 @@ namespace Net {
 class TCPConnectionNotification: public Notification
 {
 public:
-	TCPConnectionNotification(const StreamSocket& socket):
-		_socket(socket)
+	TCPConnectionNotification(const StreamSocket& socket, const Lucid::Clock& queued):
+		_socket(socket),
+		_queued(queued)
 	{
 	}
 
@@ -45,8 +47,14 @@ public:
 		return _socket;
 	}
 
+	const Lucid::Clock& queued() const
+	{
+		return _queued;
+	}
+
 private:
 	StreamSocket _socket;
+	Lucid::Clock _queued;
 };
 
 
@@ -58,7 +66,11 @@ TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactor
 	_currentConnections(0),
 	_maxConcurrentConnections(0),
 	_refusedConnections(0),
+	_shedConnections(0),
 	_stopped(false),
+	_aboveTarget(false),
+	_shedding(false),
+	_shedCount(0),
 	_pConnectionFactory(pFactory),
 	_threadPool(threadPool)
 {
@@ -69,6 +81,9 @@ TCPServerDispatcher::TCPServerDispatcher(TCPServerConnectionFactory::Ptr pFactor
 
 	if (_pParams->getMaxThreads() == 0)
 		_pParams->setMaxThreads(threadPool.capacity());
+
+	for (int i = 0; i < QUEUE_WAIT_BUCKETS; ++i)
+		_queueWaitHistogram[i] = 0;
 }
 
 
@@ -106,7 +121,7 @@ void TCPServerDispatcher::run()
 		if (pNf)
 		{
 			TCPConnectionNotification* pCNf = dynamic_cast<TCPConnectionNotification*>(pNf.get());
-			if (pCNf)
+			if (pCNf && admitConnection(pCNf->queued()))
 			{
 				std::unique_ptr<TCPServerConnection> pConnection(_pConnectionFactory->createConnection(pCNf->socket()));
 				poco_check_ptr(pConnection.get());
@@ -132,13 +147,34 @@ namespace
 }
 
 
-void TCPServerDispatcher::enqueue(const StreamSocket& socket)
+void TCPServerDispatcher::enqueue(const StreamSocket& socket, int priority)
+{
+	Lucid::Clock now;
+	FastMutex::ScopedLock lock(_mutex);
+
+	enqueueImpl(socket, priority, now);
+}
+
+
+void TCPServerDispatcher::enqueue(const std::vector<StreamSocket>& sockets, const std::vector<int>& priorities)
 {
+	poco_assert (sockets.size() == priorities.size());
+
+	Lucid::Clock now;
 	FastMutex::ScopedLock lock(_mutex);
 
+	for (std::size_t i = 0; i < sockets.size(); ++i)
+	{
+		enqueueImpl(sockets[i], priorities[i], now);
+	}
+}
+
+
+void TCPServerDispatcher::enqueueImpl(const StreamSocket& socket, int priority, const Lucid::Clock& now)
+{
 	if (_queue.size() < _pParams->getMaxQueued())
 	{
-		_queue.enqueueNotification(new TCPConnectionNotification(socket));
+		_queue.enqueueNotification(new TCPConnectionNotification(socket, now), priority);
 		if (!_queue.hasIdleThreads() && _currentThreads < _pParams->getMaxThreads())
 		{
 			try
@@ -225,6 +261,22 @@ int TCPServerDispatcher::refusedConnections() const
 }
 
 
+int TCPServerDispatcher::shedConnections() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _shedConnections;
+}
+
+
+void TCPServerDispatcher::getQueueWaitHistogram(std::vector<int>& histogram) const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	histogram.assign(_queueWaitHistogram, _queueWaitHistogram + QUEUE_WAIT_BUCKETS);
+}
+
+
 void TCPServerDispatcher::beginConnection()
 {
 	FastMutex::ScopedLock lock(_mutex);
@@ -244,4 +296,65 @@ void TCPServerDispatcher::endConnection()
 }
 
 
+bool TCPServerDispatcher::admitConnection(const Lucid::Clock& queued)
+{
+	Lucid::Clock now;
+	Lucid::Clock::ClockDiff wait = now - queued;
+	int bucket = 0;
+	for (Lucid::Clock::ClockDiff w = wait; w > 0 && bucket < QUEUE_WAIT_BUCKETS - 1; w >>= 1) ++bucket;
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	++_queueWaitHistogram[bucket];
+
+	Lucid::Clock::ClockDiff target = _pParams->getQueueTarget().totalMicroseconds();
+	if (target == 0) return true;
+
+	// CoDel: shed once the queueing delay has been above the target
+	// for a whole interval, then with increasing frequency until it
+	// falls below the target again.
+	Lucid::Clock::ClockDiff interval = _pParams->getQueueInterval().totalMicroseconds();
+	bool okToShed = false;
+	if (wait < target)
+	{
+		_aboveTarget = false;
+	}
+	else if (!_aboveTarget)
+	{
+		_aboveTarget = true;
+		_firstAboveTime = now + interval;
+	}
+	else if (now >= _firstAboveTime)
+	{
+		okToShed = true;
+	}
+
+	if (_shedding)
+	{
+		if (!okToShed)
+		{
+			_shedding = false;
+		}
+		else if (now >= _shedNext)
+		{
+			++_shedCount;
+			_shedNext += static_cast<Lucid::Clock::ClockDiff>(interval/std::sqrt(static_cast<double>(_shedCount)));
+			++_shedConnections;
+			return false;
+		}
+	}
+	else if (okToShed)
+	{
+		// if shedding stopped only recently, continue
+		// at about the rate at which it stopped
+		_shedCount = (_shedCount > 2 && now - _shedNext < 8*interval) ? _shedCount - 2 : 1;
+		_shedding = true;
+		_shedNext = now + static_cast<Lucid::Clock::ClockDiff>(interval/std::sqrt(static_cast<double>(_shedCount)));
+		++_shedConnections;
+		return false;
+	}
+	return true;
+}
+
+
 } } // namespace Lucid::Net
@@ -23,7 +23,10 @@ TCPServerParams::TCPServerParams():
 	_threadIdleTime(10000000),
 	_maxThreads(0),
 	_maxQueued(64),
-	_threadPriority(Lucid::Thread::PRIO_NORMAL)
+	_threadPriority(Lucid::Thread::PRIO_NORMAL),
+	_acceptorThreads(1),
+	_queueTarget(0),
+	_queueInterval(100000)
 {
 }
 
@@ -61,4 +64,28 @@ void TCPServerParams::setThreadPriority(Lucid::Thread::Priority prio)
 }
 
 
+void TCPServerParams::setAcceptorThreads(int count)
+{
+	poco_assert (count > 0);
+
+	_acceptorThreads = count;
+}
+
+
+void TCPServerParams::setQueueTarget(const Lucid::Timespan& target)
+{
+	poco_assert (target >= 0);
+
+	_queueTarget = target;
+}
+
+
+void TCPServerParams::setQueueInterval(const Lucid::Timespan& interval)
+{
+	poco_assert (interval > 0);
+
+	_queueInterval = interval;
+}
+
+
 } } // namespace Lucid::Net
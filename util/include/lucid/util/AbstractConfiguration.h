@@ -19,7 +19,9 @@
 
 
 #include "lucid/Util/Util.h"
+#include "lucid/Util/ConfigurationSnapshot.h"
 #include "lucid/Mutex.h"
+#include "lucid/CopyOnWritePtr.h"
 #include "lucid/RefCountedObject.h"
 #include "lucid/AutoPtr.h"
 #include "lucid/BasicEvent.h"
@@ -44,6 +46,10 @@ class Util_API AbstractConfiguration: public Lucid::RefCountedObject
 	/// All public methods are synchronized, so the class is safe for multithreaded use.
 	/// AbstractConfiguration implements reference counting based garbage collection.
 	///
+	/// Code that reads many properties, possibly from many threads, can
+	/// obtain an immutable ConfigurationSnapshot with snapshot() and read
+	/// the properties from the snapshot without locking.
+	///
 	/// Subclasses must override the getRaw(), setRaw() and enumerate() methods.
 {
 public:
@@ -106,6 +112,15 @@ public:
 		/// Fired after a property has been removed by
 		/// a call to remove().
 
+	Lucid::BasicEvent<const ConfigurationSnapshot::Ptr> snapshotPublished;
+		/// Fired after a new snapshot has been published
+		/// because the configuration has changed, or by
+		/// a call to publishSnapshot().
+		///
+		/// If the snapshot has been published because of a change
+		/// of a property, the event is fired before propertyChanged
+		/// or propertyRemoved.
+
 	AbstractConfiguration();
 		/// Creates the AbstractConfiguration.
 
@@ -319,7 +334,36 @@ public:
 		
 	bool eventsEnabled() const;
 		/// Returns true iff events are enabled.
-	
+
+	ConfigurationSnapshot::Ptr snapshot() const;
+		/// Returns the current snapshot of the configuration.
+		///
+		/// The first call creates and publishes the snapshot. Once a
+		/// snapshot has been published, a new one is published with
+		/// every change made with one of the set...() functions or
+		/// remove(), and when a configuration is loaded or added to a
+		/// LayeredConfiguration. Obtaining the current snapshot does not
+		/// lock the configuration, so snapshot() can be called by many
+		/// threads concurrently, typically once per request:
+		///
+		///     ConfigurationSnapshot::Ptr pConfig = config().snapshot();
+		///     int maxItems = pConfig->getInt("app.maxItems", 100);
+		///     std::string title = pConfig->getString("app.title");
+		///
+		/// Only the properties that can be enumerated with keys() are
+		/// contained in the snapshot. Values that change without a call
+		/// to one of the functions listed above, such as the dynamic
+		/// properties of SystemConfiguration, keep the value they had
+		/// when the snapshot was published.
+
+	void publishSnapshot();
+		/// Creates and publishes a new snapshot of the configuration.
+		///
+		/// Must be called after the configuration has been changed
+		/// in a way that does not publish a new snapshot automatically,
+		/// e.g., after a configuration added to a LayeredConfiguration
+		/// has been changed directly.
+
 protected:
 	virtual bool getRaw(const std::string& key, std::string& value) const = 0;
 		/// If the property with the given key exists, stores the property's value
@@ -367,12 +411,21 @@ protected:
 
 	static bool parseBool(const std::string& value);
 	void setRawWithEvent(const std::string& key, std::string value);
+
+	void updateSnapshot();
+		/// Publishes a new snapshot if a snapshot has been
+		/// published before. Must be called by subclasses
+		/// after their properties have been changed, e.g.
+		/// by loading a file.
 	
 	virtual ~AbstractConfiguration();
 
 private:
+	using SnapshotPtr = CopyOnWritePtr<ConfigurationSnapshot::Ptr>;
+
 	std::string internalExpand(const std::string& value) const;
 	std::string uncheckedExpand(const std::string& value) const;
+	ConfigurationSnapshot::Ptr publish() const;
 
 	AbstractConfiguration(const AbstractConfiguration&);
 	AbstractConfiguration& operator = (const AbstractConfiguration&);
@@ -380,7 +433,9 @@ private:
 	mutable int _depth;
 	bool        _eventsEnabled;
 	mutable Lucid::Mutex _mutex;
+	mutable SnapshotPtr  _snapshot;
 	
+	friend class ConfigurationSnapshot;
 	friend class LayeredConfiguration;
 	friend class ConfigurationView;
 	friend class ConfigurationMapper;
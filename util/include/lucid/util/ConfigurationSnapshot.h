@@ -0,0 +1,182 @@
+//
+// ConfigurationSnapshot.h
+//
+// Library: Util
+// Package: Configuration
+// Module:  ConfigurationSnapshot
+//
+// Definition of the ConfigurationSnapshot class.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Util_ConfigurationSnapshot_INCLUDED
+#define Util_ConfigurationSnapshot_INCLUDED
+
+
+#include "lucid/Util/Util.h"
+#include "lucid/RefCountedObject.h"
+#include "lucid/AutoPtr.h"
+#include "lucid/Hash.h"
+#include <unordered_map>
+
+
+namespace Lucid {
+namespace Util {
+
+
+class AbstractConfiguration;
+
+
+class Util_API ConfigurationSnapshot: public Lucid::RefCountedObject
+	/// An immutable copy of all properties of an AbstractConfiguration.
+	///
+	/// The values are stored with all property references (${...})
+	/// already expanded, and are converted to numbers and booleans
+	/// when the snapshot is created, so that the get...() functions
+	/// only have to look up the key. As a snapshot never changes, it
+	/// can be read by any number of threads without locking.
+	///
+	/// Snapshots are obtained from AbstractConfiguration::snapshot().
+	/// The get...() functions behave like the ones of the configuration
+	/// at the time the snapshot was created, including the exceptions
+	/// thrown for missing properties and invalid values.
+{
+public:
+	using Ptr = AutoPtr<ConfigurationSnapshot>;
+
+	std::size_t size() const;
+		/// Returns the number of properties in the snapshot.
+
+	bool has(const std::string& key) const;
+		/// Returns true iff the property with the given key exists.
+
+	const std::string& getString(const std::string& key) const;
+		/// Returns the expanded string value of the property with the
+		/// given key. Throws a NotFoundException if the key does not exist.
+
+	std::string getString(const std::string& key, const std::string& defaultValue) const;
+		/// If a property with the given key exists, returns its expanded
+		/// string value, otherwise returns the given default value.
+
+	int getInt(const std::string& key) const;
+		/// See AbstractConfiguration::getInt().
+
+	int getInt(const std::string& key, int defaultValue) const;
+		/// See AbstractConfiguration::getInt().
+
+	unsigned int getUInt(const std::string& key) const;
+		/// See AbstractConfiguration::getUInt().
+
+	unsigned int getUInt(const std::string& key, unsigned int defaultValue) const;
+		/// See AbstractConfiguration::getUInt().
+
+#if defined(POCO_HAVE_INT64)
+
+	Int64 getInt64(const std::string& key) const;
+		/// See AbstractConfiguration::getInt64().
+
+	Int64 getInt64(const std::string& key, Int64 defaultValue) const;
+		/// See AbstractConfiguration::getInt64().
+
+	UInt64 getUInt64(const std::string& key) const;
+		/// See AbstractConfiguration::getUInt64().
+
+	UInt64 getUInt64(const std::string& key, UInt64 defaultValue) const;
+		/// See AbstractConfiguration::getUInt64().
+
+#endif // defined(POCO_HAVE_INT64)
+
+	double getDouble(const std::string& key) const;
+		/// See AbstractConfiguration::getDouble().
+
+	double getDouble(const std::string& key, double defaultValue) const;
+		/// See AbstractConfiguration::getDouble().
+
+	bool getBool(const std::string& key) const;
+		/// See AbstractConfiguration::getBool().
+
+	bool getBool(const std::string& key, bool defaultValue) const;
+		/// See AbstractConfiguration::getBool().
+
+protected:
+	~ConfigurationSnapshot();
+
+private:
+	enum ValueFlags
+	{
+		VALUE_INT      = 0x01,
+		VALUE_UINT     = 0x02,
+		VALUE_INT64    = 0x04,
+		VALUE_UINT64   = 0x08,
+		VALUE_DOUBLE   = 0x10,
+		VALUE_BOOL     = 0x20,
+		VALUE_CIRCULAR = 0x40
+			/// Expanding the value failed because of a circular reference.
+	};
+
+	struct Value
+		/// An expanded property value, and the conversions
+		/// of the value that succeeded (see ValueFlags).
+	{
+		std::string string;
+		int         flags;
+		int         intValue;
+		unsigned    uintValue;
+		Int64       int64Value;
+		UInt64      uint64Value;
+		double      doubleValue;
+		bool        boolValue;
+	};
+
+	using ValueMap = std::unordered_map<std::string, Value, Lucid::Hash<std::string>>;
+
+	explicit ConfigurationSnapshot(const AbstractConfiguration& config);
+		/// Creates a snapshot of all properties of the given configuration.
+		///
+		/// The configuration's mutex must be held by the caller.
+
+	void collect(const AbstractConfiguration& config, const std::string& key);
+	static void convert(Value& value);
+	const Value* find(const std::string& key) const;
+	const Value& get(const std::string& key) const;
+	static const std::string& string(const Value& value);
+
+	ConfigurationSnapshot(const ConfigurationSnapshot&);
+	ConfigurationSnapshot& operator = (const ConfigurationSnapshot&);
+
+	ValueMap _values;
+
+	friend class AbstractConfiguration;
+};
+
+
+//
+// inlines
+//
+inline std::size_t ConfigurationSnapshot::size() const
+{
+	return _values.size();
+}
+
+
+inline bool ConfigurationSnapshot::has(const std::string& key) const
+{
+	return _values.find(key) != _values.end();
+}
+
+
+inline const ConfigurationSnapshot::Value* ConfigurationSnapshot::find(const std::string& key) const
+{
+	ValueMap::const_iterator it = _values.find(key);
+	return it != _values.end() ? &it->second : 0;
+}
+
+
+} } // namespace Lucid::Util
+
+
+#endif // Util_ConfigurationSnapshot_INCLUDED
@@ -68,6 +68,9 @@ public:
 	void load(const std::string& path);
 		/// Loads the configuration data from the given file, which 
 		/// must be in initialization file format.
+		///
+		/// The file is mapped into memory and parsed in place.
+		/// It must not be truncated while it is being loaded.
 
 protected:
 	bool getRaw(const std::string& key, std::string& value) const;
@@ -77,7 +80,8 @@ protected:
 	~IniFileConfiguration();
 
 private:
-	void parseLine(std::istream& istr);
+	void parse(const char* begin, const char* end);
+	void parseLine(const char*& it, const char* end);
 
 	struct ICompare
 	{
@@ -84,6 +84,9 @@ public:
 
 	void load(const std::string& path);
 		/// Loads the configuration from the given file
+		///
+		/// The file is mapped into memory and parsed in place.
+		/// It must not be truncated while it is being loaded.
 
 
 	void load(std::istream& istr);
@@ -127,6 +130,9 @@ protected:
 private:
 
 
+	void loadObject(const Lucid::DynamicAny& result);
+
+
 	JSON::Object::Ptr findStart(const std::string& key, std::string& lastPart);
 
 
@@ -73,6 +73,9 @@ public:
 	void load(const std::string& path);
 		/// Loads the configuration data from the given file, which 
 		/// must be in properties file format.
+		///
+		/// The file is mapped into memory and parsed in place.
+		/// It must not be truncated while it is being loaded.
 		
 	void save(std::ostream& ostr) const;
 		/// Writes the configuration data to the given stream.
@@ -88,8 +91,9 @@ protected:
 	~PropertyFileConfiguration();
 	
 private:
-	void parseLine(std::istream& istr);
-	static int readChar(std::istream& istr);
+	void parse(const char* begin, const char* end);
+	void parseLine(const char*& it, const char* end);
+	static void readValue(const char*& it, const char* end, std::string& value);
 };
 
 
@@ -29,6 +29,9 @@ namespace Lucid {
 namespace Util {
 
 
+class TimerWheel;
+
+
 class Util_API TimerTask: public Lucid::RefCountedObject, public Lucid::Runnable
 	/// A task that can be scheduled for one-time or
 	/// repeated execution by a Timer.
@@ -73,7 +76,16 @@ private:
 	Lucid::Timestamp _lastExecution;
 	bool _isCancelled;
 
+	TimerWheel* _pWheel;
+	TimerTask* _pPrev;
+	TimerTask* _pNext;
+	Lucid::UInt64 _expiry;
+	long _interval;
+	int _slot;
+	bool _fixedRate;
+
 	friend class TaskNotification;
+	friend class TimerWheel;
 };
 
 
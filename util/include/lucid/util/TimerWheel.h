@@ -0,0 +1,192 @@
+//
+// TimerWheel.h
+//
+// Library: Util
+// Package: Timer
+// Module:  TimerWheel
+//
+// Definition of the TimerWheel class.
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Util_TimerWheel_INCLUDED
+#define Util_TimerWheel_INCLUDED
+
+
+#include "lucid/Util/Util.h"
+#include "lucid/Util/TimerTask.h"
+#include "lucid/Thread.h"
+#include "lucid/Runnable.h"
+#include "lucid/Mutex.h"
+#include "lucid/Event.h"
+#include "lucid/Clock.h"
+#include <vector>
+
+
+namespace Lucid {
+namespace Util {
+
+
+class Util_API TimerWheel: protected Lucid::Runnable
+	/// A TimerWheel schedules tasks (TimerTask objects) for future execution
+	/// in a background thread, like Timer, but is designed for a large
+	/// number of timers that are mostly cancelled or rescheduled before
+	/// they fire, such as per-connection idle timeouts and retries.
+	///
+	/// Pending tasks are kept in a hierarchical timing wheel with six
+	/// levels of 64 slots each. Scheduling, rescheduling and cancelling
+	/// a task take constant time and do not allocate memory, as the
+	/// list linkage is stored in the TimerTask itself. All tasks that
+	/// expire in the same tick are collected in one batch and executed
+	/// sequentially without holding the wheel's lock.
+	///
+	/// Time is measured in ticks of the resolution given to the
+	/// constructor (1 millisecond by default). Tasks are never
+	/// executed early, but may be executed up to one tick late.
+	/// Delays longer than 2^36 ticks are supported, but such tasks
+	/// are re-inserted into the wheel until they are due.
+	///
+	/// A TimerTask can be pending in at most one TimerWheel at a time.
+	/// Calling TimerTask::cancel() directly prevents the task from
+	/// running, but the task stays in the wheel until its slot is
+	/// processed. Use TimerWheel::cancel() to remove it immediately.
+	///
+	/// TimerWheel is safe for multithreaded use - multiple threads can
+	/// schedule and cancel tasks simultaneously.
+{
+public:
+	TimerWheel();
+		/// Creates the TimerWheel with a resolution of 1 millisecond.
+
+	explicit TimerWheel(long resolution);
+		/// Creates the TimerWheel with the given resolution
+		/// in milliseconds.
+
+	TimerWheel(long resolution, Lucid::Thread::Priority priority);
+		/// Creates the TimerWheel with the given resolution
+		/// in milliseconds, using a timer thread with the
+		/// given priority.
+
+	~TimerWheel();
+		/// Destroys the TimerWheel, cancelling all pending tasks.
+
+	void schedule(TimerTask::Ptr pTask, long delay);
+		/// Schedules a task for execution after the given delay
+		/// in milliseconds.
+		///
+		/// If the task is already pending in this TimerWheel,
+		/// it is moved to the new time. This makes it cheap to
+		/// push back an idle timeout whenever there is activity.
+		///
+		/// Throws a Lucid::IllegalStateException if the task has
+		/// been cancelled, is pending in another TimerWheel, or is
+		/// a periodic task that is currently being executed.
+
+	void schedule(TimerTask::Ptr pTask, Lucid::Clock clock);
+		/// Schedules a task for execution at the specified time.
+		///
+		/// If the time lies in the past, the task is executed
+		/// with the next tick.
+
+	void schedule(TimerTask::Ptr pTask, long delay, long interval);
+		/// Schedules a task for periodic execution.
+		///
+		/// The task is first executed after the given delay.
+		/// Subsequently, the task is executed periodically with
+		/// the given interval in milliseconds between invocations.
+
+	void scheduleAtFixedRate(TimerTask::Ptr pTask, long delay, long interval);
+		/// Schedules a task for periodic execution at a fixed rate.
+		///
+		/// The task is first executed after the given delay.
+		/// Subsequently, the task is executed periodically
+		/// every number of milliseconds specified by interval.
+		///
+		/// If task execution takes longer than the given interval,
+		/// further executions are delayed.
+
+	bool cancel(TimerTask::Ptr pTask);
+		/// Cancels the given task (see TimerTask::cancel()) and
+		/// removes it from the wheel.
+		///
+		/// Returns true if the task was pending in this TimerWheel,
+		/// or false otherwise. If the task is currently running,
+		/// it is allowed to finish, but will never run again.
+
+	void clear();
+		/// Removes all pending tasks from the wheel, without
+		/// cancelling them. Tasks that are currently running
+		/// are allowed to finish; periodic tasks among them
+		/// will not be run again.
+
+	std::size_t size() const;
+		/// Returns the number of pending tasks, including
+		/// tasks that have been cancelled with TimerTask::cancel()
+		/// but are still in the wheel.
+
+	long resolution() const;
+		/// Returns the resolution of the wheel in milliseconds.
+
+protected:
+	void run();
+
+private:
+	enum
+	{
+		LEVELS     = 6,
+		SLOT_BITS  = 6,
+		SLOTS      = 1 << SLOT_BITS,
+		SLOT_MASK  = SLOTS - 1
+	};
+
+	typedef std::vector<TimerTask*> TaskVec;
+
+	TimerWheel(const TimerWheel&);
+	TimerWheel& operator = (const TimerWheel&);
+
+	void init(long resolution);
+	void schedule(TimerTask::Ptr pTask, Lucid::Clock clock, long interval, bool fixedRate);
+	Lucid::UInt64 currentTick() const;
+	Lucid::UInt64 toTick(const Lucid::Clock& clock) const;
+	void insert(TimerTask* pTask);
+	void unlink(TimerTask* pTask);
+	void cascade(int level);
+	void expire(int index);
+	void advance(Lucid::UInt64 tick);
+	Lucid::UInt64 nextTick() const;
+	void execute(TimerTask* pTask);
+	bool reschedule(TimerTask* pTask);
+	void release(TaskVec& tasks);
+
+	Lucid::Clock::ClockDiff _tickLength;
+	Lucid::Clock _start;
+	Lucid::UInt64 _base;
+	Lucid::UInt64 _wakeUpTick;
+	Lucid::UInt64 _occupied[LEVELS];
+	TimerTask* _slots[LEVELS*SLOTS];
+	std::size_t _count;
+	TaskVec _expired;
+	bool _stopped;
+	Lucid::Event _wakeUp;
+	mutable Lucid::FastMutex _mutex;
+	Lucid::Thread _thread;
+};
+
+
+//
+// inlines
+//
+inline long TimerWheel::resolution() const
+{
+	return static_cast<long>(_tickLength/1000);
+}
+
+
+} } // namespace Lucid::Util
+
+
+#endif // Util_TimerWheel_INCLUDED
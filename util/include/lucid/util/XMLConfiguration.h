@@ -145,6 +145,9 @@ public:
 	void load(const std::string& path);
 		/// Loads the XML document containing the configuration data
 		/// from the given file.
+		///
+		/// The file is mapped into memory and parsed in place.
+		/// It must not be truncated while it is being loaded.
 		
 	void load(const Lucid::XML::Document* pDocument);
 		/// Loads the XML document containing the configuration data
@@ -388,6 +388,7 @@ void AbstractConfiguration::remove(const std::string& key)
 		Mutex::ScopedLock lock(_mutex);
 		removeRaw(key);
 	}
+	updateSnapshot();
 	if (_eventsEnabled)
 	{
 		propertyRemoved(this, key);
@@ -407,12 +408,65 @@ bool AbstractConfiguration::eventsEnabled() const
 }
 
 
+ConfigurationSnapshot::Ptr AbstractConfiguration::snapshot() const
+{
+	{
+		SnapshotPtr::ReadGuard guard(_snapshot);
+		if (*guard) return *guard;
+	}
+
+	Mutex::ScopedLock lock(_mutex);
+
+	const ConfigurationSnapshot::Ptr& pCurrent = *_snapshot.get();
+	if (pCurrent) return pCurrent;
+	return publish();
+}
+
+
+void AbstractConfiguration::publishSnapshot()
+{
+	ConfigurationSnapshot::Ptr pSnapshot;
+	{
+		Mutex::ScopedLock lock(_mutex);
+		pSnapshot = publish();
+	}
+	if (_eventsEnabled)
+	{
+		snapshotPublished(this, pSnapshot);
+	}
+}
+
+
 void AbstractConfiguration::removeRaw(const std::string& key)
 {
 	throw Lucid::NotImplementedException("removeRaw()");
 }
 
 
+void AbstractConfiguration::updateSnapshot()
+{
+	ConfigurationSnapshot::Ptr pSnapshot;
+	{
+		Mutex::ScopedLock lock(_mutex);
+		if (!*_snapshot.get()) return;
+		pSnapshot = publish();
+	}
+	if (_eventsEnabled)
+	{
+		snapshotPublished(this, pSnapshot);
+	}
+}
+
+
+ConfigurationSnapshot::Ptr AbstractConfiguration::publish() const
+{
+	// Writers are serialized by _mutex, which must be held by the caller.
+	ConfigurationSnapshot::Ptr pSnapshot = new ConfigurationSnapshot(*this);
+	_snapshot.assign(new ConfigurationSnapshot::Ptr(pSnapshot));
+	return pSnapshot;
+}
+
+
 std::string AbstractConfiguration::internalExpand(const std::string& value) const
 {
 	AutoCounter counter(_depth);
@@ -526,6 +580,7 @@ void AbstractConfiguration::setRawWithEvent(const std::string& key, std::string
 		Mutex::ScopedLock lock(_mutex);
 		setRaw(key, value);
 	}
+	updateSnapshot();
 	if (_eventsEnabled)
 	{
 		propertyChanged(this, kv);
@@ -47,6 +47,7 @@ void ConfigurationMapper::setRaw(const std::string& key, const std::string& valu
 {
 	std::string translatedKey = translateKey(key);
 	_pConfig->setRaw(translatedKey, value); 
+	_pConfig->updateSnapshot();
 }
 
 
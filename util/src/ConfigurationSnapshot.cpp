@@ -0,0 +1,258 @@
+//
+// ConfigurationSnapshot.cpp
+//
+// Library: Util
+// Package: Configuration
+// Module:  ConfigurationSnapshot
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "lucid/Util/ConfigurationSnapshot.h"
+#include "lucid/Util/AbstractConfiguration.h"
+#include "lucid/Exception.h"
+#include "lucid/NumberParser.h"
+#include "lucid/String.h"
+
+
+namespace Lucid {
+namespace Util {
+
+
+namespace
+{
+	inline bool isHex(const std::string& value)
+	{
+		return value.compare(0, 2, "0x") == 0 || value.compare(0, 2, "0X") == 0;
+	}
+
+	bool tryParseBool(const std::string& value, bool& result)
+		/// Same as AbstractConfiguration::parseBool(),
+		/// but returns false instead of throwing.
+	{
+		int n;
+		if (NumberParser::tryParse(value, n))
+			result = n != 0;
+		else if (icompare(value, "true") == 0 || icompare(value, "yes") == 0 || icompare(value, "on") == 0)
+			result = true;
+		else if (icompare(value, "false") == 0 || icompare(value, "no") == 0 || icompare(value, "off") == 0)
+			result = false;
+		else
+			return false;
+		return true;
+	}
+}
+
+
+ConfigurationSnapshot::ConfigurationSnapshot(const AbstractConfiguration& config)
+{
+	collect(config, std::string());
+}
+
+
+ConfigurationSnapshot::~ConfigurationSnapshot()
+{
+}
+
+
+void ConfigurationSnapshot::collect(const AbstractConfiguration& config, const std::string& key)
+{
+	AbstractConfiguration::Keys range;
+	config.enumerate(key, range);
+	for (const auto& name: range)
+	{
+		std::string fullKey(key);
+		if (!fullKey.empty()) fullKey += '.';
+		fullKey += name;
+
+		std::string raw;
+		if (config.getRaw(fullKey, raw))
+		{
+			Value& value = _values[fullKey];
+			value.flags = 0;
+			try
+			{
+				value.string = config.internalExpand(raw);
+				convert(value);
+			}
+			catch (CircularReferenceException&)
+			{
+				value.flags = VALUE_CIRCULAR;
+			}
+		}
+		collect(config, fullKey);
+	}
+}
+
+
+void ConfigurationSnapshot::convert(Value& value)
+{
+	const std::string& s = value.string;
+	if (isHex(s))
+	{
+		unsigned hex;
+		if (NumberParser::tryParseHex(s, hex))
+		{
+			value.intValue  = static_cast<int>(hex);
+			value.uintValue = hex;
+			value.flags |= VALUE_INT | VALUE_UINT;
+		}
+#if defined(POCO_HAVE_INT64)
+		UInt64 hex64;
+		if (NumberParser::tryParseHex64(s, hex64))
+		{
+			value.int64Value  = static_cast<Int64>(hex64);
+			value.uint64Value = hex64;
+			value.flags |= VALUE_INT64 | VALUE_UINT64;
+		}
+#endif
+	}
+	else
+	{
+		if (NumberParser::tryParse(s, value.intValue)) value.flags |= VALUE_INT;
+		if (NumberParser::tryParseUnsigned(s, value.uintValue)) value.flags |= VALUE_UINT;
+#if defined(POCO_HAVE_INT64)
+		if (NumberParser::tryParse64(s, value.int64Value)) value.flags |= VALUE_INT64;
+		if (NumberParser::tryParseUnsigned64(s, value.uint64Value)) value.flags |= VALUE_UINT64;
+#endif
+	}
+	if (NumberParser::tryParseFloat(s, value.doubleValue)) value.flags |= VALUE_DOUBLE;
+	if (tryParseBool(s, value.boolValue)) value.flags |= VALUE_BOOL;
+}
+
+
+const ConfigurationSnapshot::Value& ConfigurationSnapshot::get(const std::string& key) const
+{
+	const Value* pValue = find(key);
+	if (!pValue) throw NotFoundException(key);
+	return *pValue;
+}
+
+
+const std::string& ConfigurationSnapshot::string(const Value& value)
+{
+	if (value.flags & VALUE_CIRCULAR) throw CircularReferenceException("Too many property references encountered");
+	return value.string;
+}
+
+
+const std::string& ConfigurationSnapshot::getString(const std::string& key) const
+{
+	return string(get(key));
+}
+
+
+std::string ConfigurationSnapshot::getString(const std::string& key, const std::string& defaultValue) const
+{
+	const Value* pValue = find(key);
+	return pValue ? string(*pValue) : defaultValue;
+}
+
+
+//
+// A conversion that failed when the snapshot was created is
+// repeated with the parse function of AbstractConfiguration,
+// which throws the same exception as AbstractConfiguration.
+//
+
+
+int ConfigurationSnapshot::getInt(const std::string& key) const
+{
+	const Value& value = get(key);
+	return (value.flags & VALUE_INT) ? value.intValue : AbstractConfiguration::parseInt(string(value));
+}
+
+
+int ConfigurationSnapshot::getInt(const std::string& key, int defaultValue) const
+{
+	const Value* pValue = find(key);
+	if (!pValue) return defaultValue;
+	return (pValue->flags & VALUE_INT) ? pValue->intValue : AbstractConfiguration::parseInt(string(*pValue));
+}
+
+
+unsigned int ConfigurationSnapshot::getUInt(const std::string& key) const
+{
+	const Value& value = get(key);
+	return (value.flags & VALUE_UINT) ? value.uintValue : AbstractConfiguration::parseUInt(string(value));
+}
+
+
+unsigned int ConfigurationSnapshot::getUInt(const std::string& key, unsigned int defaultValue) const
+{
+	const Value* pValue = find(key);
+	if (!pValue) return defaultValue;
+	return (pValue->flags & VALUE_UINT) ? pValue->uintValue : AbstractConfiguration::parseUInt(string(*pValue));
+}
+
+
+#if defined(POCO_HAVE_INT64)
+
+
+Int64 ConfigurationSnapshot::getInt64(const std::string& key) const
+{
+	const Value& value = get(key);
+	return (value.flags & VALUE_INT64) ? value.int64Value : AbstractConfiguration::parseInt64(string(value));
+}
+
+
+Int64 ConfigurationSnapshot::getInt64(const std::string& key, Int64 defaultValue) const
+{
+	const Value* pValue = find(key);
+	if (!pValue) return defaultValue;
+	return (pValue->flags & VALUE_INT64) ? pValue->int64Value : AbstractConfiguration::parseInt64(string(*pValue));
+}
+
+
+UInt64 ConfigurationSnapshot::getUInt64(const std::string& key) const
+{
+	const Value& value = get(key);
+	return (value.flags & VALUE_UINT64) ? value.uint64Value : AbstractConfiguration::parseUInt64(string(value));
+}
+
+
+UInt64 ConfigurationSnapshot::getUInt64(const std::string& key, UInt64 defaultValue) const
+{
+	const Value* pValue = find(key);
+	if (!pValue) return defaultValue;
+	return (pValue->flags & VALUE_UINT64) ? pValue->uint64Value : AbstractConfiguration::parseUInt64(string(*pValue));
+}
+
+
+#endif // defined(POCO_HAVE_INT64)
+
+
+double ConfigurationSnapshot::getDouble(const std::string& key) const
+{
+	const Value& value = get(key);
+	return (value.flags & VALUE_DOUBLE) ? value.doubleValue : NumberParser::parseFloat(string(value));
+}
+
+
+double ConfigurationSnapshot::getDouble(const std::string& key, double defaultValue) const
+{
+	const Value* pValue = find(key);
+	if (!pValue) return defaultValue;
+	return (pValue->flags & VALUE_DOUBLE) ? pValue->doubleValue : NumberParser::parseFloat(string(*pValue));
+}
+
+
+bool ConfigurationSnapshot::getBool(const std::string& key) const
+{
+	const Value& value = get(key);
+	return (value.flags & VALUE_BOOL) ? value.boolValue : AbstractConfiguration::parseBool(string(value));
+}
+
+
+bool ConfigurationSnapshot::getBool(const std::string& key, bool defaultValue) const
+{
+	const Value* pValue = find(key);
+	if (!pValue) return defaultValue;
+	return (pValue->flags & VALUE_BOOL) ? pValue->boolValue : AbstractConfiguration::parseBool(string(*pValue));
+}
+
+
+} } // namespace Lucid::Util
@@ -43,6 +43,7 @@ void ConfigurationView::setRaw(const std::string& key, const std::string& value)
 {
 	std::string translatedKey = translateKey(key);
 	_pConfig->setRaw(translatedKey, value); 
+	_pConfig->updateSnapshot();
 }
 
 
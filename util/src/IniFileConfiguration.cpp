@@ -21,13 +21,16 @@
 #include "lucid/Exception.h"
 #include "lucid/String.h"
 #include "lucid/Path.h"
+#include "lucid/File.h"
 #include "lucid/FileStream.h"
+#include "lucid/SharedMemory.h"
+#include "lucid/StreamCopier.h"
 #include "lucid/Ascii.h"
 #include <set>
 
 
 using Lucid::icompare;
-using Lucid::trim;
+using Lucid::trimInPlace;
 using Lucid::Path;
 
 
@@ -59,22 +62,30 @@ IniFileConfiguration::~IniFileConfiguration()
 
 void IniFileConfiguration::load(std::istream& istr)
 {
-	_map.clear();
-	_sectionKey.clear();
-	while (!istr.eof())
-	{
-		parseLine(istr);
-	}
+	std::string data;
+	Lucid::StreamCopier::copyToString(istr, data);
+	parse(data.data(), data.data() + data.size());
 }
 	
 
 void IniFileConfiguration::load(const std::string& path)
 {
-	Lucid::FileInputStream istr(path);
-	if (istr.good())
-		load(istr);
+	// Only regular files can be mapped; pipes and special files
+	// report a size of zero and are read as a stream instead.
+	Lucid::File file(path);
+	if (file.isFile() && file.getSize() > 0)
+	{
+		Lucid::SharedMemory mem(file, Lucid::SharedMemory::AM_READ);
+		parse(mem.begin(), mem.end());
+	}
 	else
-		throw Lucid::OpenFileException(path);
+	{
+		Lucid::FileInputStream istr(path);
+		if (istr.good())
+			load(istr);
+		else
+			throw Lucid::OpenFileException(path);
+	}
 }
 
 
@@ -102,21 +113,15 @@ void IniFileConfiguration::enumerate(const std::string& key, Keys& range) const
 	std::string prefix = key;
 	if (!prefix.empty()) prefix += '.';
 	std::string::size_type psize = prefix.size();
-	for (const auto& p: _map)
+	IStringMap::const_iterator it = _map.lower_bound(prefix);
+	for (; it != _map.end() && icompare(it->first, psize, prefix) == 0; ++it)
 	{
-		if (icompare(p.first, psize, prefix) == 0)
+		std::string::size_type end = it->first.find('.', psize);
+		std::string subKey(it->first, psize, end == std::string::npos ? std::string::npos : end - psize);
+		if (keys.find(subKey) == keys.end())
 		{
-			std::string subKey;
-			std::string::size_type end = p.first.find('.', psize);
-			if (end == std::string::npos)
-				subKey = p.first.substr(psize);
-			else
-				subKey = p.first.substr(psize, end - psize);
-			if (keys.find(subKey) == keys.end())
-			{
-				range.push_back(subKey);
-				keys.insert(subKey);
-			}
+			range.push_back(subKey);
+			keys.insert(subKey);
 		}
 	}
 }
@@ -127,16 +132,12 @@ void IniFileConfiguration::removeRaw(const std::string& key)
 	std::string prefix = key;
 	if (!prefix.empty()) prefix += '.';
 	std::string::size_type psize = prefix.size();
-	IStringMap::iterator it = _map.begin();
-	IStringMap::iterator itCur;
-	while (it != _map.end())
+	IStringMap::iterator it = _map.lower_bound(prefix);
+	while (it != _map.end() && icompare(it->first, psize, prefix) == 0)
 	{
-		itCur = it++;
-		if ((icompare(itCur->first, key) == 0) || (icompare(itCur->first, psize, prefix) == 0))
-		{
-			_map.erase(itCur);
-		}
+		it = _map.erase(it);
 	}
+	_map.erase(key);
 }
 
 
@@ -146,40 +147,55 @@ bool IniFileConfiguration::ICompare::operator () (const std::string& s1, const s
 }
 
 
-void IniFileConfiguration::parseLine(std::istream& istr)
+void IniFileConfiguration::parse(const char* begin, const char* end)
 {
-	static const int eof = std::char_traits<char>::eof(); 
+	_map.clear();
+	_sectionKey.clear();
+	const char* it = begin;
+	while (it != end)
+	{
+		parseLine(it, end);
+	}
+	updateSnapshot();
+}
 
-	int c = istr.get();
-	while (c != eof && Lucid::Ascii::isSpace(c)) c = istr.get();
-	if (c != eof)
+
+void IniFileConfiguration::parseLine(const char*& it, const char* end)
+{
+	while (it != end && Lucid::Ascii::isSpace(*it)) ++it;
+	if (it == end) return;
+	if (*it == ';')
 	{
-		if (c == ';')
-		{
-			while (c != eof && c != '\n') c = istr.get();
-		}
-		else if (c == '[')
-		{
-			std::string key;
-			c = istr.get();
-			while (c != eof && c != ']' && c != '\n') { key += (char) c; c = istr.get(); }
-			_sectionKey = trim(key);
-		}
-		else
+		while (it != end && *it != '\n') ++it;
+	}
+	else if (*it == '[')
+	{
+		const char* keyBegin = ++it;
+		while (it != end && *it != ']' && *it != '\n') ++it;
+		_sectionKey.assign(keyBegin, it);
+		trimInPlace(_sectionKey);
+		if (it != end) ++it;
+	}
+	else
+	{
+		const char* keyBegin = it;
+		while (it != end && *it != '=' && *it != '\n') ++it;
+		const char* keyEnd = it;
+		while (keyEnd != keyBegin && Lucid::Ascii::isSpace(keyEnd[-1])) --keyEnd;
+		const char* valueBegin = it;
+		const char* valueEnd = it;
+		if (it != end && *it == '=')
 		{
-			std::string key;
-			while (c != eof && c != '=' && c != '\n') { key += (char) c; c = istr.get(); }
-			std::string value;
-			if (c == '=')
-			{
-				c = istr.get();
-				while (c != eof && c != '\n') { value += (char) c; c = istr.get(); }
-			}
-			std::string fullKey = _sectionKey;
-			if (!fullKey.empty()) fullKey += '.';
-			fullKey.append(trim(key));
-			_map[fullKey] = trim(value);
+			valueBegin = ++it;
+			while (it != end && *it != '\n') ++it;
+			valueEnd = it;
+			while (valueBegin != valueEnd && Lucid::Ascii::isSpace(*valueBegin)) ++valueBegin;
+			while (valueEnd != valueBegin && Lucid::Ascii::isSpace(valueEnd[-1])) --valueEnd;
 		}
+		std::string fullKey = _sectionKey;
+		if (!fullKey.empty()) fullKey += '.';
+		fullKey.append(keyBegin, keyEnd);
+		_map[fullKey].assign(valueBegin, valueEnd);
 	}
 }
 
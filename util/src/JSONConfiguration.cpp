@@ -19,7 +19,9 @@
 #ifndef POCO_UTIL_NO_JSONCONFIGURATION
 
 
+#include "lucid/File.h"
 #include "lucid/FileStream.h"
+#include "lucid/SharedMemory.h"
 #include "lucid/StringTokenizer.h"
 #include "lucid/JSON/Parser.h"
 #include "lucid/JSON/Query.h"
@@ -60,8 +62,21 @@ JSONConfiguration::~JSONConfiguration()
 
 void JSONConfiguration::load(const std::string& path)
 {
-	Lucid::FileInputStream fis(path);
-	load(fis);
+	// Only regular files can be mapped; pipes and special files
+	// report a size of zero and are read as a stream instead.
+	Lucid::File file(path);
+	if (file.isFile() && file.getSize() > 0)
+	{
+		JSON::Parser parser;
+		Lucid::SharedMemory mem(file, Lucid::SharedMemory::AM_READ);
+		parser.parse(mem.begin(), mem.end() - mem.begin());
+		loadObject(parser.result());
+	}
+	else
+	{
+		Lucid::FileInputStream fis(path);
+		load(fis);
+	}
 }
 
 
@@ -69,11 +84,17 @@ void JSONConfiguration::load(std::istream& istr)
 {
 	JSON::Parser parser;
 	parser.parse(istr);
-	DynamicAny result = parser.result();
+	loadObject(parser.result());
+}
+
+
+void JSONConfiguration::loadObject(const DynamicAny& result)
+{
 	if ( result.type() == typeid(JSON::Object::Ptr) )
 	{
 		_object = result.extract<JSON::Object::Ptr>();
 	}
+	updateSnapshot();
 }
 
 
@@ -82,6 +82,8 @@ void LayeredConfiguration::add(AbstractConfiguration::Ptr pConfig, const std::st
 	ConfigList::iterator it = _configs.begin();
 	while (it != _configs.end() && it->priority < priority) ++it;
 	_configs.insert(it, item);
+
+	updateSnapshot();
 }
 
 
@@ -92,6 +94,7 @@ void LayeredConfiguration::removeConfiguration(AbstractConfiguration::Ptr pConfi
 		if (it->pConfig == pConfig)
 		{
 			_configs.erase(it);
+			updateSnapshot();
 			break;
 		}
 	}
@@ -125,6 +128,7 @@ void LayeredConfiguration::setRaw(const std::string& key, const std::string& val
 		if (conf.writeable)
 		{
 			conf.pConfig->setRaw(key, value); 
+			conf.pConfig->updateSnapshot();
 			return;
 		}
 	}
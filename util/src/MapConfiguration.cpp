@@ -69,22 +69,25 @@ void MapConfiguration::enumerate(const std::string& key, Keys& range) const
 	std::string prefix = key;
 	if (!prefix.empty()) prefix += '.';
 	std::string::size_type psize = prefix.size();
-	for (const auto& p: _map)
+	StringMap::const_iterator it = _map.lower_bound(prefix);
+	while (it != _map.end() && it->first.compare(0, psize, prefix) == 0)
 	{
-		if (p.first.compare(0, psize, prefix) == 0)
+		std::string::size_type end = it->first.find('.', psize);
+		std::string subKey(it->first, psize, end == std::string::npos ? std::string::npos : end - psize);
+		if (keys.find(subKey) == keys.end())
+		{
+			range.push_back(subKey);
+			keys.insert(subKey);
+		}
+		if (end != std::string::npos)
 		{
-			std::string subKey;
-			std::string::size_type end = p.first.find('.', psize);
-			if (end == std::string::npos)
-				subKey = p.first.substr(psize);
-			else
-				subKey = p.first.substr(psize, end - psize);
-			if (keys.find(subKey) == keys.end())
-			{
-				range.push_back(subKey);
-				keys.insert(subKey);
-			}
+			// skip the remaining properties below subKey; they all
+			// sort before prefix + subKey + '/', as '/' follows '.'
+			std::string next(it->first, 0, end);
+			next += '/';
+			it = _map.lower_bound(next);
 		}
+		else ++it;
 	}
 }
 
@@ -94,16 +97,12 @@ void MapConfiguration::removeRaw(const std::string& key)
 	std::string prefix = key;
 	if (!prefix.empty()) prefix += '.';
 	std::string::size_type psize = prefix.size();
-	StringMap::iterator it = _map.begin();
-	StringMap::iterator itCur;
-	while (it != _map.end())
+	StringMap::iterator it = _map.lower_bound(prefix);
+	while (it != _map.end() && it->first.compare(0, psize, prefix) == 0)
 	{
-		itCur = it++;
-		if ((itCur->first == key) || (itCur->first.compare(0, psize, prefix) == 0))
-		{
-			_map.erase(itCur);
-		}
+		it = _map.erase(it);
 	}
+	_map.erase(key);
 }
 
 
@@ -16,12 +16,15 @@
 #include "lucid/Exception.h"
 #include "lucid/String.h"
 #include "lucid/Path.h"
+#include "lucid/File.h"
 #include "lucid/FileStream.h"
+#include "lucid/SharedMemory.h"
+#include "lucid/StreamCopier.h"
 #include "lucid/LineEndingConverter.h"
 #include "lucid/Ascii.h"
 
 
-using Lucid::trim;
+using Lucid::trimInPlace;
 using Lucid::Path;
 
 
@@ -53,21 +56,30 @@ PropertyFileConfiguration::~PropertyFileConfiguration()
 	
 void PropertyFileConfiguration::load(std::istream& istr)
 {
-	clear();
-	while (!istr.eof())
-	{
-		parseLine(istr);
-	}
+	std::string data;
+	Lucid::StreamCopier::copyToString(istr, data);
+	parse(data.data(), data.data() + data.size());
 }
 
 	
 void PropertyFileConfiguration::load(const std::string& path)
 {
-	Lucid::FileInputStream istr(path);
-	if (istr.good())
-		load(istr);
+	// Only regular files can be mapped; pipes and special files
+	// report a size of zero and are read as a stream instead.
+	Lucid::File file(path);
+	if (file.isFile() && file.getSize() > 0)
+	{
+		Lucid::SharedMemory mem(file, Lucid::SharedMemory::AM_READ);
+		parse(mem.begin(), mem.end());
+	}
 	else
-		throw Lucid::OpenFileException(path);
+	{
+		Lucid::FileInputStream istr(path);
+		if (istr.good())
+			load(istr);
+		else
+			throw Lucid::OpenFileException(path);
+	}
 }
 
 
@@ -123,66 +135,81 @@ void PropertyFileConfiguration::save(const std::string& path) const
 }
 
 
-void PropertyFileConfiguration::parseLine(std::istream& istr)
+void PropertyFileConfiguration::parse(const char* begin, const char* end)
 {
-	static const int eof = std::char_traits<char>::eof(); 
+	clear();
+	const char* it = begin;
+	while (it != end)
+	{
+		parseLine(it, end);
+	}
+	updateSnapshot();
+}
+
 
-	int c = istr.get();
-	while (c != eof && Lucid::Ascii::isSpace(c)) c = istr.get();
-	if (c != eof)
+void PropertyFileConfiguration::parseLine(const char*& it, const char* end)
+{
+	while (it != end && Lucid::Ascii::isSpace(*it)) ++it;
+	if (it == end) return;
+	if (*it == '#' || *it == '!')
 	{
-		if (c == '#' || c == '!')
-		{
-			while (c != eof && c != '\n' && c != '\r') c = istr.get();
-		}
-		else
+		while (it != end && *it != '\n' && *it != '\r') ++it;
+	}
+	else
+	{
+		const char* keyBegin = it;
+		while (it != end && *it != '=' && *it != ':' && *it != '\r' && *it != '\n') ++it;
+		const char* keyEnd = it;
+		while (keyEnd != keyBegin && Lucid::Ascii::isSpace(keyEnd[-1])) --keyEnd;
+		std::string value;
+		if (it != end && (*it == '=' || *it == ':'))
 		{
-			std::string key;
-			while (c != eof && c != '=' && c != ':' && c != '\r' && c != '\n') { key += (char) c; c = istr.get(); }
-			std::string value;
-			if (c == '=' || c == ':')
-			{
-				c = readChar(istr);
-				while (c != eof && c) { value += (char) c; c = readChar(istr); }
-			}
-			setRaw(trim(key), trim(value));
+			++it;
+			readValue(it, end, value);
 		}
+		trimInPlace(value);
+		setRaw(std::string(keyBegin, keyEnd), value);
 	}
 }
 
 
-int PropertyFileConfiguration::readChar(std::istream& istr)
+void PropertyFileConfiguration::readValue(const char*& it, const char* end, std::string& value)
 {
 	for (;;)
 	{
-		int c = istr.get();
-		if (c == '\\')
+		const char* run = it;
+		while (it != end && *it != '\\' && *it != '\n' && *it != '\r' && *it != 0) ++it;
+		value.append(run, it - run);
+		if (it == end) return;
+
+		char c = *it++;
+		if (c != '\\' || it == end) return;
+		c = *it++;
+		switch (c)
 		{
-			c = istr.get();
-			switch (c)
-			{
-			case 't':
-				return '\t';
-			case 'r':
-				return '\r';
-			case 'n':
-				return '\n';
-			case 'f':
-				return '\f';
-			case '\r':
-				if (istr.peek() == '\n')
-					istr.get();
-				continue;
-			case '\n':
-				continue;
-			default:
-				return c;
-			}
+		case 't':
+			value += '\t';
+			break;
+		case 'r':
+			value += '\r';
+			break;
+		case 'n':
+			value += '\n';
+			break;
+		case 'f':
+			value += '\f';
+			break;
+		case '\r':
+			if (it != end && *it == '\n') ++it;
+			break;
+		case '\n':
+			break;
+		case 0:
+			return;
+		default:
+			value += c;
+			break;
 		}
-		else if (c == '\n' || c == '\r')
-			return 0;
-		else
-			return c;
 	}
 }
 
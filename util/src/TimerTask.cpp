@@ -21,7 +21,14 @@ namespace Util {
 
 TimerTask::TimerTask():
 	_lastExecution(0),
-	_isCancelled(false)
+	_isCancelled(false),
+	_pWheel(0),
+	_pPrev(0),
+	_pNext(0),
+	_expiry(0),
+	_interval(0),
+	_slot(-1),
+	_fixedRate(false)
 {
 }
 
@@ -0,0 +1,496 @@
+//
+// TimerWheel.cpp
+//
+// Library: Util
+// Package: Timer
+// Module:  TimerWheel
+//
+// Copyright (c) 2026, Lucid Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "lucid/Util/TimerWheel.h"
+#include "lucid/ErrorHandler.h"
+#include "lucid/Exception.h"
+
+
+using Lucid::ErrorHandler;
+
+
+namespace Lucid {
+namespace Util {
+
+
+namespace
+{
+	const Lucid::UInt64 NO_TICK = ~Lucid::UInt64(0);
+
+	inline int lowestBit(Lucid::UInt64 bits)
+	{
+	#if defined(__GNUC__)
+		return __builtin_ctzll(bits);
+	#else
+		int n = 0;
+		while (!(bits & 1))
+		{
+			bits >>= 1;
+			++n;
+		}
+		return n;
+	#endif
+	}
+}
+
+
+TimerWheel::TimerWheel()
+{
+	init(1);
+	_thread.start(*this);
+}
+
+
+TimerWheel::TimerWheel(long resolution)
+{
+	init(resolution);
+	_thread.start(*this);
+}
+
+
+TimerWheel::TimerWheel(long resolution, Lucid::Thread::Priority priority)
+{
+	init(resolution);
+	_thread.setPriority(priority);
+	_thread.start(*this);
+}
+
+
+TimerWheel::~TimerWheel()
+{
+	try
+	{
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			_stopped = true;
+			_wakeUp.set();
+		}
+		_thread.join();
+		clear();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void TimerWheel::init(long resolution)
+{
+	poco_assert (resolution > 0);
+
+	_tickLength = static_cast<Lucid::Clock::ClockDiff>(resolution)*1000;
+	_base = 0;
+	_wakeUpTick = NO_TICK;
+	for (int i = 0; i < LEVELS; i++) _occupied[i] = 0;
+	for (int i = 0; i < LEVELS*SLOTS; i++) _slots[i] = 0;
+	_count = 0;
+	_stopped = false;
+}
+
+
+void TimerWheel::schedule(TimerTask::Ptr pTask, long delay)
+{
+	Lucid::Clock clock;
+	clock += static_cast<Lucid::Clock::ClockDiff>(delay)*1000;
+	schedule(pTask, clock, 0, false);
+}
+
+
+void TimerWheel::schedule(TimerTask::Ptr pTask, Lucid::Clock clock)
+{
+	schedule(pTask, clock, 0, false);
+}
+
+
+void TimerWheel::schedule(TimerTask::Ptr pTask, long delay, long interval)
+{
+	poco_assert (interval > 0);
+
+	Lucid::Clock clock;
+	clock += static_cast<Lucid::Clock::ClockDiff>(delay)*1000;
+	schedule(pTask, clock, interval, false);
+}
+
+
+void TimerWheel::scheduleAtFixedRate(TimerTask::Ptr pTask, long delay, long interval)
+{
+	poco_assert (interval > 0);
+
+	Lucid::Clock clock;
+	clock += static_cast<Lucid::Clock::ClockDiff>(delay)*1000;
+	schedule(pTask, clock, interval, true);
+}
+
+
+void TimerWheel::schedule(TimerTask::Ptr pTask, Lucid::Clock clock, long interval, bool fixedRate)
+{
+	poco_check_ptr (pTask.get());
+
+	if (pTask->isCancelled())
+	{
+		throw Lucid::IllegalStateException("A cancelled task must not be rescheduled");
+	}
+
+	Lucid::UInt64 expiry = toTick(clock);
+
+	FastMutex::ScopedLock lock(_mutex);
+	TimerTask* pRaw = pTask.get();
+	if (pRaw->_pWheel == this)
+	{
+		if (pRaw->_slot < 0)
+			throw Lucid::IllegalStateException("A running periodic task must not be rescheduled");
+		unlink(pRaw);
+	}
+	else if (pRaw->_pWheel)
+	{
+		throw Lucid::IllegalStateException("Task is already scheduled by another TimerWheel");
+	}
+	else pRaw->duplicate();
+
+	pRaw->_pWheel    = this;
+	pRaw->_expiry    = expiry;
+	pRaw->_interval  = interval;
+	pRaw->_fixedRate = fixedRate;
+	insert(pRaw);
+
+	if (expiry < _wakeUpTick) _wakeUp.set();
+}
+
+
+bool TimerWheel::cancel(TimerTask::Ptr pTask)
+{
+	poco_check_ptr (pTask.get());
+
+	pTask->cancel();
+
+	FastMutex::ScopedLock lock(_mutex);
+	TimerTask* pRaw = pTask.get();
+	if (pRaw->_pWheel != this) return false;
+	if (pRaw->_slot >= 0)
+	{
+		unlink(pRaw);
+		pRaw->_pWheel = 0;
+		// the caller still holds a reference
+		pRaw->release();
+	}
+	return true;
+}
+
+
+void TimerWheel::clear()
+{
+	TaskVec tasks;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		tasks.reserve(_count);
+		for (int i = 0; i < LEVELS*SLOTS; i++)
+		{
+			TimerTask* pTask = _slots[i];
+			while (pTask)
+			{
+				TimerTask* pNext = pTask->_pNext;
+				pTask->_pWheel = 0;
+				pTask->_pPrev  = 0;
+				pTask->_pNext  = 0;
+				pTask->_slot   = -1;
+				tasks.push_back(pTask);
+				pTask = pNext;
+			}
+			_slots[i] = 0;
+		}
+		for (int i = 0; i < LEVELS; i++) _occupied[i] = 0;
+		_count = 0;
+
+		// Periodic tasks currently being executed must not be
+		// put back into the wheel.
+		for (TaskVec::iterator it = _expired.begin(); it != _expired.end(); ++it)
+		{
+			if ((*it)->_pWheel == this) (*it)->_pWheel = 0;
+		}
+	}
+	release(tasks);
+}
+
+
+std::size_t TimerWheel::size() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+	return _count;
+}
+
+
+void TimerWheel::run()
+{
+	TaskVec released;
+	for (;;)
+	{
+		long timeout = -1;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			if (_stopped) break;
+
+			advance(currentTick());
+			if (!_expired.empty())
+			{
+				_wakeUpTick = 0;
+			}
+			else if (_count == 0)
+			{
+				_wakeUpTick = NO_TICK;
+			}
+			else
+			{
+				_wakeUpTick = nextTick();
+				Lucid::Clock::ClockDiff sleep = static_cast<Lucid::Clock::ClockDiff>(_wakeUpTick)*_tickLength - _start.elapsed();
+				timeout = sleep > 0 ? static_cast<long>((sleep + 999)/1000) : 0;
+			}
+		}
+
+		if (!_expired.empty())
+		{
+			for (TaskVec::iterator it = _expired.begin(); it != _expired.end(); ++it)
+			{
+				execute(*it);
+			}
+
+			FastMutex::ScopedLock lock(_mutex);
+			for (TaskVec::iterator it = _expired.begin(); it != _expired.end(); ++it)
+			{
+				if (!reschedule(*it)) released.push_back(*it);
+			}
+			_expired.clear();
+		}
+		else if (timeout < 0)
+		{
+			_wakeUp.wait();
+		}
+		else if (timeout > 0)
+		{
+			_wakeUp.tryWait(timeout);
+		}
+		release(released);
+	}
+}
+
+
+Lucid::UInt64 TimerWheel::currentTick() const
+{
+	return static_cast<Lucid::UInt64>(_start.elapsed()/_tickLength);
+}
+
+
+Lucid::UInt64 TimerWheel::toTick(const Lucid::Clock& clock) const
+{
+	Lucid::Clock::ClockDiff diff = clock - _start;
+	if (diff <= 0) return 0;
+	return static_cast<Lucid::UInt64>((diff + _tickLength - 1)/_tickLength);
+}
+
+
+void TimerWheel::insert(TimerTask* pTask)
+{
+	const Lucid::UInt64 MAX_DELTA = (Lucid::UInt64(1) << (LEVELS*SLOT_BITS)) - 1;
+
+	Lucid::UInt64 expiry = pTask->_expiry < _base ? _base : pTask->_expiry;
+	Lucid::UInt64 delta = expiry - _base;
+	if (delta > MAX_DELTA)
+	{
+		// Too far in the future; the task is put back into
+		// the wheel when the last slot is processed.
+		delta  = MAX_DELTA;
+		expiry = _base + delta;
+	}
+
+	int level = 0;
+	while (delta >> ((level + 1)*SLOT_BITS)) ++level;
+	int index = static_cast<int>((expiry >> (level*SLOT_BITS)) & SLOT_MASK);
+	int slot = level*SLOTS + index;
+
+	pTask->_slot  = slot;
+	pTask->_pPrev = 0;
+	pTask->_pNext = _slots[slot];
+	if (pTask->_pNext) pTask->_pNext->_pPrev = pTask;
+	_slots[slot] = pTask;
+	_occupied[level] |= Lucid::UInt64(1) << index;
+	++_count;
+}
+
+
+void TimerWheel::unlink(TimerTask* pTask)
+{
+	poco_assert_dbg (pTask->_slot >= 0);
+
+	int slot = pTask->_slot;
+	if (pTask->_pPrev)
+		pTask->_pPrev->_pNext = pTask->_pNext;
+	else
+		_slots[slot] = pTask->_pNext;
+	if (pTask->_pNext) pTask->_pNext->_pPrev = pTask->_pPrev;
+	if (!_slots[slot]) _occupied[slot/SLOTS] &= ~(Lucid::UInt64(1) << (slot & SLOT_MASK));
+
+	pTask->_pPrev = 0;
+	pTask->_pNext = 0;
+	pTask->_slot  = -1;
+	--_count;
+}
+
+
+void TimerWheel::cascade(int level)
+{
+	if (level >= LEVELS) return;
+
+	int index = static_cast<int>((_base >> (level*SLOT_BITS)) & SLOT_MASK);
+	int slot = level*SLOTS + index;
+	TimerTask* pTask = _slots[slot];
+	_slots[slot] = 0;
+	_occupied[level] &= ~(Lucid::UInt64(1) << index);
+	while (pTask)
+	{
+		TimerTask* pNext = pTask->_pNext;
+		pTask->_slot = -1;
+		--_count;
+		if (pTask->isCancelled())
+		{
+			pTask->_pWheel = 0;
+			_expired.push_back(pTask);
+		}
+		else insert(pTask);
+		pTask = pNext;
+	}
+
+	if (index == 0) cascade(level + 1);
+}
+
+
+void TimerWheel::expire(int index)
+{
+	TimerTask* pTask = _slots[index];
+	_slots[index] = 0;
+	_occupied[0] &= ~(Lucid::UInt64(1) << index);
+	while (pTask)
+	{
+		TimerTask* pNext = pTask->_pNext;
+		pTask->_slot = -1;
+		--_count;
+		if (pTask->_expiry > _base && !pTask->isCancelled())
+		{
+			insert(pTask);
+		}
+		else
+		{
+			if (pTask->_interval == 0 || pTask->isCancelled()) pTask->_pWheel = 0;
+			_expired.push_back(pTask);
+		}
+		pTask = pNext;
+	}
+}
+
+
+void TimerWheel::advance(Lucid::UInt64 tick)
+{
+	if (_count == 0)
+	{
+		if (_base <= tick) _base = tick + 1;
+		return;
+	}
+
+	while (_base <= tick)
+	{
+		int index = static_cast<int>(_base & SLOT_MASK);
+		if (index == 0) cascade(1);
+		if (_occupied[0] & (Lucid::UInt64(1) << index)) expire(index);
+
+		// Skip empty slots, but stop at the next cascade.
+		Lucid::UInt64 bits = index < SLOT_MASK ? _occupied[0] >> (index + 1) : 0;
+		_base += bits ? lowestBit(bits) + 1 : SLOTS - index;
+		if (_base > tick + 1) _base = tick + 1;
+	}
+}
+
+
+Lucid::UInt64 TimerWheel::nextTick() const
+{
+	int index = static_cast<int>(_base & SLOT_MASK);
+	if (index == 0) return _base;
+
+	Lucid::UInt64 bits = _occupied[0] >> index;
+	return _base + (bits ? lowestBit(bits) : SLOTS - index);
+}
+
+
+void TimerWheel::execute(TimerTask* pTask)
+{
+	if (!pTask->isCancelled())
+	{
+		try
+		{
+			pTask->_lastExecution.update();
+			pTask->run();
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+	}
+}
+
+
+bool TimerWheel::reschedule(TimerTask* pTask)
+{
+	if (pTask->_pWheel != this || pTask->_slot >= 0) return false;
+
+	if (pTask->isCancelled())
+	{
+		pTask->_pWheel = 0;
+		return false;
+	}
+
+	if (pTask->_fixedRate)
+	{
+		Lucid::Clock::ClockDiff interval = static_cast<Lucid::Clock::ClockDiff>(pTask->_interval)*1000;
+		Lucid::UInt64 ticks = static_cast<Lucid::UInt64>((interval + _tickLength - 1)/_tickLength);
+		Lucid::UInt64 now = currentTick();
+		pTask->_expiry += ticks > 0 ? ticks : 1;
+		if (pTask->_expiry < now) pTask->_expiry = now;
+	}
+	else
+	{
+		Lucid::Clock nextExecution;
+		nextExecution += static_cast<Lucid::Clock::ClockDiff>(pTask->_interval)*1000;
+		pTask->_expiry = toTick(nextExecution);
+	}
+	insert(pTask);
+	return true;
+}
+
+
+void TimerWheel::release(TaskVec& tasks)
+{
+	for (TaskVec::iterator it = tasks.begin(); it != tasks.end(); ++it)
+	{
+		(*it)->release();
+	}
+	tasks.clear();
+}
+
+
+} } // namespace Lucid::Util
@@ -27,6 +27,9 @@
 #include "lucid/Exception.h"
 #include "lucid/NumberParser.h"
 #include "lucid/NumberFormatter.h"
+#include "lucid/File.h"
+#include "lucid/SharedMemory.h"
+#include "lucid/MemoryStream.h"
 #include <set>
 
 
@@ -150,8 +153,22 @@ void XMLConfiguration::load(std::istream& istr)
 
 void XMLConfiguration::load(const std::string& path)
 {
-	Lucid::XML::InputSource src(path);
-	load(&src);	
+	// Only regular files can be mapped; pipes and special files
+	// report a size of zero and are read by the parser instead.
+	Lucid::File file(path);
+	if (file.isFile() && file.getSize() > 0)
+	{
+		Lucid::SharedMemory mem(file, Lucid::SharedMemory::AM_READ);
+		Lucid::MemoryInputStream istr(mem.begin(), mem.end() - mem.begin());
+		Lucid::XML::InputSource src(istr);
+		src.setSystemId(path);
+		load(&src);
+	}
+	else
+	{
+		Lucid::XML::InputSource src(path);
+		load(&src);
+	}
 }
 
 	
@@ -161,6 +178,7 @@ void XMLConfiguration::load(const Lucid::XML::Document* pDocument)
 	
 	_pDocument = Lucid::XML::AutoPtr<Lucid::XML::Document>(const_cast<Lucid::XML::Document*>(pDocument), true);
 	_pRoot     = Lucid::XML::AutoPtr<Lucid::XML::Node>(pDocument->documentElement(), true);
+	updateSnapshot();
 }
 
 
@@ -176,6 +194,7 @@ void XMLConfiguration::load(const Lucid::XML::Node* pNode)
 	{
 		_pDocument = Lucid::XML::AutoPtr<Lucid::XML::Document>(pNode->ownerDocument(), true);
 		_pRoot     = Lucid::XML::AutoPtr<Lucid::XML::Node>(const_cast<Lucid::XML::Node*>(pNode), true);
+		updateSnapshot();
 	}
 }
 
@@ -30,6 +30,7 @@
 #include "lucid/XML/QName.h"
 #include "lucid/XML/ValueTraits.h"
 #include "lucid/XML/Content.h"
+#include "lucid/StringView.h"
 #if defined(POCO_UNBUNDLED)
 #include <expat.h>
 #else
@@ -90,6 +91,37 @@ class XML_API XMLStreamParser
 	///             ...
 	///         }
 	///     }
+	///
+	/// View mode:
+	///
+	/// If the parser is created with the RECEIVE_VIEWS feature, element
+	/// names and attributes are not copied into QName objects and attribute
+	/// maps. Instead, they are kept in a buffer owned by the parser and can
+	/// be accessed through the *View() accessors and the attributeCount(),
+	/// attributeLocalNameView(), attributeValueView(), etc. functions, which
+	/// return StringView objects referring into that buffer. Since the buffer
+	/// is reused, no memory is allocated per event once it has grown to the
+	/// size of the largest start tag in the document.
+	///
+	/// The views are only valid until the next call to next() or peek().
+	/// getQName(), localName(), etc. are still available in view mode,
+	/// but materialize the name on first use. Attribute maps and attribute
+	/// events are not available in view mode.
+	///
+	/// Skipping elements:
+	///
+	/// skipElement() skips the remaining content of the current element,
+	/// including all nested elements, without reporting it. This is
+	/// considerably faster than calling next() for every event, as the
+	/// parser does not need to suspend and resume for every event in the
+	/// skipped subtree.
+	///
+	///     for (XMLStreamParser::EventType e: p)
+	///     {
+	///         if (e == XMLStreamParser::EV_START_ELEMENT && p.localNameView() != "item")
+	///             p.skipElement();
+	///         ...
+	///     }
 {
 public:
 	enum EventType
@@ -114,6 +146,11 @@ public:
 	static const FeatureType RECEIVE_ATTRIBUTE_MAP = 0x0004;
 	static const FeatureType RECEIVE_ATTRIBUTES_EVENT = 0x0008;
 	static const FeatureType RECEIVE_NAMESPACE_DECLS = 0x0010;
+	static const FeatureType RECEIVE_VIEWS = 0x0020;
+		/// Keep element names and attributes in a parser-owned buffer
+		/// accessible through StringView accessors instead of
+		/// materializing QName objects and attribute maps.
+		/// Overrides RECEIVE_ATTRIBUTE_MAP and RECEIVE_ATTRIBUTES_EVENT.
 	static const FeatureType RECEIVE_DEFAULT = RECEIVE_ELEMENTS | RECEIVE_CHARACTERS | RECEIVE_ATTRIBUTE_MAP;
 
 	struct AttributeValueType
@@ -235,6 +272,51 @@ public:
 	bool attributePresent(const QName& qname) const;
 	const AttributeMapType& attributeMap() const;
 
+	StringView namespaceURIView() const;
+		/// Returns the namespace URI of the current name.
+		/// The view is valid until the next event.
+
+	StringView localNameView() const;
+		/// Returns the local part of the current name.
+		/// The view is valid until the next event.
+
+	StringView prefixView() const;
+		/// Returns the namespace prefix of the current name.
+		/// The view is valid until the next event.
+
+	StringView valueView() const;
+		/// Returns the current character data or attribute value.
+		/// The view is valid until the next event.
+
+	std::size_t attributeCount() const;
+		/// Returns the number of attributes of the current start element
+		/// if the parser is in view mode (RECEIVE_VIEWS), or 0 otherwise.
+
+	StringView attributeNamespaceURIView(std::size_t index) const;
+		/// Returns the namespace URI of the attribute with the given index.
+		/// The view is valid until the next event.
+
+	StringView attributeLocalNameView(std::size_t index) const;
+		/// Returns the local name of the attribute with the given index.
+		/// The view is valid until the next event.
+
+	StringView attributeValueView(std::size_t index) const;
+		/// Returns the value of the attribute with the given index.
+		/// The view is valid until the next event.
+
+	bool findAttribute(const StringView& name, StringView& value) const;
+		/// Looks up the unqualified attribute with the given local name
+		/// of the current start element in view mode. If found, stores
+		/// a view of its value in value and returns true. Otherwise
+		/// returns false.
+
+	void skipElement();
+		/// Skips the content of the current element, which must have just
+		/// been returned as EV_START_ELEMENT by next(). Nested elements,
+		/// character data, attributes and namespace declarations of the
+		/// element are discarded without being reported. After the call,
+		/// the current event is the EV_END_ELEMENT of the skipped element.
+
 	void content(Content);
 	Content content() const;
 
@@ -276,6 +358,10 @@ private:
 	static void XMLCALL handleEndNamespaceDecl(void*, const XML_Char*);
 
 	void init();
+	bool hasViewName() const;
+	void materializeName() const;
+	void captureStartElement(const XML_Char* name, const XML_Char** atts);
+	void captureName(const XML_Char* name);
 	EventType nextImpl(bool peek);
 	EventType nextBody();
 	void handleError();
@@ -297,7 +383,7 @@ private:
 	enum { state_next, state_peek } _parserState;
 	EventType _currentEvent;
 	EventType _queue;
-	QName _qname;
+	mutable QName _qname;
 	std::string _value;
 	const QName* _qualifiedName;
 	std::string* _pvalue;
@@ -314,6 +400,32 @@ private:
 	attributes _attributes;
 	attributes::size_type _currentAttributeIndex; // Index of the current attribute.
 
+	struct NameOffsets
+		// Location of the name parts in _viewBuffer.
+	{
+		std::size_t ns;
+		std::size_t nsLength;
+		std::size_t name;
+		std::size_t nameLength;
+		std::size_t prefix;
+		std::size_t prefixLength;
+	};
+
+	struct AttributeOffsets
+	{
+		NameOffsets name;
+		std::size_t value;
+		std::size_t valueLength;
+	};
+
+	static void splitViewName(const XML_Char* s, std::string& buf, NameOffsets& offsets);
+
+	std::string _viewBuffer;
+	NameOffsets _viewName;
+	std::vector<AttributeOffsets> _viewAttributes;
+	mutable bool _qnameValid; // Whether _qname reflects _viewName.
+	std::size_t _skipDepth; // Nesting level inside the element being skipped.
+
 	typedef std::vector<QName> NamespaceDecls;
 	NamespaceDecls _startNamespace;
 	NamespaceDecls::size_type _startNamespaceIndex;// Index of the current decl.
@@ -365,27 +477,101 @@ inline const std::string& XMLStreamParser::inputName() const
 }
 
 
+inline bool XMLStreamParser::hasViewName() const
+{
+	return (_feature & RECEIVE_VIEWS) != 0 && _qualifiedName == &_qname;
+}
+
+
 inline const QName& XMLStreamParser::getQName() const
 {
+	if (!_qnameValid && hasViewName()) materializeName();
+
 	return *_qualifiedName;
 }
 
 
 inline const std::string& XMLStreamParser::namespaceURI() const
 {
-	return _qualifiedName->namespaceURI();
+	return getQName().namespaceURI();
 }
 
 
 inline const std::string& XMLStreamParser::localName() const
 {
-	return _qualifiedName->localName();
+	return getQName().localName();
 }
 
 
 inline const std::string& XMLStreamParser::prefix() const
 {
-	return _qualifiedName->prefix();
+	return getQName().prefix();
+}
+
+
+inline StringView XMLStreamParser::namespaceURIView() const
+{
+	if (hasViewName())
+		return StringView(_viewBuffer.data() + _viewName.ns, _viewName.nsLength);
+	else
+		return StringView(_qualifiedName->namespaceURI());
+}
+
+
+inline StringView XMLStreamParser::localNameView() const
+{
+	if (hasViewName())
+		return StringView(_viewBuffer.data() + _viewName.name, _viewName.nameLength);
+	else
+		return StringView(_qualifiedName->localName());
+}
+
+
+inline StringView XMLStreamParser::prefixView() const
+{
+	if (hasViewName())
+		return StringView(_viewBuffer.data() + _viewName.prefix, _viewName.prefixLength);
+	else
+		return StringView(_qualifiedName->prefix());
+}
+
+
+inline StringView XMLStreamParser::valueView() const
+{
+	return StringView(*_pvalue);
+}
+
+
+inline std::size_t XMLStreamParser::attributeCount() const
+{
+	return _viewAttributes.size();
+}
+
+
+inline StringView XMLStreamParser::attributeNamespaceURIView(std::size_t index) const
+{
+	poco_assert_dbg (index < _viewAttributes.size());
+
+	const NameOffsets& n = _viewAttributes[index].name;
+	return StringView(_viewBuffer.data() + n.ns, n.nsLength);
+}
+
+
+inline StringView XMLStreamParser::attributeLocalNameView(std::size_t index) const
+{
+	poco_assert_dbg (index < _viewAttributes.size());
+
+	const NameOffsets& n = _viewAttributes[index].name;
+	return StringView(_viewBuffer.data() + n.name, n.nameLength);
+}
+
+
+inline StringView XMLStreamParser::attributeValueView(std::size_t index) const
+{
+	poco_assert_dbg (index < _viewAttributes.size());
+
+	const AttributeOffsets& a = _viewAttributes[index];
+	return StringView(_viewBuffer.data() + a.value, a.valueLength);
 }
 
 
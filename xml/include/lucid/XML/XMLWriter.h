@@ -59,6 +59,13 @@ class XML_API XMLWriter: public ContentHandler, public LexicalHandler, public DT
 	/// as part of the qualified name given to startElement(), or by calling
 	/// startPrefixMapping()), the XMLWriter automatically generates namespace
 	/// prefixes in the form ns1, ns2, etc.
+	///
+	/// If the output encoding is UTF-8, the XMLWriter collects its output
+	/// in an internal buffer and writes it to the underlying stream in
+	/// blocks of BUFFER_SIZE bytes. The buffer is flushed by endDocument(),
+	/// endFragment(), flush() and when the XMLWriter is destroyed.
+	/// Applications writing directly to the underlying stream while
+	/// the XMLWriter is in use must call flush() first.
 {
 public:
 	enum Options
@@ -86,6 +93,12 @@ public:
 			/// PRETTY_PRINT must be specified as well.
 	};
 
+	enum
+	{
+		BUFFER_SIZE = 65536
+			/// Size of the blocks written to the underlying stream.
+	};
+
 	XMLWriter(XMLByteOutputStream& str, int options);
 		/// Creates the XMLWriter and sets the specified options.
 		///
@@ -270,6 +283,9 @@ public:
 		/// to a prefix in the current element or its ancestors.
 		
 	// Misc.
+	void flush();
+		/// Writes any buffered output to the underlying stream.
+
 	int depth() const;
 		/// Return the number of nested XML elements.
 		///
@@ -303,6 +319,10 @@ protected:
 	void writeAttributes(const AttributeMap& attributeMap);
 	void writeAttributes(const CanonicalAttributeMap& attributeMap);
 	void prettyPrint() const;
+	void writeAttributeValue(const XMLString& value) const;
+	void writeEscaped(const XMLChar* ch, std::size_t length, bool attribute) const;
+	void writeBuffered(const char* data, std::size_t length) const;
+	void flushBuffer(bool all) const;
 	static std::string nameToString(const XMLString& localName, const XMLString& qname);
 
 private:
@@ -319,6 +339,7 @@ private:
 	};
 	typedef std::vector<Name> ElementStack;
 	
+	XMLByteOutputStream*          _pStream;
 	Lucid::OutputStreamConverter* _pTextConverter;
 	Lucid::TextEncoding*          _pInEncoding;
 	Lucid::TextEncoding*          _pOutEncoding;
@@ -338,6 +359,8 @@ private:
 	int              _prefix;
 	bool             _nsContextPushed;
 	std::string      _indent;
+	bool             _buffered;
+	mutable std::string _buffer;
 
 	static const std::string MARKUP_QUOTENC;
 	static const std::string MARKUP_AMPENC;
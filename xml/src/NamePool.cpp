@@ -15,6 +15,7 @@
 #include "lucid/XML/NamePool.h"
 #include "lucid/Exception.h"
 #include "lucid/Random.h"
+#include "lucid/Hash.h"
 
 
 namespace Lucid {
@@ -96,7 +97,7 @@ void NamePool::release()
 const Name& NamePool::insert(const XMLString& qname, const XMLString& namespaceURI, const XMLString& localName)
 {
 	unsigned long i = 0;
-	unsigned long n = (hash(qname, namespaceURI, localName) ^ _salt) % _size;
+	unsigned long n = hash(qname, namespaceURI, localName) % _size;
 
 	while (!_pItems[n].set(qname, namespaceURI, localName) && i++ < _size) 
 		n = (n + 1) % _size;
@@ -115,17 +116,10 @@ const Name& NamePool::insert(const Name& name)
 
 unsigned long NamePool::hash(const XMLString& qname, const XMLString& namespaceURI, const XMLString& localName)
 {
-	unsigned long h = 0;
-	XMLString::const_iterator it  = qname.begin();
-	XMLString::const_iterator end = qname.end();
-	while (it != end) h = (h << 5) + h + (unsigned long) *it++;
-	it =  namespaceURI.begin();
-	end = namespaceURI.end();
-	while (it != end) h = (h << 5) + h + (unsigned long) *it++;
-	it  = localName.begin();
-	end = localName.end();
-	while (it != end) h = (h << 5) + h + (unsigned long) *it++;
-	return h;
+	Lucid::UInt64 h = Lucid::hash64(qname.data(), qname.size()*sizeof(XMLChar), _salt);
+	h = Lucid::hash64(namespaceURI.data(), namespaceURI.size()*sizeof(XMLChar), h);
+	h = Lucid::hash64(localName.data(), localName.size()*sizeof(XMLChar), h);
+	return static_cast<unsigned long>(h);
 }
 
 
@@ -126,6 +126,9 @@ void XMLStreamParser::init()
 	_line = 0;
 	_column = 0;
 
+	_qnameValid = true;
+	_skipDepth = 0;
+
 	_currentAttributeIndex = 0;
 	_startNamespaceIndex = 0;
 	_endNamespaceIndex = 0;
@@ -133,6 +136,9 @@ void XMLStreamParser::init()
 	if ((_feature & RECEIVE_ATTRIBUTE_MAP) != 0 && (_feature & RECEIVE_ATTRIBUTES_EVENT) != 0)
 		_feature &= ~RECEIVE_ATTRIBUTE_MAP;
 
+	if ((_feature & RECEIVE_VIEWS) != 0)
+		_feature &= ~(RECEIVE_ATTRIBUTE_MAP | RECEIVE_ATTRIBUTES_EVENT);
+
 	// Allocate the XMLStreamParser. Make sure nothing else can throw after
 	// this call since otherwise we will leak it.
 	//
@@ -295,7 +301,7 @@ void XMLStreamParser::nextExpect(EventType e)
 
 void XMLStreamParser::nextExpect(EventType e, const std::string& ns, const std::string& n)
 {
-	if (next() != e || namespaceURI() != ns || localName() != n)
+	if (next() != e || namespaceURIView() != ns || localNameView() != n)
 		throw XMLStreamParserException(*this, std::string(parserEventStrings[e]) + " '" + QName(ns, n).toString() + "' expected");
 }
 
@@ -336,6 +342,53 @@ std::string XMLStreamParser::element(const QName& qn, const std::string& dv)
 }
 
 
+bool XMLStreamParser::findAttribute(const StringView& name, StringView& value) const
+{
+	for (std::size_t i = 0; i < _viewAttributes.size(); ++i)
+	{
+		const AttributeOffsets& a = _viewAttributes[i];
+		if (a.name.nsLength == 0 && StringView(_viewBuffer.data() + a.name.name, a.name.nameLength) == name)
+		{
+			value = StringView(_viewBuffer.data() + a.value, a.valueLength);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void XMLStreamParser::skipElement()
+{
+	poco_assert(_parserState == state_next && _currentEvent == EV_START_ELEMENT);
+
+	// Attributes and namespace declarations of the skipped element
+	// are discarded along with its content.
+	//
+	if (const ElementEntry* e = getElement())
+		e->attributesUnhandled = 0;
+
+	_attributes.clear();
+	_currentAttributeIndex = 0;
+	_startNamespace.clear();
+	_startNamespaceIndex = 0;
+	_qualifiedName = &_qname;
+	_pvalue = &_value;
+
+	// For an empty element (<foo/>) the end element is already queued.
+	// Otherwise let Expat run through the content without stopping
+	// until we see the matching end element.
+	//
+	if (_queue != EV_END_ELEMENT)
+		_skipDepth = 1;
+
+	EventType e(next());
+	poco_assert(e == EV_END_ELEMENT);
+
+	_endNamespace.clear();
+	_endNamespaceIndex = 0;
+}
+
+
 const XMLStreamParser::ElementEntry* XMLStreamParser::getElementImpl() const
 {
 	// The handleStartElement() Expat handler may have already provisioned
@@ -394,6 +447,11 @@ XMLStreamParser::EventType XMLStreamParser::nextImpl(bool peek)
 	{
 	case EV_END_ELEMENT:
 	{
+		// The end of an empty element (<foo/>) is queued without capturing
+		// the name again, so drop the attributes of its start tag here.
+		//
+		_viewAttributes.clear();
+
 		// If this is a peek, then avoid popping the stack just yet.
 		// This way, the attribute map will still be valid until we
 		// call next().
@@ -705,6 +763,82 @@ static void splitName(const XML_Char* s, QName& qn)
 }
 
 
+void XMLStreamParser::splitViewName(const XML_Char* s, std::string& buf, NameOffsets& offsets)
+{
+	// Append the "ns name prefix" triplet as is and record the
+	// locations of its parts.
+	//
+	std::size_t start(buf.size());
+	std::size_t len(strlen(s));
+	buf.append(s, len);
+
+	const char* p(static_cast<const char*>(memchr(s, ' ', len)));
+	if (p == 0)
+	{
+		offsets.ns = offsets.prefix = start;
+		offsets.nsLength = offsets.prefixLength = 0;
+		offsets.name = start;
+		offsets.nameLength = len;
+	}
+	else
+	{
+		offsets.ns = start;
+		offsets.nsLength = p - s;
+		offsets.name = start + offsets.nsLength + 1;
+
+		const char* q(static_cast<const char*>(memchr(p + 1, ' ', len - offsets.nsLength - 1)));
+		if (q == 0)
+		{
+			offsets.nameLength = len - offsets.nsLength - 1;
+			offsets.prefix = start + len;
+			offsets.prefixLength = 0;
+		}
+		else
+		{
+			offsets.nameLength = q - p - 1;
+			offsets.prefix = start + (q - s) + 1;
+			offsets.prefixLength = len - (q - s) - 1;
+		}
+	}
+}
+
+
+void XMLStreamParser::materializeName() const
+{
+	_qname.namespaceURI().assign(_viewBuffer, _viewName.ns, _viewName.nsLength);
+	_qname.localName().assign(_viewBuffer, _viewName.name, _viewName.nameLength);
+	_qname.prefix().assign(_viewBuffer, _viewName.prefix, _viewName.prefixLength);
+	_qnameValid = true;
+}
+
+
+void XMLStreamParser::captureStartElement(const XML_Char* name, const XML_Char** atts)
+{
+	_viewBuffer.clear();
+	_viewAttributes.clear();
+	splitViewName(name, _viewBuffer, _viewName);
+	for (; *atts != 0; atts += 2)
+	{
+		_viewAttributes.emplace_back();
+		AttributeOffsets& a(_viewAttributes.back());
+		splitViewName(*atts, _viewBuffer, a.name);
+		a.value = _viewBuffer.size();
+		a.valueLength = strlen(*(atts + 1));
+		_viewBuffer.append(*(atts + 1), a.valueLength);
+	}
+	_qnameValid = false;
+}
+
+
+void XMLStreamParser::captureName(const XML_Char* name)
+{
+	_viewBuffer.clear();
+	_viewAttributes.clear();
+	splitViewName(name, _viewBuffer, _viewName);
+	_qnameValid = false;
+}
+
+
 void XMLCALL XMLStreamParser::handleStartElement(void* v, const XML_Char* name, const XML_Char** atts)
 {
 	XMLStreamParser& p(*static_cast<XMLStreamParser*>(v));
@@ -722,6 +856,14 @@ void XMLCALL XMLStreamParser::handleStartElement(void* v, const XML_Char* name,
 	//
 	poco_assert(ps.parsing == XML_PARSING);
 
+	// Nested elements of a skipped element are only counted.
+	//
+	if (p._skipDepth != 0)
+	{
+		++p._skipDepth;
+		return;
+	}
+
 	// When accumulating characters in simple content, we expect to
 	// see more characters or end element. Seeing start element is
 	// possible but means violation of the content model.
@@ -738,7 +880,10 @@ void XMLCALL XMLStreamParser::handleStartElement(void* v, const XML_Char* name,
 	}
 
 	p._currentEvent = EV_START_ELEMENT;
-	splitName(name, p._qname);
+	if ((p._feature & RECEIVE_VIEWS) != 0)
+		p.captureStartElement(name, atts);
+	else
+		splitName(name, p._qname);
 
 	p._line = XML_GetCurrentLineNumber(p._parser);
 	p._column = XML_GetCurrentColumnNumber(p._parser);
@@ -809,7 +954,15 @@ void XMLCALL XMLStreamParser::handleEndElement(void* v, const XML_Char* name)
 		p._queue = EV_END_ELEMENT;
 	else
 	{
-		splitName(name, p._qname);
+		// Wait for the end of the element being skipped.
+		//
+		if (p._skipDepth != 0 && --p._skipDepth != 0)
+			return;
+
+		if ((p._feature & RECEIVE_VIEWS) != 0)
+			p.captureName(name);
+		else
+			splitName(name, p._qname);
 
 		// If we are accumulating characters, then queue this event.
 		//
@@ -838,7 +991,7 @@ void XMLCALL XMLStreamParser::handleCharacters(void* v, const XML_Char* s, int n
 	// Expat has a (mis)-feature of a possibily calling handlers even
 	// after the non-resumable XML_StopParser call.
 	//
-	if (ps.parsing == XML_FINISHED)
+	if (ps.parsing == XML_FINISHED || p._skipDepth != 0)
 		return;
 
 	Content cont(p.content());
@@ -909,7 +1062,7 @@ void XMLCALL XMLStreamParser::handleStartNamespaceDecl(void* v, const XML_Char*
 	// Expat has a (mis)-feature of a possibily calling handlers even
 	// after the non-resumable XML_StopParser call.
 	//
-	if (ps.parsing == XML_FINISHED)
+	if (ps.parsing == XML_FINISHED || p._skipDepth != 0)
 		return;
 
 	p._startNamespace.emplace_back();
@@ -928,7 +1081,7 @@ void XMLCALL XMLStreamParser::handleEndNamespaceDecl(void* v, const XML_Char* pr
 	// Expat has a (mis)-feature of a possibily calling handlers even
 	// after the non-resumable XML_StopParser call.
 	//
-	if (ps.parsing == XML_FINISHED)
+	if (ps.parsing == XML_FINISHED || p._skipDepth != 0)
 		return;
 
 	p._endNamespace.emplace_back();
@@ -18,7 +18,20 @@
 #include "lucid/SAX/AttributesImpl.h"
 #include "lucid/UTF8Encoding.h"
 #include "lucid/UTF16Encoding.h"
+#include "lucid/UTF8String.h"
+#include "lucid/String.h"
 #include <sstream>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define XML_WRITER_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define XML_WRITER_NEON
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 
 namespace Lucid {
@@ -56,7 +69,98 @@ const std::string XMLWriter::MARKUP_END_CDATA   = "]]>";
 #endif
 
 
+namespace
+{
+	inline bool isSpecial(unsigned char c)
+		// Characters that may need escaping in character data and
+		// attribute values: quotes, ampersand, angle brackets and
+		// control characters.
+	{
+		return c < 32 || c == '"' || c == '&' || c == '<' || c == '>';
+	}
+
+
+	const char* findSpecial(const char* it, const char* end)
+		// Returns a pointer to the first special character in [it, end),
+		// or end if there is none.
+	{
+#if defined(XML_WRITER_SSE2)
+		const __m128i quot = _mm_set1_epi8('"');
+		const __m128i amp  = _mm_set1_epi8('&');
+		const __m128i lt   = _mm_set1_epi8('<');
+		const __m128i gt   = _mm_set1_epi8('>');
+		const __m128i ctl  = _mm_set1_epi8(31);
+		while (end - it >= 16)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+			__m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quot), _mm_cmpeq_epi8(v, amp)), _mm_or_si128(_mm_cmpeq_epi8(v, lt), _mm_cmpeq_epi8(v, gt)));
+			m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_min_epu8(v, ctl), v));
+			int mask = _mm_movemask_epi8(m);
+			if (mask)
+			{
+#if defined(_MSC_VER)
+				unsigned long index;
+				_BitScanForward(&index, mask);
+				return it + index;
+#else
+				return it + __builtin_ctz(mask);
+#endif
+			}
+			it += 16;
+		}
+#elif defined(XML_WRITER_NEON)
+		const uint8x16_t quot = vdupq_n_u8('"');
+		const uint8x16_t amp  = vdupq_n_u8('&');
+		const uint8x16_t lt   = vdupq_n_u8('<');
+		const uint8x16_t gt   = vdupq_n_u8('>');
+		const uint8x16_t ctl  = vdupq_n_u8(31);
+		while (end - it >= 16)
+		{
+			uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(it));
+			uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, quot), vceqq_u8(v, amp)), vorrq_u8(vceqq_u8(v, lt), vceqq_u8(v, gt)));
+			m = vorrq_u8(m, vcleq_u8(v, ctl));
+			if (vmaxvq_u8(m)) break;
+			it += 16;
+		}
+#endif
+		while (it != end && !isSpecial(static_cast<unsigned char>(*it))) ++it;
+		return it;
+	}
+
+
+	std::size_t completeLength(const char* data, std::size_t length)
+		// Returns the length of the longest prefix of data
+		// that does not end with an incomplete UTF-8 sequence.
+	{
+		std::size_t n = length < 3 ? length : 3;
+		for (std::size_t i = 1; i <= n; ++i)
+		{
+			unsigned char c = static_cast<unsigned char>(data[length - i]);
+			if (c < 0x80) break;
+			if (c >= 0xC0)
+			{
+				std::size_t seqLength = c >= 0xF0 ? 4 : (c >= 0xE0 ? 3 : 2);
+				if (seqLength > i) return length - i;
+				break;
+			}
+		}
+		return length;
+	}
+
+
+	bool isUTF8(const Lucid::TextEncoding& encoding)
+	{
+#if defined(XML_UNICODE_WCHAR_T)
+		return false;
+#else
+		return Lucid::icompare(std::string(encoding.canonicalName()), "UTF-8") == 0;
+#endif
+	}
+}
+
+
 XMLWriter::XMLWriter(XMLByteOutputStream& str, int options):
+	_pStream(&str),
 	_pTextConverter(0),
 	_pInEncoding(new NATIVE_ENCODING),
 	_pOutEncoding(new Lucid::UTF8Encoding),
@@ -72,14 +176,17 @@ XMLWriter::XMLWriter(XMLByteOutputStream& str, int options):
 	_unclosedStartTag(false),
 	_prefix(0),
 	_nsContextPushed(false),
-	_indent(MARKUP_TAB)
+	_indent(MARKUP_TAB),
+	_buffered(false)
 {
 	_pTextConverter = new Lucid::OutputStreamConverter(str, *_pInEncoding, *_pOutEncoding);
+	_buffered = isUTF8(*_pOutEncoding);
 	setNewLine((_options & CANONICAL_XML) ? NEWLINE_LF : NEWLINE_DEFAULT);
 }
 
 
 XMLWriter::XMLWriter(XMLByteOutputStream& str, int options, const std::string& encodingName, Lucid::TextEncoding& textEncoding):
+	_pStream(&str),
 	_pTextConverter(0),
 	_pInEncoding(new NATIVE_ENCODING),
 	_pOutEncoding(0),
@@ -95,14 +202,17 @@ XMLWriter::XMLWriter(XMLByteOutputStream& str, int options, const std::string& e
 	_unclosedStartTag(false),
 	_prefix(0),
 	_nsContextPushed(false),
-	_indent(MARKUP_TAB)
+	_indent(MARKUP_TAB),
+	_buffered(false)
 {
 	_pTextConverter = new Lucid::OutputStreamConverter(str, *_pInEncoding, textEncoding);
+	_buffered = isUTF8(textEncoding);
 	setNewLine((_options & CANONICAL_XML) ? NEWLINE_LF : NEWLINE_DEFAULT);
 }
 
 
 XMLWriter::XMLWriter(XMLByteOutputStream& str, int options, const std::string& encodingName, Lucid::TextEncoding* pTextEncoding):
+	_pStream(&str),
 	_pTextConverter(0),
 	_pInEncoding(new NATIVE_ENCODING),
 	_pOutEncoding(0),
@@ -118,17 +228,20 @@ XMLWriter::XMLWriter(XMLByteOutputStream& str, int options, const std::string& e
 	_unclosedStartTag(false),
 	_prefix(0),
 	_nsContextPushed(false),
-	_indent(MARKUP_TAB)
+	_indent(MARKUP_TAB),
+	_buffered(false)
 {
 	if (pTextEncoding)
 	{
 		_pTextConverter = new Lucid::OutputStreamConverter(str, *_pInEncoding, *pTextEncoding);
+		_buffered = isUTF8(*pTextEncoding);
 	}
 	else
 	{
 		_encoding = "UTF-8";
 		_pOutEncoding = new Lucid::UTF8Encoding;
 		_pTextConverter = new Lucid::OutputStreamConverter(str, *_pInEncoding, *_pOutEncoding);
+		_buffered = isUTF8(*_pOutEncoding);
 	}
 	setNewLine((_options & CANONICAL_XML) ? NEWLINE_LF : NEWLINE_DEFAULT);
 }
@@ -136,6 +249,14 @@ XMLWriter::XMLWriter(XMLByteOutputStream& str, int options, const std::string& e
 
 XMLWriter::~XMLWriter()
 {
+	try
+	{
+		flush();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
 	delete _pTextConverter;
 	delete _pInEncoding;
 	delete _pOutEncoding;
@@ -211,6 +332,7 @@ void XMLWriter::endDocument()
 
 	_elementCount = 0;
 	_depth        = -1;
+	flush();
 }
 
 
@@ -238,6 +360,7 @@ void XMLWriter::endFragment()
 	_inFragment   = false;
 	_elementCount = 0;
 	_depth        = -1;
+	flush();
 }
 
 
@@ -316,7 +439,14 @@ void XMLWriter::characters(const XMLChar ch[], int start, int length)
 	_contentWritten = _contentWritten || length > 0;
 	if (_inCDATA)
 	{
-		while (length-- > 0) writeXML(ch[start++]);
+		if (_buffered)
+			writeBuffered((const char*) (ch + start), length);
+		else
+			while (length-- > 0) writeXML(ch[start++]);
+	}
+	else if (_buffered)
+	{
+		writeEscaped(ch + start, length, false);
 	}
 	else
 	{
@@ -909,24 +1039,7 @@ void XMLWriter::writeAttributes(const AttributeMap& attributeMap)
 		}
 		writeXML(ap.first);
 		writeMarkup(MARKUP_EQQUOT);
-		for (auto c: ap.second)
-		{
-			switch (c)
-			{
-			case '"':  writeMarkup(MARKUP_QUOTENC); break;
-			case '&':  writeMarkup(MARKUP_AMPENC); break;
-			case '<':  writeMarkup(MARKUP_LTENC); break;
-			case '>':  writeMarkup(MARKUP_GTENC); break;
-			case '\t': writeMarkup(MARKUP_TABENC); break;
-			case '\r': writeMarkup(MARKUP_CRENC); break;
-			case '\n': writeMarkup(MARKUP_LFENC); break;
-			default:
-				if (c >= 0 && c < 32)
-					throw XMLException("Invalid character token.");
-				else 
-					writeXML(c);
-			}
-		}
+		writeAttributeValue(ap.second);
 		writeMarkup(MARKUP_QUOT);
 	}
 }
@@ -947,49 +1060,133 @@ void XMLWriter::writeAttributes(const CanonicalAttributeMap& attributeMap)
 		}
 		writeXML(ap.second.first);
 		writeMarkup(MARKUP_EQQUOT);
-		for (auto c: ap.second.second)
+		writeAttributeValue(ap.second.second);
+		writeMarkup(MARKUP_QUOT);
+	}
+}
+
+
+void XMLWriter::writeAttributeValue(const XMLString& value) const
+{
+	if (_buffered)
+	{
+		writeEscaped(value.data(), value.size(), true);
+		return;
+	}
+
+	for (auto c: value)
+	{
+		switch (c)
 		{
-			switch (c)
-			{
-			case '"':  writeMarkup(MARKUP_QUOTENC); break;
-			case '&':  writeMarkup(MARKUP_AMPENC); break;
-			case '<':  writeMarkup(MARKUP_LTENC); break;
-			case '>':  writeMarkup(MARKUP_GTENC); break;
-			case '\t': writeMarkup(MARKUP_TABENC); break;
-			case '\r': writeMarkup(MARKUP_CRENC); break;
-			case '\n': writeMarkup(MARKUP_LFENC); break;
-			default:
-				if (c >= 0 && c < 32)
-					throw XMLException("Invalid character token.");
-				else 
-					writeXML(c);
-			}
+		case '"':  writeMarkup(MARKUP_QUOTENC); break;
+		case '&':  writeMarkup(MARKUP_AMPENC); break;
+		case '<':  writeMarkup(MARKUP_LTENC); break;
+		case '>':  writeMarkup(MARKUP_GTENC); break;
+		case '\t': writeMarkup(MARKUP_TABENC); break;
+		case '\r': writeMarkup(MARKUP_CRENC); break;
+		case '\n': writeMarkup(MARKUP_LFENC); break;
+		default:
+			if (c >= 0 && c < 32)
+				throw XMLException("Invalid character token.");
+			else 
+				writeXML(c);
 		}
-		writeMarkup(MARKUP_QUOT);
 	}
 }
 
 
+void XMLWriter::writeEscaped(const XMLChar* ch, std::size_t length, bool attribute) const
+{
+	// Only used in buffered mode, where XMLChar is char.
+	// Runs of characters not needing escaping are copied as a whole.
+	const char* it  = reinterpret_cast<const char*>(ch);
+	const char* end = it + length;
+	while (it != end)
+	{
+		const char* special = findSpecial(it, end);
+		_buffer.append(it, special - it);
+		if (special == end) break;
+		switch (*special)
+		{
+		case '"':  _buffer.append(MARKUP_QUOTENC); break;
+		case '&':  _buffer.append(MARKUP_AMPENC); break;
+		case '<':  _buffer.append(MARKUP_LTENC); break;
+		case '>':  _buffer.append(MARKUP_GTENC); break;
+		case '\t': 
+			if (attribute) _buffer.append(MARKUP_TABENC); else _buffer += '\t';
+			break;
+		case '\r': 
+			if (attribute) _buffer.append(MARKUP_CRENC); else _buffer += '\r';
+			break;
+		case '\n': 
+			if (attribute) _buffer.append(MARKUP_LFENC); else _buffer += '\n';
+			break;
+		default:
+			throw XMLException("Invalid character token.");
+		}
+		it = special + 1;
+	}
+	if (_buffer.size() >= BUFFER_SIZE) flushBuffer(false);
+}
+
+
 void XMLWriter::writeMarkup(const std::string& str) const
 {
 #if defined(XML_UNICODE_WCHAR_T)
 	const XMLString xmlString = toXMLString(str);
 	writeXML(xmlString);
 #else
-	_pTextConverter->write(str.data(), (int) str.size());
+	if (_buffered)
+		writeBuffered(str.data(), str.size());
+	else
+		_pTextConverter->write(str.data(), (int) str.size());
 #endif
 }
 
 
 void XMLWriter::writeXML(const XMLString& str) const
 {
-	_pTextConverter->write((const char*) str.data(), (int) str.size()*sizeof(XMLChar));
+	if (_buffered)
+		writeBuffered((const char*) str.data(), str.size()*sizeof(XMLChar));
+	else
+		_pTextConverter->write((const char*) str.data(), (int) str.size()*sizeof(XMLChar));
 }
 
 
 void XMLWriter::writeXML(XMLChar ch) const
 {
-	_pTextConverter->write((const char*) &ch, sizeof(ch));
+	if (_buffered)
+		writeBuffered((const char*) &ch, sizeof(ch));
+	else
+		_pTextConverter->write((const char*) &ch, sizeof(ch));
+}
+
+
+void XMLWriter::writeBuffered(const char* data, std::size_t length) const
+{
+	_buffer.append(data, length);
+	if (_buffer.size() >= BUFFER_SIZE) flushBuffer(false);
+}
+
+
+void XMLWriter::flushBuffer(bool all) const
+{
+	// Valid UTF-8 passes the converter unchanged, so it can be written
+	// directly. Anything else still goes through the converter to get
+	// the exact same error handling as in unbuffered mode.
+	std::size_t n = all ? _buffer.size() : completeLength(_buffer.data(), _buffer.size());
+	if (n == 0) return;
+	if (_pTextConverter->good() && Lucid::UTF8::isValid(_buffer.data(), n))
+		_pStream->write(_buffer.data(), n);
+	else
+		_pTextConverter->write(_buffer.data(), (int) n);
+	_buffer.erase(0, n);
+}
+
+
+void XMLWriter::flush()
+{
+	if (_buffered) flushBuffer(true);
 }
 
 